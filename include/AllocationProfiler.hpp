@@ -0,0 +1,91 @@
+#ifndef ALLOCATION_PROFILER_HPP
+#define ALLOCATION_PROFILER_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * AllocationProfiler - counts heap allocations per tagged scope
+ *
+ * The program's global operator new/delete (src/AllocationProfiler.cpp)
+ * report every allocation and free here. While profiling is on, each one is
+ * charged to the scope the calling thread is in, as set by the innermost
+ * AllocationScope; code outside any scope (including the log writer's and
+ * follower's threads) counts as "other". While it is off the hooks cost one
+ * relaxed load per call.
+ *
+ * Profiling is on from startup when built with -DVOLUNTEER_ALLOC_PROFILE,
+ * and can be switched on at run time with --profile-allocations (console)
+ * or VOLUNTEER_ALLOC_PROFILE=1 in the environment (every mode). The
+ * breakdown is printed when the program exits.
+ */
+class AllocationProfiler {
+public:
+    enum Scope {
+        OTHER,
+        LOAD,      // Startup: saved state, registration history, sites, index, stats
+        REGISTER,
+        DEPLOY,
+        RELEASE,
+        REPORT,    // Queue views, reports, roster planning, lookups
+        SAVE,      // Queue state and site files on exit
+        SCOPE_COUNT
+    };
+
+    /**
+     * Starts counting (from zero) and prints the breakdown at exit
+     */
+    static void enable();
+
+    /**
+     * Enables profiling if the build or the environment asks for it
+     */
+    static void enableIfRequested();
+
+    static bool isEnabled();
+
+    /**
+     * Scope the calling thread's allocations are charged to
+     */
+    static Scope currentScope();
+
+    /**
+     * Prints allocations, bytes and frees per scope (counting is paused
+     * meanwhile so the report does not count itself)
+     */
+    static void printReport();
+
+    static const char* scopeName(Scope scope);
+
+    // Called by the global operator new/delete only
+    static void noteAllocation(std::size_t bytes);
+    static void noteFree();
+
+private:
+    friend class AllocationScope;
+    static void setCurrentScope(Scope scope);
+};
+
+/**
+ * Charges the calling thread's allocations to a scope until destroyed,
+ * then restores the enclosing one
+ */
+class AllocationScope {
+private:
+    AllocationProfiler::Scope previous;
+
+    // Disable copying
+    AllocationScope(const AllocationScope&);
+    AllocationScope& operator=(const AllocationScope&);
+
+public:
+    explicit AllocationScope(AllocationProfiler::Scope scope) : previous(AllocationProfiler::currentScope()) {
+        AllocationProfiler::setCurrentScope(scope);
+    }
+
+    ~AllocationScope() {
+        AllocationProfiler::setCurrentScope(previous);
+    }
+};
+
+#endif // ALLOCATION_PROFILER_HPP
@@ -0,0 +1,81 @@
+#ifndef ASYNC_LOG_WRITER_HPP
+#define ASYNC_LOG_WRITER_HPP
+
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * AsyncLogWriter - appends log records (one line each) on a background thread
+ *
+ * Producers push records into a bounded lock-free ring buffer and return
+ * immediately. The writer thread drains whatever is queued as one batch and
+ * issues a single append + fsync per file per batch. Records for the same file
+ * are written in the order they were appended.
+ */
+class AsyncLogWriter {
+public:
+    static const unsigned CAPACITY = 1024;  // Ring slots, must be a power of two
+
+    /**
+     * Constructor - starts the writer thread
+     */
+    AsyncLogWriter();
+
+    /**
+     * Destructor - writes every queued record to disk, then stops the thread
+     */
+    ~AsyncLogWriter();
+
+    /**
+     * Queues one record for appending to a file. A newline is added after the
+     * record, and before it if the file does not already end with one.
+     * Blocks only while the ring buffer is full.
+     * @param filename File to append to
+     * @param line Record text without trailing newline
+     */
+    void append(const std::string& filename, const std::string& line);
+
+    /**
+     * Waits until every record appended before this call is on disk
+     * @return false if any write failed since the previous flush
+     */
+    bool flush();
+
+private:
+    struct Slot {
+        std::atomic<unsigned long long> sequence;
+        std::string filename;
+        std::string line;
+    };
+
+    Slot ring[CAPACITY];
+    std::atomic<unsigned long long> enqueuePos;  // Next slot claimed by a producer
+    unsigned long long dequeuePos;               // Next slot read by the writer thread (writer-owned)
+
+    std::atomic<unsigned long long> persisted;   // Records written and synced so far
+    std::atomic<bool> writeFailed;
+    std::atomic<bool> stopping;
+
+    std::mutex waitMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable batchDone;
+    std::thread worker;
+
+    // Disable copying
+    AsyncLogWriter(const AsyncLogWriter&);
+    AsyncLogWriter& operator=(const AsyncLogWriter&);
+
+    void run();
+    unsigned drainBatch(Slot** batch);
+    bool writeFile(const std::string& filename, const std::string& data);
+};
+
+/**
+ * Returns the process-wide log writer, flushed automatically at exit
+ */
+AsyncLogWriter& logWriter();
+
+#endif // ASYNC_LOG_WRITER_HPP
@@ -0,0 +1,107 @@
+#ifndef BATCH_PLANNER_HPP
+#define BATCH_PLANNER_HPP
+
+#include "VolunteerQueue.hpp"
+#include "SpatialIndex.hpp"
+#include "CustomLists.hpp"
+#include <atomic>
+
+/**
+ * BatchPlanner - assigns a batch of queued volunteers to sites in parallel
+ *
+ * The batch (volunteers in dispatch order) is cut into contiguous slices, one
+ * per worker thread. Every site has an atomic count seeded with its current
+ * count; a worker takes a place with a single compare-and-swap that only
+ * succeeds while the count is below maxCapacity, so no interleaving of the
+ * workers can oversubscribe a site. Each volunteer gets the site a single
+ * deployment would pick: the nearest open site within the travel radius for
+ * volunteers with a location (when sites have coordinates), otherwise the
+ * lowest fill ratio. A lost compare-and-swap means the site just changed, so
+ * the worker re-ranks and falls back to the next-best site.
+ *
+ * For the lowest-ratio rule each worker keeps its own min-heap of sites keyed
+ * by the counts it last saw. Counts only grow while planning, so a stale key
+ * is never too high: when the top site's count still matches its key it is
+ * the least filled site; otherwise it is pushed back with the fresh count.
+ *
+ * The batch is trimmed to the number of free places first. Since any
+ * volunteer can fall back to any open site, every volunteer left in the batch
+ * gets a place, and a shortage always leaves the rear of the queue waiting,
+ * never someone ahead of them. The plan is returned in batch order; the
+ * caller commits it in that order (see commitBatchDeployment in main.cpp), so
+ * the deployment log reads as if the volunteers had been deployed one by one.
+ */
+class BatchPlanner {
+private:
+    // Counters padded to a cache line apart, so workers taking places at
+    // neighbouring sites do not keep invalidating each other's lines (padding
+    // rather than alignas, which plain new[] does not honour before C++17)
+    struct SiteCounter {
+        std::atomic<int> count;
+        char padding[64 - sizeof(std::atomic<int>)];
+    };
+
+    CustomArray<ReliefSite> sites;
+    SiteCounter* counters;
+    SiteSpatialIndex spatial;  // Sites with coordinates; location.index is the site's position
+
+    // Disable copying
+    BatchPlanner(const BatchPlanner&);
+    BatchPlanner& operator=(const BatchPlanner&);
+
+    bool tryReserve(int site, int seen);
+    int reserveNearest(const Volunteer& volunteer, double radiusKm);
+    void planSlice(const CustomArray<Volunteer>& volunteers, int first, int last, bool useLocations,
+                   double radiusKm, CustomArray<int>& plan);
+
+public:
+    static const int MIN_SLICE = 1024;  // Smaller batches are planned on fewer threads
+
+    /**
+     * Constructor - takes the site table (counts, capacities, coordinates)
+     * the plan starts from
+     */
+    explicit BatchPlanner(const CustomArray<ReliefSite>& siteTable);
+
+    /**
+     * Destructor - frees the counters
+     */
+    ~BatchPlanner();
+
+    /**
+     * Reserves a place for each volunteer, front of the batch first
+     * @param volunteers Batch in dispatch order
+     * @param useLocations Whether located volunteers go to their nearest site
+     * @param workers Threads to plan on (0 for one per hardware thread)
+     * @param plan Receives, per planned volunteer, the index of its site
+     * @return Number of volunteers planned: the batch, trimmed to the free places
+     */
+    int plan(const CustomArray<Volunteer>& volunteers, bool useLocations, double radiusKm, int workers,
+             CustomArray<int>& plan);
+
+    /**
+     * Count of a site including this planner's reservations
+     */
+    int reservedCount(int site) const {
+        return counters[site].count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Places still free across all sites
+     */
+    int freePlaces() const;
+
+    /**
+     * Distance in km from a point to a site, as the nearest-site search
+     * measures it (site must have coordinates)
+     */
+    double distanceKm(double latitude, double longitude, int site) const {
+        return spatial.distanceKm(latitude, longitude, sites[site].latitude, sites[site].longitude);
+    }
+
+    int siteCount() const {
+        return sites.size();
+    }
+};
+
+#endif // BATCH_PLANNER_HPP
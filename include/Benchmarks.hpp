@@ -0,0 +1,38 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+/**
+ * Benchmark modes: each times one component on synthetic data and prints a
+ * table; none of them reads or writes the data directory
+ */
+
+/**
+ * Entry point for "--bench-policies" mode; times every site-selection policy,
+ * called directly and through the run-time dispatch table, on a synthetic
+ * site table and prints how evenly each one fills the sites
+ * @return Process exit code
+ */
+int runPolicyBenchmarkMode(int argc, char* argv[]);
+
+/**
+ * Entry point for "--bench-queues" mode; times the linked and ring queue
+ * backends on the same enqueue/dequeue, walk, bulk and lane-count workloads
+ * @return Process exit code
+ */
+int runQueueBenchmarkMode(int argc, char* argv[]);
+
+/**
+ * Entry point for "--bench-search" mode; times exact, prefix and misspelled
+ * name lookups against a synthetic roster
+ * @return Process exit code
+ */
+int runSearchBenchmarkMode(int argc, char* argv[]);
+
+/**
+ * Entry point for "--bench-planner" mode; plans one batch of deployments on
+ * 1, 2, 4 ... worker threads and checks that no plan oversubscribes a site
+ * @return Process exit code
+ */
+int runPlannerBenchmarkMode(int argc, char* argv[]);
+
+#endif // BENCHMARKS_HPP
@@ -3,6 +3,10 @@
 
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <functional>
+#include <new>
 
 // Forward declarations
 struct Volunteer;
@@ -25,6 +29,20 @@ private:
     ListNode<T>* head;
     ListNode<T>* tail;
     int count;
+    
+    // Unlinks and frees node, whose predecessor is before (nullptr for the head)
+    void unlinkAfter(ListNode<T>* before, ListNode<T>* node) {
+        if (before == nullptr) {
+            head = node->next;
+        } else {
+            before->next = node->next;
+        }
+        if (node == tail) {
+            tail = before;
+        }
+        delete node;
+        count--;
+    }
 
 public:
     CustomLinkedList() : head(nullptr), tail(nullptr), count(0) {}
@@ -97,14 +115,35 @@ public:
         count = 0;
     }
     
+    // Moves every node of other to the end of this list in O(1); other is left empty
+    void appendAll(CustomLinkedList& other) {
+        if (this == &other || other.head == nullptr) return;
+        
+        if (head == nullptr) {
+            head = other.head;
+        } else {
+            tail->next = other.head;
+        }
+        tail = other.tail;
+        count += other.count;
+        
+        other.head = other.tail = nullptr;
+        other.count = 0;
+    }
+    
     // Iterator-like access
     class Iterator {
     private:
         ListNode<T>* current;
+        ListNode<T>* previous;  // Node before current when reached by advancing from begin()
         
-    public:
-        Iterator(ListNode<T>* node) : current(node) {}
+        friend class CustomLinkedList;
+        
+        // Only the list creates iterators, so previous is always the real
+        // predecessor (erase relies on it)
+        Iterator(ListNode<T>* node, ListNode<T>* before = nullptr) : current(node), previous(before) {}
         
+    public:
         T& operator*() {
             return current->data;
         }
@@ -122,13 +161,16 @@ public:
         }
         
         Iterator& operator++() {
-            if (current) current = current->next;
+            if (current) {
+                previous = current;
+                current = current->next;
+            }
             return *this;
         }
         
         Iterator operator++(int) {
             Iterator temp = *this;
-            if (current) current = current->next;
+            ++(*this);
             return temp;
         }
         
@@ -157,6 +199,66 @@ public:
         return Iterator(nullptr);
     }
     
+    // Moves every node of other in after position (end() inserts at the front) in O(1); other is left empty
+    void splice_after(const Iterator& position, CustomLinkedList& other) {
+        if (this == &other || other.head == nullptr) return;
+        
+        ListNode<T>* before = position.current;
+        if (before == nullptr) {
+            other.tail->next = head;
+            head = other.head;
+            if (tail == nullptr) tail = other.tail;
+        } else {
+            other.tail->next = before->next;
+            before->next = other.head;
+            if (before == tail) tail = other.tail;
+        }
+        count += other.count;
+        
+        other.head = other.tail = nullptr;
+        other.count = 0;
+    }
+    
+    // Removes the item after position (end() removes the front) in O(1)
+    // Returns an iterator to the item that followed the removed one
+    Iterator erase_after(const Iterator& position) {
+        ListNode<T>* before = position.current;
+        ListNode<T>* node = before == nullptr ? head : before->next;
+        if (node == nullptr) return end();
+        
+        unlinkAfter(before, node);
+        return Iterator(before == nullptr ? head : before->next, before);
+    }
+    
+    // Removes the item at position in O(1), using the predecessor the iterator
+    // recorded while advancing; position must have been reached from begin()
+    // without its predecessor being erased since
+    // Returns an iterator to the item that followed the removed one
+    Iterator erase(const Iterator& position) {
+        if (position.current == nullptr) return end();
+        return erase_after(Iterator(position.previous));
+    }
+    
+    // Removes every item matching shouldRemove(const T&) in one pass, keeping
+    // the order of the rest; returns the number removed
+    template<typename Predicate>
+    int remove_if(Predicate shouldRemove) {
+        int removed = 0;
+        ListNode<T>* before = nullptr;
+        ListNode<T>* current = head;
+        while (current != nullptr) {
+            ListNode<T>* next = current->next;
+            if (shouldRemove(static_cast<const T&>(current->data))) {
+                unlinkAfter(before, current);
+                removed++;
+            } else {
+                before = current;
+            }
+            current = next;
+        }
+        return removed;
+    }
+    
     // Array-like access by index
     T& operator[](int index) {
         if (index < 0 || index >= count) {
@@ -208,6 +310,470 @@ public:
     }
 };
 
+/**
+ * Custom growable array with contiguous storage (amortized O(1) push_back)
+ * Used where positional access must be O(1), e.g. heaps and simulation tables.
+ */
+template<typename T>
+class CustomArray {
+private:
+    T* items;
+    int count;
+    int capacity;
+    
+public:
+    CustomArray() : items(nullptr), count(0), capacity(0) {}
+    
+    ~CustomArray() {
+        delete[] items;
+    }
+    
+    // Copy constructor
+    CustomArray(const CustomArray& other) : items(nullptr), count(0), capacity(0) {
+        reserve(other.count);
+        for (int i = 0; i < other.count; i++) {
+            items[i] = other.items[i];
+        }
+        count = other.count;
+    }
+    
+    // Assignment operator
+    CustomArray& operator=(const CustomArray& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.count);
+            for (int i = 0; i < other.count; i++) {
+                items[i] = other.items[i];
+            }
+            count = other.count;
+        }
+        return *this;
+    }
+    
+    // Move constructor and assignment take over the storage, so arrays of
+    // arrays grow without copying their elements
+    CustomArray(CustomArray&& other) : items(other.items), count(other.count), capacity(other.capacity) {
+        other.items = nullptr;
+        other.count = other.capacity = 0;
+    }
+    
+    CustomArray& operator=(CustomArray&& other) {
+        if (this != &other) {
+            delete[] items;
+            items = other.items;
+            count = other.count;
+            capacity = other.capacity;
+            other.items = nullptr;
+            other.count = other.capacity = 0;
+        }
+        return *this;
+    }
+    
+    void reserve(int newCapacity) {
+        if (newCapacity <= capacity || newCapacity <= 0) return;
+        
+        T* newItems = new T[newCapacity];
+        for (int i = 0; i < count; i++) {
+            newItems[i] = std::move(items[i]);
+        }
+        delete[] items;
+        items = newItems;
+        capacity = newCapacity;
+    }
+    
+    void push_back(const T& value) {
+        if (count == capacity) {
+            reserve(capacity == 0 ? 8 : capacity * 2);
+        }
+        items[count++] = value;
+    }
+    
+    void push_back(T&& value) {
+        if (count == capacity) {
+            reserve(capacity == 0 ? 8 : capacity * 2);
+        }
+        items[count++] = std::move(value);
+    }
+    
+    void pop_back() {
+        if (count > 0) {
+            items[--count] = T();
+        }
+    }
+    
+    // Replaces the contents with newCount copies of value
+    void assign(int newCount, const T& value) {
+        reserve(newCount);
+        for (int i = 0; i < newCount; i++) {
+            items[i] = value;
+        }
+        for (int i = newCount; i < count; i++) {
+            items[i] = T();
+        }
+        count = newCount > 0 ? newCount : 0;
+    }
+    
+    bool empty() const {
+        return count == 0;
+    }
+    
+    int size() const {
+        return count;
+    }
+    
+    // Keeps the allocated storage for reuse
+    void clear() {
+        for (int i = 0; i < count; i++) {
+            items[i] = T();
+        }
+        count = 0;
+    }
+    
+    // Exchanges contents and storage in O(1)
+    void swap(CustomArray& other) {
+        T* otherItems = other.items;
+        int otherCount = other.count;
+        int otherCapacity = other.capacity;
+        other.items = items;
+        other.count = count;
+        other.capacity = capacity;
+        items = otherItems;
+        count = otherCount;
+        capacity = otherCapacity;
+    }
+    
+    T& back() {
+        return items[count - 1];
+    }
+    
+    const T& back() const {
+        return items[count - 1];
+    }
+    
+    T& operator[](int index) {
+        return items[index];
+    }
+    
+    const T& operator[](int index) const {
+        return items[index];
+    }
+    
+    // Pointer iteration (same begin/end style as CustomLinkedList)
+    T* begin() {
+        return items;
+    }
+    
+    T* end() {
+        return items + count;
+    }
+    
+    const T* begin() const {
+        return items;
+    }
+    
+    const T* end() const {
+        return items + count;
+    }
+};
+
+/**
+ * Custom growable ring buffer (amortized O(1) push_back and pop_front)
+ * Capacity stays a power of two so positions wrap with a mask; growing moves
+ * the items into a twice larger array in queue order. Slots are raw storage:
+ * an item is constructed when pushed and destroyed when popped, so neither
+ * costs a default-constructed T. Used where a FIFO should be walked front to
+ * back without chasing pointers.
+ */
+template<typename T>
+class CustomRing {
+private:
+    T* items;      // Raw storage; only the count slots from head hold items
+    int head;      // Slot of the front item
+    int count;
+    int capacity;  // 0 or a power of two
+    
+    T* slot(int index) const {
+        return items + ((head + index) & (capacity - 1));
+    }
+    
+    void grow() {
+        int newCapacity = capacity == 0 ? 8 : capacity * 2;
+        T* newItems = static_cast<T*>(::operator new(sizeof(T) * (size_t)newCapacity));
+        for (int i = 0; i < count; i++) {
+            T* item = slot(i);
+            new (newItems + i) T(std::move(*item));
+            item->~T();
+        }
+        ::operator delete(items);
+        items = newItems;
+        head = 0;
+        capacity = newCapacity;
+    }
+    
+public:
+    CustomRing() : items(nullptr), head(0), count(0), capacity(0) {}
+    
+    ~CustomRing() {
+        clear();
+        ::operator delete(items);
+    }
+    
+    // Copy constructor
+    CustomRing(const CustomRing& other) : items(nullptr), head(0), count(0), capacity(0) {
+        *this = other;
+    }
+    
+    // Assignment operator
+    CustomRing& operator=(const CustomRing& other) {
+        if (this != &other) {
+            clear();
+            while (capacity < other.count) {
+                grow();
+            }
+            for (int i = 0; i < other.count; i++) {
+                push_back(other[i]);
+            }
+        }
+        return *this;
+    }
+    
+    void push_back(const T& value) {
+        if (count == capacity) {
+            grow();
+        }
+        new (slot(count)) T(value);
+        count++;
+    }
+    
+    void push_back(T&& value) {
+        if (count == capacity) {
+            grow();
+        }
+        new (slot(count)) T(std::move(value));
+        count++;
+    }
+    
+    void pop_front() {
+        if (count > 0) {
+            items[head].~T();
+            head = (head + 1) & (capacity - 1);
+            count--;
+        }
+    }
+    
+    T& front() {
+        return items[head];
+    }
+    
+    const T& front() const {
+        return items[head];
+    }
+    
+    bool empty() const {
+        return count == 0;
+    }
+    
+    int size() const {
+        return count;
+    }
+    
+    // Keeps the allocated storage for reuse
+    void clear() {
+        while (count > 0) {
+            pop_front();
+        }
+        head = 0;
+    }
+    
+    // Removes every item matching shouldRemove(const T&) in one pass,
+    // compacting the rest towards the front in order; returns the number removed
+    template<typename Predicate>
+    int remove_if(Predicate shouldRemove) {
+        int kept = 0;
+        for (int i = 0; i < count; i++) {
+            T* item = slot(i);
+            if (!shouldRemove(static_cast<const T&>(*item))) {
+                if (kept != i) {
+                    *slot(kept) = std::move(*item);
+                }
+                kept++;
+            }
+        }
+        int removed = count - kept;
+        for (int i = kept; i < count; i++) {
+            slot(i)->~T();
+        }
+        count = kept;
+        return removed;
+    }
+    
+    // Position 0 is the front
+    T& operator[](int index) {
+        return *slot(index);
+    }
+    
+    const T& operator[](int index) const {
+        return *slot(index);
+    }
+};
+
+/**
+ * Custom hash map with separate chaining (average O(1) find/insert/erase)
+ * Bucket count stays a power of two and doubles when entries exceed buckets.
+ */
+template<typename K, typename V>
+class CustomHashMap {
+private:
+    struct Entry {
+        K key;
+        V value;
+        Entry* next;
+        
+        Entry(const K& k, const V& v) : key(k), value(v), next(nullptr) {}
+    };
+    
+    Entry** buckets;
+    int bucketCount;
+    int count;
+    
+    int bucketFor(const K& key) const {
+        return (int)(std::hash<K>()(key) & (size_t)(bucketCount - 1));
+    }
+    
+    void rehash(int newBucketCount) {
+        Entry** newBuckets = new Entry*[newBucketCount]();
+        for (int i = 0; i < bucketCount; i++) {
+            Entry* entry = buckets[i];
+            while (entry != nullptr) {
+                Entry* next = entry->next;
+                int target = (int)(std::hash<K>()(entry->key) & (size_t)(newBucketCount - 1));
+                entry->next = newBuckets[target];
+                newBuckets[target] = entry;
+                entry = next;
+            }
+        }
+        delete[] buckets;
+        buckets = newBuckets;
+        bucketCount = newBucketCount;
+    }
+    
+public:
+    CustomHashMap(int initialBuckets = 16) : buckets(nullptr), bucketCount(1), count(0) {
+        while (bucketCount < initialBuckets) bucketCount *= 2;
+        buckets = new Entry*[bucketCount]();
+    }
+    
+    ~CustomHashMap() {
+        clear();
+        delete[] buckets;
+    }
+    
+    // Copy constructor
+    CustomHashMap(const CustomHashMap& other) : buckets(nullptr), bucketCount(other.bucketCount), count(0) {
+        buckets = new Entry*[bucketCount]();
+        other.forEach([this](const K& key, const V& value) {
+            insert(key, value);
+        });
+    }
+    
+    // Assignment operator
+    CustomHashMap& operator=(const CustomHashMap& other) {
+        if (this != &other) {
+            clear();
+            other.forEach([this](const K& key, const V& value) {
+                insert(key, value);
+            });
+        }
+        return *this;
+    }
+    
+    V* find(const K& key) {
+        for (Entry* entry = buckets[bucketFor(key)]; entry != nullptr; entry = entry->next) {
+            if (entry->key == key) return &entry->value;
+        }
+        return nullptr;
+    }
+    
+    const V* find(const K& key) const {
+        for (Entry* entry = buckets[bucketFor(key)]; entry != nullptr; entry = entry->next) {
+            if (entry->key == key) return &entry->value;
+        }
+        return nullptr;
+    }
+    
+    // Inserts or overwrites
+    void insert(const K& key, const V& value) {
+        V* existing = find(key);
+        if (existing != nullptr) {
+            *existing = value;
+            return;
+        }
+        
+        if (count >= bucketCount) {
+            rehash(bucketCount * 2);
+        }
+        int bucket = bucketFor(key);
+        Entry* entry = new Entry(key, value);
+        entry->next = buckets[bucket];
+        buckets[bucket] = entry;
+        count++;
+    }
+    
+    // Returns the value for key, inserting a default value if missing
+    V& operator[](const K& key) {
+        V* existing = find(key);
+        if (existing == nullptr) {
+            insert(key, V());
+            existing = find(key);
+        }
+        return *existing;
+    }
+    
+    bool erase(const K& key) {
+        Entry** link = &buckets[bucketFor(key)];
+        while (*link != nullptr) {
+            if ((*link)->key == key) {
+                Entry* victim = *link;
+                *link = victim->next;
+                delete victim;
+                count--;
+                return true;
+            }
+            link = &(*link)->next;
+        }
+        return false;
+    }
+    
+    bool empty() const {
+        return count == 0;
+    }
+    
+    int size() const {
+        return count;
+    }
+    
+    void clear() {
+        for (int i = 0; i < bucketCount; i++) {
+            while (buckets[i] != nullptr) {
+                Entry* temp = buckets[i];
+                buckets[i] = temp->next;
+                delete temp;
+            }
+        }
+        count = 0;
+    }
+    
+    // Visits every entry as visit(key, value) in unspecified order
+    template<typename Func>
+    void forEach(Func visit) const {
+        for (int i = 0; i < bucketCount; i++) {
+            for (Entry* entry = buckets[i]; entry != nullptr; entry = entry->next) {
+                visit(entry->key, entry->value);
+            }
+        }
+    }
+};
+
 /**
  * Custom Linked List for storing strings (for skill statistics)
  */
@@ -0,0 +1,50 @@
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+
+#include "VolunteerQueue.hpp"
+#include <string>
+
+/**
+ * Daemon mode keeps the queue, site registry and deployment index resident
+ * and serves requests from any number of local clients over a Unix domain
+ * socket (Linux, epoll).
+ *
+ * Framing: every request and response is a 4-byte little-endian payload
+ * length followed by the payload. Payload fields are separated by tabs; the
+ * first request field is the command, the first response field is OK or ERR.
+ * Clients may pipeline requests: each connection's responses come back in
+ * request order.
+ *
+ *   PING                                    -> OK  PONG
+ *   REGISTER name contact skill [lat lon]   -> OK  queue-size
+ *   DEPLOY [region [radius-km]]             -> OK  name contact skill site
+ *   BATCH count [region [radius-km]]        -> OK  deployed queue-size, then one "name contact skill site"
+ *                                              row per line, front of the queue first
+ *   RELEASE contact [requeue|checkout]      -> OK  site current max
+ *   QUEUE                                   -> OK  queue-size next-name
+ *   STATS                                   -> OK  registered queue-size deployed released requeued, then
+ *                                              "skill name registered deployed queued" and
+ *                                              "site name deployed released" rows, one per line
+ *   WHERE contact                           -> OK  site deployed-at
+ *   AT site                                 -> OK  count, then one "name contact skill deployed-at" row per line
+ *   FIND name                               -> OK  count, then one "name contact skill status site" row per line
+ *                                              (best name matches, typos and prefixes included)
+ *   SITES                                   -> OK, then one "region site current max" row per line
+ */
+const char* const DEFAULT_DAEMON_SOCKET = "../data/volunteer.sock";
+const unsigned int MAX_DAEMON_FRAME = 64 * 1024;  // Larger frames close the connection
+const size_t MAX_DAEMON_BACKLOG = 64 * MAX_DAEMON_FRAME;  // Unsent answers at which a client's requests stop being read
+
+/**
+ * Executes one request payload against the resident state
+ * @return Response payload (without the length prefix)
+ */
+std::string handleDaemonRequest(VolunteerQueue& queue, const std::string& request);
+
+/**
+ * Entry point for "--daemon" mode; runs until SIGINT or SIGTERM
+ * @return Process exit code
+ */
+int runDaemonMode(int argc, char* argv[]);
+
+#endif // DAEMON_HPP
@@ -0,0 +1,164 @@
+#ifndef DEPLOYMENT_INDEX_HPP
+#define DEPLOYMENT_INDEX_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+
+/**
+ * One active deployment, linked into its site's roster
+ */
+struct DeploymentNode {
+    Volunteer volunteer;
+    std::string site;
+    std::string deployedAt;          // "YYYY-MM-DD HH:MM:SS", empty for older log records
+    DeploymentNode* prev;            // Site roster links
+    DeploymentNode* next;
+    DeploymentNode* olderSameContact; // Earlier active deployment with the same contact, if any
+
+    DeploymentNode(const Volunteer& v, const std::string& s, const std::string& at = "")
+        : volunteer(v), site(s), deployedAt(at), prev(nullptr), next(nullptr), olderSameContact(nullptr) {}
+};
+
+/**
+ * DeploymentIndex - who is currently deployed where
+ *
+ * Each site keeps a doubly-linked roster of its active deployments and a hash
+ * map from contact to roster node, so releasing a volunteer unlinks them from
+ * their site in O(1) and listing a site costs O(k) for k volunteers on site.
+ *
+ * The index remembers how far into the deployment and release logs it has
+ * read. Records other running instances append later are applied by
+ * catchUp(); this instance's own records are skipped with markCaughtUp(),
+ * called after they are flushed while the logs are locked against the others.
+ */
+class DeploymentIndex {
+private:
+    struct Roster {
+        DeploymentNode* head;
+        int count;
+
+        Roster() : head(nullptr), count(0) {}
+    };
+
+    CustomHashMap<std::string, DeploymentNode*> byContact;
+    CustomHashMap<std::string, Roster> bySite;
+    int total;
+    std::string deployedLog;
+    std::string releasedLog;
+    long long deployedOffset;   // Text log bytes the index reflects
+    long long releasedOffset;
+
+    // Disable copying
+    DeploymentIndex(const DeploymentIndex&);
+    DeploymentIndex& operator=(const DeploymentIndex&);
+
+public:
+    /**
+     * Constructor - initializes empty index
+     */
+    DeploymentIndex();
+
+    /**
+     * Destructor - frees all roster nodes
+     */
+    ~DeploymentIndex();
+
+    /**
+     * Removes every deployment from the index
+     */
+    void clear();
+
+    /**
+     * Records that a volunteer is now deployed at a site
+     * @param deployedAt When the deployment happened (as written to the log)
+     */
+    void recordDeployment(const Volunteer& volunteer, const std::string& site, const std::string& deployedAt = "");
+
+    /**
+     * Looks up the most recent active deployment for a contact
+     * @return nullptr if the contact has no active deployment
+     */
+    const DeploymentNode* find(const std::string& contact) const;
+
+    /**
+     * Removes the most recent active deployment for a contact in O(1)
+     * @param contact Contact of the volunteer to release
+     * @param released Receives the volunteer, the site they were released from
+     *                 and when they were deployed there
+     * @return false if the contact has no active deployment
+     */
+    bool release(const std::string& contact, DeploymentNode& released);
+
+    /**
+     * Number of indexed volunteers currently at a site
+     */
+    int countAtSite(const std::string& site) const;
+
+    /**
+     * Total number of active deployments in the index
+     */
+    int size() const;
+
+    /**
+     * Visits every volunteer currently at a site, most recently deployed first
+     * @param visit Callable invoked as visit(const DeploymentNode&)
+     */
+    template<typename Func>
+    void forEachAtSite(const std::string& site, Func visit) const {
+        const Roster* roster = bySite.find(site);
+        if (roster == nullptr) return;
+        for (DeploymentNode* node = roster->head; node != nullptr; node = node->next) {
+            visit(*node);
+        }
+    }
+
+    /**
+     * Number of active deployments under a contact (most recent is find())
+     */
+    int countForContact(const std::string& contact) const;
+
+    /**
+     * Rebuilds the index from the deployment and release logs.
+     * Deployment records without a site (older format) cannot be indexed.
+     * @return Number of deployment records skipped because they had no site
+     */
+    int rebuildFromLogs(const std::string& deployedFile, const std::string& releasedFile);
+
+    /**
+     * Applies deployments and releases appended to the logs since they were
+     * last read (records without a site are skipped, as in rebuildFromLogs)
+     * @param deployed Receives the new deployments
+     * @param requeued Receives the volunteers released back to the queue
+     * @param checkedOut Receives the volunteers released for good
+     * @return Number of records applied
+     */
+    int catchUp(CustomLinkedList<DeploymentNode>& deployed, CustomLinkedList<DeploymentNode>& requeued,
+                CustomLinkedList<DeploymentNode>& checkedOut);
+
+    /**
+     * Marks everything now in the logs as already reflected in the index
+     */
+    void markCaughtUp();
+};
+
+/**
+ * Builds a count of active deployments per volunteer (deployments minus
+ * releases that returned the volunteer to the queue), keyed by volunteerKey()
+ */
+void loadActiveDeploymentCounts(CustomHashMap<std::string, int>& counts,
+                                const std::string& deployedFile, const std::string& releasedFile);
+
+/**
+ * Key identifying a volunteer record in the logs ("name,contact,skill")
+ */
+std::string volunteerKey(const Volunteer& volunteer);
+
+/**
+ * Parses a log line of the form name,contact,skill[,site[,extra]]
+ * (extra is the deployment time in the deployment log, the action in the release log)
+ * @return false if the line does not contain the three volunteer fields
+ */
+bool parseDeploymentRecord(const std::string& line, Volunteer& volunteer, std::string& site, std::string& extra);
+
+#endif // DEPLOYMENT_INDEX_HPP
@@ -0,0 +1,221 @@
+#ifndef HISTORY_ARCHIVE_HPP
+#define HISTORY_ARCHIVE_HPP
+
+#include "CustomLists.hpp"
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+
+/**
+ * HistoryArchive - compressed cold storage for the registration and
+ * deployment logs
+ *
+ * Archived log lines are stored in blocks of a few thousand records. Within a
+ * block each record is a varint field count followed by its fields, coded by
+ * the archive's column spec:
+ *   R  raw text (varint length + bytes)
+ *   D  id in the archive dictionary (skills, sites)
+ *   C  contact: local part as raw text plus the e-mail domain as a dictionary id
+ * The encoded block is then LZ compressed. The dictionary and a block index
+ * live in a footer at the end of the file:
+ *
+ *   "VSHA" version spec | block ... | "VSHF" dictionary index | footer-offset "VSHT"
+ *
+ * Each index entry carries the block's record count, a Bloom filter of the
+ * contacts in it and the count of every skill, so a contact lookup only
+ * decompresses blocks that may hold that contact, and record and skill
+ * totals need no decompression at all.
+ *
+ * Lines come back exactly as archived (trimmed, one record per line).
+ */
+class HistoryArchive {
+public:
+    static const int DEFAULT_BLOCK_RECORDS = 4096;
+
+    /**
+     * Column specs of the two archived logs
+     */
+    static const char* const REGISTRATION_SPEC;  // name,contact,skill[,latitude,longitude]
+    static const char* const DEPLOYMENT_SPEC;    // name,contact,skill,site,deployed-at
+
+    struct BlockInfo {
+        uint64_t offset;          // File position of the compressed block
+        uint32_t compressedSize;
+        uint32_t rawSize;
+        uint32_t records;
+        CustomArray<uint64_t> bloom;         // Contacts in the block
+        CustomArray<uint32_t> skillIds;      // Dictionary ids of the skills present...
+        CustomArray<uint32_t> skillCounts;   // ...and how many records have each
+
+        BlockInfo() : offset(0), compressedSize(0), rawSize(0), records(0) {}
+    };
+
+private:
+    std::string path;
+    std::string spec;
+    CustomArray<std::string> dictionary;
+    CustomArray<BlockInfo> blocks;
+    long long records;
+    uint64_t footerOffset;
+    mutable std::ifstream file;
+
+    // Disable copying
+    HistoryArchive(const HistoryArchive&);
+    HistoryArchive& operator=(const HistoryArchive&);
+
+    bool decodeBlock(const std::string& raw, uint32_t expected, CustomArray<std::string>& lines) const;
+
+public:
+    /**
+     * Constructor - initializes a closed archive
+     */
+    HistoryArchive();
+
+    /**
+     * Reads the header, dictionary and block index
+     * @return false if the file is missing or not a valid archive
+     */
+    bool open(const std::string& filename);
+
+    void close();
+
+    bool isOpen() const {
+        return file.is_open();
+    }
+
+    const std::string& getSpec() const {
+        return spec;
+    }
+
+    long long recordCount() const {
+        return records;
+    }
+
+    int blockCount() const {
+        return blocks.size();
+    }
+
+    long long compressedBytes() const;
+    long long rawBytes() const;
+
+    /**
+     * Decompresses one block into its lines
+     * @return false if the block is corrupt
+     */
+    bool readBlock(int block, CustomArray<std::string>& lines) const;
+
+    /**
+     * Whether a block may contain records with this contact (no false negatives)
+     */
+    bool mayContainContact(int block, const std::string& contact) const;
+
+    /**
+     * Adds up the per-block skill counts without decompressing anything
+     */
+    void skillTotals(CustomHashMap<std::string, long long>& totals) const;
+
+    /**
+     * Calls fn(line) for every archived line, oldest first
+     * @return false if a block was corrupt (earlier lines were still delivered)
+     */
+    template<typename Fn>
+    bool forEachLine(Fn fn) const {
+        CustomArray<std::string> lines;
+        for (int b = 0; b < blocks.size(); b++) {
+            if (!readBlock(b, lines)) {
+                return false;
+            }
+            for (int i = 0; i < lines.size(); i++) {
+                fn(lines[i]);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Calls fn(line) for every archived line that may belong to a contact,
+     * decompressing only the blocks whose Bloom filter matches (callers still
+     * check the contact field)
+     * @return Number of blocks decompressed
+     */
+    template<typename Fn>
+    int forEachLineWithContact(const std::string& contact, Fn fn) const {
+        CustomArray<std::string> lines;
+        int decoded = 0;
+        for (int b = 0; b < blocks.size(); b++) {
+            if (!mayContainContact(b, contact) || !readBlock(b, lines)) {
+                continue;
+            }
+            decoded++;
+            for (int i = 0; i < lines.size(); i++) {
+                fn(lines[i]);
+            }
+        }
+        return decoded;
+    }
+
+    /**
+     * Writes filename with the existing archive's blocks (copied without
+     * decompressing) followed by new blocks holding lines. The new archive is
+     * written to a temporary file; the caller renames it into place.
+     * @param tempName Receives the temporary file name
+     * @return false with error set if the archive could not be written
+     */
+    static bool writeWithAppended(const std::string& filename, const std::string& columnSpec,
+                                  const CustomArray<std::string>& lines, int blockRecords,
+                                  std::string& tempName, std::string& error);
+};
+
+/**
+ * Archive file that holds the cold history of a text log ("x.txt" -> "x.archive")
+ */
+std::string archiveFileFor(const std::string& logFile);
+
+/**
+ * Calls fn(line) for every record of a log: the archived ones first, then the
+ * lines still in the text file (trimmed, empty lines skipped)
+ * @return false if neither the archive nor the text log exists
+ */
+template<typename Fn>
+bool forEachHistoryLine(const std::string& logFile, Fn fn) {
+    bool found = false;
+    HistoryArchive archive;
+    if (archive.open(archiveFileFor(logFile))) {
+        found = true;
+        if (!archive.forEachLine(fn)) {
+            std::cout << "Warning: " << archiveFileFor(logFile) << " has a corrupt block; "
+                      << "later archived records were skipped.\n";
+        }
+    }
+
+    std::ifstream text(logFile);
+    if (text.is_open()) {
+        found = true;
+        std::string line;
+        while (std::getline(text, line)) {
+            size_t start = line.find_first_not_of(" \t\r\n");
+            if (start == std::string::npos) continue;
+            size_t end = line.find_last_not_of(" \t\r\n");
+            fn(line.substr(start, end - start + 1));
+        }
+    }
+    return found;
+}
+
+/**
+ * Entry point for "--archive-history" mode
+ * @return Process exit code
+ */
+int runArchiveMode(int argc, char* argv[]);
+
+/** Journal an archive run commits before it replaces any file */
+const char* const ARCHIVE_JOURNAL_FILE = "../data/archive.journal";
+
+/**
+ * Completes an archive run that stopped part way, from its journal
+ * @return true if there was a run to complete
+ */
+bool finishArchiveRun(const std::string& journalFile);
+
+#endif // HISTORY_ARCHIVE_HPP
@@ -0,0 +1,131 @@
+#ifndef LIVE_STATS_HPP
+#define LIVE_STATS_HPP
+
+#include "CustomLists.hpp"
+#include <string>
+
+/**
+ * LiveStats - running totals over the registration, deployment and release
+ * logs, so reports never re-read the history
+ *
+ * Every record this process appends to a log is folded in as it is written
+ * (one parsed line, O(1)). The totals are saved with a cursor of how much of
+ * each log they cover, plus how many records each history archive held:
+ *
+ *   VSTATS 1
+ *   cursor <registrations> <deployments> <releases>     (text log bytes)
+ *   archived <registrations> <deployments>               (archive records)
+ *   totals <registered> <deployed> <released> <requeued>
+ *   registered-skill|deployed-skill|deployed-site|released-site <name> <count>
+ *
+ * with fields separated by tabs. At load only log bytes past the cursor are
+ * read; a file that no longer matches the logs (or the archives) is rebuilt
+ * from the full history once. Records appended by other processes (a second
+ * console, the daemon) show up as log growth this process did not write, and
+ * reconcile() folds in exactly the bytes appended since load.
+ */
+class LiveStats {
+public:
+    enum LogKind {
+        REGISTRATION_LOG,
+        DEPLOYMENT_LOG,
+        RELEASE_LOG,
+        LOG_COUNT
+    };
+
+    struct Totals {
+        long long registered;
+        long long deployed;
+        long long released;
+        long long requeued;  // Releases that sent the volunteer back to the queue
+        CustomHashMap<std::string, long long> registeredBySkill;
+        CustomHashMap<std::string, long long> deployedBySkill;
+        CustomHashMap<std::string, long long> deployedBySite;
+        CustomHashMap<std::string, long long> releasedBySite;
+
+        Totals() : registered(0), deployed(0), released(0), requeued(0) {}
+    };
+
+private:
+    std::string logs[LOG_COUNT];
+    Totals current;
+    Totals base;                    // Totals as of the cursor
+    long long cursor[LOG_COUNT];    // Log bytes folded into base
+    long long pending[LOG_COUNT];   // Bytes this process appended since (folded into current only)
+    long long archived[2];          // Archive records (registrations, deployments) base includes
+    bool unterminated[LOG_COUNT];   // Log ends at the cursor in a record without its newline
+    bool loaded;
+
+    // Disable copying
+    LiveStats(const LiveStats&);
+    LiveStats& operator=(const LiveStats&);
+
+    bool readFile(const std::string& filename);
+    void rebuild(bool includeUnterminated);
+    void noteUnterminatedEnds();
+
+    /**
+     * Folds the lines of a log from cursor[log] on into base and moves the
+     * cursor past them
+     * @param includeUnterminated Whether a last line without its newline is
+     *                            a record (at load) or still being written
+     * @return false if the log shrank below the cursor
+     */
+    bool foldTail(LogKind log, bool includeUnterminated);
+
+public:
+    /**
+     * Constructor - totals over the given logs (not read until load)
+     */
+    LiveStats(const std::string& registrationLog, const std::string& deploymentLog,
+              const std::string& releaseLog);
+
+    /**
+     * Updates the totals with one log line (shared by live updates and log reads)
+     */
+    static void fold(Totals& totals, LogKind log, const std::string& line);
+
+    /**
+     * Restores saved totals and catches up with the logs, or rebuilds them
+     * from the full history. Records still held by a log writer must be
+     * flushed first.
+     * @return Number of log records read (0 when the saved totals were current)
+     */
+    long long load(const std::string& filename);
+
+    bool isLoaded() const {
+        return loaded;
+    }
+
+    /**
+     * Counts a record this process is appending to a log
+     */
+    void noteAppended(LogKind log, const std::string& record);
+
+    /**
+     * Picks up records other processes appended (after a log writer flush)
+     * @return true if the logs had changed behind this process
+     */
+    bool reconcile();
+
+    /**
+     * Writes the totals and their cursor, through a temporary file
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& filename);
+
+    const Totals& totals() const {
+        return current;
+    }
+
+    /**
+     * Keeps a saved stats file valid after a log prefix moved into its archive:
+     * the archive grew from archivedBefore to archivedAfter records and the
+     * text log lost its first droppedBytes. Files that did not cover the
+     * moved records are left alone (they are rebuilt at the next load).
+     */
+    static bool moveCursorPastArchived(const std::string& filename, LogKind log, long long droppedBytes,
+                                       long long archivedBefore, long long archivedAfter);
+};
+
+#endif // LIVE_STATS_HPP
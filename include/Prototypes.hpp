@@ -1,24 +1,70 @@
 #include "../include/VolunteerQueue.hpp"
 #include "../include/CustomLists.hpp"
+#include "../include/SiteAlgorithm.hpp"
+#include "../include/DeploymentIndex.hpp"
+#include "../include/RegionRegistry.hpp"
+#include "../include/Snapshot.hpp"
+#include "../include/RegistrationFollower.hpp"
+#include "../include/LiveStats.hpp"
+#include "../include/VolunteerSearch.hpp"
 #include <string>
 
+// Default travel radius when deploying a volunteer with a known location
+const double DEFAULT_TRAVEL_RADIUS_KM = 50.0;
+
+// Default weekly hour cap per volunteer when building a shift roster
+const int DEFAULT_MAX_WEEKLY_HOURS = 40;
+
 // Function prototypes
 void displayMenu();
+bool runMenuIteration(VolunteerQueue& queue);
 void registerVolunteer(VolunteerQueue& queue);
 void registerSingleVolunteer(VolunteerQueue& queue);
 void registerMultipleVolunteers(VolunteerQueue& queue);
 void deployVolunteer(VolunteerQueue& queue);
+void releaseVolunteer(VolunteerQueue& queue);
+void locateDeployment(const VolunteerQueue& queue);
+int catchUpDeployments(VolunteerQueue& queue);
+bool commitDeployment(VolunteerQueue& queue, const SiteLocation& location, Volunteer& deployed);
+SiteLocation chooseDeploymentSite(const Volunteer& next, const std::string& regionFilter, double radiusKm);
+int commitBatchDeployment(VolunteerQueue& queue, int count, const std::string& regionFilter, double radiusKm,
+                          CustomLinkedList<DeploymentNode>& deployed);
+bool commitRelease(VolunteerQueue& queue, const std::string& contact, bool requeue,
+                   DeploymentNode& released, SiteLocation& location, std::string& error);
+void planShiftRoster(const VolunteerQueue& queue);
+void readOptionalAvailability(const Volunteer& volunteer);
+RegionRegistry& siteRegistry();
+void printRegionSummary(const RegionRegistry& registry);
+DeploymentIndex& deploymentIndex();
+VolunteerSearchIndex& volunteerSearch();
+VolunteerSearchIndex& builtVolunteerSearch(const VolunteerQueue& queue);
+bool printNameMatches(const VolunteerQueue& queue, const std::string& query);
+SnapshotStore& snapshotStore();
 CustomLinkedList<ReliefSite> loadReliefSites(const std::string& filename);
-void saveReliefSites(const CustomLinkedList<ReliefSite>& sites, const std::string& filename);
+void saveReliefSites(const CustomArray<ReliefSite>& sites, const std::string& filename);
 
 void viewRegisteredVolunteers(const VolunteerQueue& queue);
 void displayVolunteersFromFile(const std::string& filename);
 void displayCombinedVolunteerReport(const VolunteerQueue& queue);
+void displayLiveStatistics(const VolunteerQueue& queue);
+LiveStats& liveStats();
 void saveVolunteerToFile(const Volunteer& volunteer, const std::string& filename);
 void saveAllVolunteersToFile(const VolunteerQueue& queue, const std::string& filename);
-void loadVolunteersFromFile(VolunteerQueue& queue, const std::string& filename);
+long long loadVolunteersFromFile(VolunteerQueue& queue, const std::string& filename, long long startOffset = 0,
+                                 bool includeArchive = true);
+long long initializeQueue(VolunteerQueue& queue);
+RegistrationFollower& registrationFollower();
+void trackRegistrations(long long offset);
+bool startFollowing(long long offset);
+void loadDispatchSettings(VolunteerQueue& queue, const std::string& filename);
 void validateVolunteerFile(const std::string& filename);
-void saveDeployedVolunteer(const Volunteer& volunteer, const std::string& filename);
+void saveDeployedVolunteer(const Volunteer& volunteer, const std::string& site, const std::string& deployedAt,
+                           const std::string& filename);
+std::string currentTimestamp();
 bool isVolunteerDeployed(const Volunteer& volunteer, const std::string& filename);
+bool parseVolunteerRecord(const std::string& line, Volunteer& volunteer);
+bool parseCoordinates(const std::string& text, double& latitude, double& longitude);
+std::string formatCoordinates(double latitude, double longitude);
+void readOptionalLocation(Volunteer& volunteer);
 std::string trim(const std::string& str);
 void pauseForUser();
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef QUEUE_STATE_HPP
+#define QUEUE_STATE_HPP
+
+#include "VolunteerQueue.hpp"
+#include <string>
+#include <fstream>
+
+/**
+ * Cursor recording how much of the on-disk logs a saved queue already reflects
+ */
+struct QueueCursor {
+    long long registrationOffset;  // Bytes of volunteers.txt already folded into the queue
+    long long deployedOffset;      // Size of deployed_volunteers.txt when the state was saved
+    long long releasedOffset;      // Size of released_volunteers.txt when the state was saved
+
+    // Constructor
+    QueueCursor(long long registration = 0, long long deployed = 0, long long released = 0)
+        : registrationOffset(registration), deployedOffset(deployed), releasedOffset(released) {}
+};
+
+/**
+ * Writes the pending queue (in FIFO order) and its cursor to a compact binary file.
+ * The file is written to a temporary name first and then renamed into place.
+ * @return true if the state was written completely
+ */
+bool saveQueueState(const VolunteerQueue& queue, const QueueCursor& cursor, const std::string& filename);
+
+/**
+ * Reads only the cursor from a saved queue state file
+ * @return false if the file is missing or not a queue state file
+ */
+bool readQueueCursor(const std::string& filename, QueueCursor& cursor);
+
+/**
+ * Overwrites the cursor of a saved queue state file in place (used when the
+ * logs it points into are compacted)
+ * @return false if the file is missing or not a queue state file
+ */
+bool rewriteQueueCursor(const std::string& filename, const QueueCursor& cursor);
+
+/**
+ * Appends the saved volunteers to the queue in their saved order.
+ * Nothing is enqueued unless the whole file parses correctly.
+ * @return false if the file is missing or corrupt
+ */
+bool loadQueueState(VolunteerQueue& queue, QueueCursor& cursor, const std::string& filename);
+
+/**
+ * Writes one volunteer in the queue state record layout
+ * (also used for queue spill segments)
+ */
+void writeVolunteerRecord(std::ofstream& out, const Volunteer& v);
+
+/**
+ * Reads one volunteer written by writeVolunteerRecord
+ * @return false on a truncated or corrupt record
+ */
+bool readVolunteerRecord(std::ifstream& in, Volunteer& v);
+
+/**
+ * Returns the size of a file in bytes, or -1 if it cannot be opened
+ */
+long long logFileSize(const std::string& filename);
+
+/**
+ * Reads the lines appended to a log since offset and advances offset past them
+ * @param includeUnterminated Also take a last line without its newline (at
+ *        startup, for a log no writer is appending to); otherwise it is left
+ *        for the next read, as it may still be being written
+ */
+void readAppendedLines(const std::string& filename, long long& offset, CustomArray<std::string>& lines,
+                       bool includeUnterminated = false);
+
+#endif // QUEUE_STATE_HPP
@@ -0,0 +1,208 @@
+#ifndef REGION_REGISTRY_HPP
+#define REGION_REGISTRY_HPP
+
+#include "SiteAlgorithm.hpp"
+#include "SpatialIndex.hpp"
+#include "SharedSiteTable.hpp"
+#include <string>
+
+/**
+ * One region's sites, backed by its own file and priority index
+ */
+struct RegionShard {
+    std::string region;
+    std::string filename;
+    SitePriorityIndex sites;
+    bool dirty;  // Has unsaved count changes
+
+    RegionShard(const std::string& r, const std::string& f) : region(r), filename(f), dirty(false) {}
+};
+
+/**
+ * RegionRegistry - relief sites partitioned into region shards
+ *
+ * Each region is loaded from, and saved to, its own file, so deployments in
+ * one region never rewrite another region's data. Best-site search is a
+ * serial reduction over each shard's priority index (one comparison per
+ * shard). Sites with coordinates are also kept in a spatial index for
+ * nearest-available-site lookups.
+ *
+ * After shareCounts() the authoritative counts live in a SharedSiteTable, so
+ * several instances on one host deploy against the same numbers; the local
+ * indexes are a cache that syncShared() brings up to date.
+ */
+class RegionRegistry {
+private:
+    CustomArray<RegionShard*> shards;
+    CustomHashMap<std::string, int> shardByRegion;
+    CustomHashMap<std::string, SiteLocation> siteByName;
+    SiteSpatialIndex spatial;  // Sites that have coordinates, across all regions
+    long long version;         // Bumped on every load and count change
+    SharedSiteTable shared;    // Cross-process counts, when attached
+    CustomArray<int> sharedOffset;  // First shared-table slot of each shard
+    uint64_t seenGeneration;   // Shared generation the local indexes reflect
+    SitePolicyKind policy;     // Rule bestSite applies
+    SiteSelectionState policyState;  // Round-robin position and weights
+
+    // Disable copying
+    RegionRegistry(const RegionRegistry&);
+    RegionRegistry& operator=(const RegionRegistry&);
+
+    SiteLocation bestInRange(int first, int last, int onlyShard) const;
+    void applyCount(const SiteLocation& location, int delta);
+
+public:
+    // Shard files per load worker: a small file reads in a few microseconds
+    // and a thread costs ~13 us to start and join, so fewer files load serially
+    static const int PARALLEL_LOAD_THRESHOLD = 64;
+
+    /**
+     * Constructor - initializes empty registry
+     */
+    RegionRegistry();
+
+    /**
+     * Destructor - frees all shards
+     */
+    ~RegionRegistry();
+
+    /**
+     * Removes every shard
+     */
+    void clear();
+
+    /**
+     * Loads the regions listed in a manifest ("RegionName sites_file" per line,
+     * file paths relative to dataDir), reading the shard files in parallel.
+     * Falls back to a single "Default" region from fallbackFile when the
+     * manifest does not exist.
+     * @return Number of shards loaded
+     */
+    int load(const std::string& manifestFile, const std::string& dataDir, const std::string& fallbackFile);
+
+    /**
+     * Most needed non-full site across all shards, or within one region, under
+     * the site policy. The default lowest fill ratio reads each shard's
+     * priority index; the other policies scan every site in registry order.
+     * @param regionFilter Region name, or empty for every region
+     * @return Invalid location if no matching site has room
+     */
+    SiteLocation bestSite(const std::string& regionFilter = "") const;
+
+    /**
+     * Selects the rule bestSite applies (see SitePolicyKind)
+     */
+    void setSitePolicy(SitePolicyKind kind) {
+        policy = kind;
+        policyState = SiteSelectionState();
+    }
+
+    SitePolicyKind sitePolicy() const {
+        return policy;
+    }
+
+    /**
+     * Moves the site policy's state (the round-robin position) past a
+     * deployment once it is committed; bestSite itself never moves it, so
+     * lookups that end without a deployment do not skip sites
+     */
+    void noteDeployedTo(const SiteLocation& location);
+
+    /**
+     * Nearest non-full site within radiusKm of a point; equally distant sites
+     * are ranked like bestSite (lowest fill ratio first)
+     * @return Invalid location if no site with coordinates has room in range
+     */
+    SiteLocation nearestSite(double latitude, double longitude, double radiusKm) const;
+
+    /**
+     * Distance in km from a point to a site (site must have coordinates)
+     */
+    double distanceKm(double latitude, double longitude, const SiteLocation& location) const;
+
+    /**
+     * Whether any site has coordinates
+     */
+    bool hasSpatialSites() const {
+        return !spatial.empty();
+    }
+
+    /**
+     * Looks a site up by name (site names are unique across regions)
+     */
+    SiteLocation find(const std::string& siteName) const;
+
+    /**
+     * Changes a site's count, updates the priority and spatial indexes,
+     * and marks only its region for saving
+     * @return false if the site filled up in another instance (nothing changed)
+     */
+    bool adjustCount(const SiteLocation& location, int delta);
+
+    /**
+     * Writes every region with unsaved changes to its own file
+     */
+    void saveDirty();
+
+    /**
+     * Shares site counts with other instances through a table file
+     * @return false if shared memory is unavailable (counts stay local)
+     */
+    bool shareCounts(const std::string& tableFile);
+
+    /**
+     * Pulls count changes made by other instances into the local indexes;
+     * costs one atomic load when nothing changed
+     */
+    void syncShared();
+
+    bool isShared() const {
+        return shared.attached();
+    }
+
+    /**
+     * Takes or releases the advisory lock of the shared table, which every
+     * instance holds while writing the site files or the deployment logs
+     * (no-op while counts are not shared; not reentrant, so saveDirty() must
+     * not run while it is held)
+     */
+    void lockShared() {
+        shared.lock();
+    }
+
+    void unlockShared() {
+        shared.unlock();
+    }
+
+    const ReliefSite& site(const SiteLocation& location) const {
+        return shards[location.shard]->sites.site(location.index);
+    }
+
+    const RegionShard& shard(int index) const {
+        return *shards[index];
+    }
+
+    /**
+     * Index of a region's shard, or -1 if unknown
+     */
+    int shardIndex(const std::string& region) const;
+
+    int shardCount() const {
+        return shards.size();
+    }
+
+    int totalSites() const;
+
+    /**
+     * Change counter, so read views know when they are stale
+     */
+    long long getVersion() const {
+        return version;
+    }
+
+    bool empty() const {
+        return totalSites() == 0;
+    }
+};
+
+#endif // REGION_REGISTRY_HPP
@@ -0,0 +1,121 @@
+#ifndef REGISTRATION_FOLLOWER_HPP
+#define REGISTRATION_FOLLOWER_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+
+/**
+ * RegistrationFollower - ingests registrations appended to the log while running
+ *
+ * Every instance tracks the log from the offset its queue reflects; with
+ * follow mode on it also watches it. Without follow mode, records appended
+ * by others are ingested once, before the queue state is saved, so the
+ * saved cursor never moves past a registration the queue has not seen.
+ *
+ * Remembers the byte offset just past the last ingested record and, when
+ * inotify reports that the log changed, reads only the bytes appended since.
+ * A trailing line without its newline is left for the next read. The
+ * deployed check runs against active-deployment counts that are kept up to
+ * date the same way, by reading only what was appended to the deployment and
+ * release logs, so each ingestion costs time proportional to the new data.
+ *
+ * Records this instance appended itself are already queued; they are
+ * announced with expectOwnRecord() and skipped when read back.
+ *
+ * inotify is Linux only; elsewhere start() fails and ingest() can still be
+ * called to poll the log.
+ */
+class RegistrationFollower {
+private:
+    std::string registrationFile;
+    std::string deployedFile;
+    std::string releasedFile;
+    long long offset;           // Just past the last ingested registration
+    long long deployedOffset;
+    long long releasedOffset;
+    CustomHashMap<std::string, int> activeCounts;  // Active deployments per volunteerKey()
+    CustomHashMap<std::string, int> ownRecords;    // Appended here, not yet read back
+    int inotifyFd;
+    bool following;
+    bool deploymentsLoaded;     // Active counts built (on the first ingestion with new records)
+
+    // Disable copying
+    RegistrationFollower(const RegistrationFollower&);
+    RegistrationFollower& operator=(const RegistrationFollower&);
+
+    void catchUpDeployments();
+
+public:
+    /**
+     * Constructor - initializes an idle follower
+     */
+    RegistrationFollower();
+
+    /**
+     * Destructor - stops watching
+     */
+    ~RegistrationFollower();
+
+    /**
+     * Tracks the registration log from a byte offset without watching it
+     * @param startOffset Offset the queue already reflects (from initializeQueue)
+     */
+    void track(const std::string& registrations, long long startOffset,
+               const std::string& deployed, const std::string& released);
+
+    /**
+     * Starts following the registration log from a byte offset
+     * @param startOffset Offset the queue already reflects (from initializeQueue)
+     * @return false if the log cannot be watched
+     */
+    bool start(const std::string& registrations, long long startOffset,
+               const std::string& deployed, const std::string& released);
+
+    /**
+     * Stops watching the log
+     */
+    void stop();
+
+    bool isFollowing() const {
+        return following;
+    }
+
+    bool isTracking() const {
+        return !registrationFile.empty();
+    }
+
+    /**
+     * Descriptor that becomes readable when the log may have grown (-1 if not following)
+     */
+    int fd() const {
+        return inotifyFd;
+    }
+
+    /**
+     * Notes a record this instance appended, so it is not queued twice
+     */
+    void expectOwnRecord(const Volunteer& volunteer);
+
+    /**
+     * Drains pending change notifications and ingests if the log changed
+     * @return Number of volunteers enqueued
+     */
+    int poll(VolunteerQueue& queue);
+
+    /**
+     * Reads and enqueues every complete record appended since the last call
+     * @return Number of volunteers enqueued
+     */
+    int ingest(VolunteerQueue& queue);
+
+    const std::string& getFilename() const {
+        return registrationFile;
+    }
+
+    long long getOffset() const {
+        return offset;
+    }
+};
+
+#endif // REGISTRATION_FOLLOWER_HPP
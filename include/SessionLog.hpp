@@ -0,0 +1,108 @@
+#ifndef SESSION_LOG_HPP
+#define SESSION_LOG_HPP
+
+#include <streambuf>
+#include <fstream>
+#include <string>
+#include <chrono>
+
+/**
+ * Session logs make operator sessions repeatable.
+ *
+ * While recording, std::cin reads through a buffer that copies every byte
+ * the menus consume. Each pass of the menu loop (the choice, every answer
+ * given inside the action, and the Enter at the pause) becomes one record:
+ *
+ *   VSESSION 1
+ *   <ms since session start> TAB <escaped input>
+ *
+ * with backslash, tab, newline and carriage return escaped as \\ \t \n \r.
+ * The time is when the first byte of the action was entered.
+ *
+ * Replay feeds each record back through the same menu code against a
+ * scratch copy of the data directory, with console output discarded, and
+ * reports how long each action took.
+ */
+const char* const SESSION_LOG_HEADER = "VSESSION 1";
+
+/**
+ * Input buffer that passes bytes through from another buffer and keeps a copy
+ */
+class RecordingStreambuf : public std::streambuf {
+private:
+    std::streambuf* source;
+    std::string captured;
+    std::chrono::steady_clock::time_point firstByte;  // Arrival of captured[0]
+    char current;
+
+protected:
+    int_type underflow();
+
+public:
+    explicit RecordingStreambuf(std::streambuf* from) : source(from), current(0) {}
+
+    /**
+     * Hands over the bytes consumed since the last call
+     * @param firstByteAt Set to the arrival time of the first of them
+     * @return false if nothing was consumed
+     */
+    bool take(std::string& bytes, std::chrono::steady_clock::time_point& firstByteAt);
+};
+
+/**
+ * SessionRecorder - writes the console session to a session log
+ */
+class SessionRecorder {
+private:
+    std::ofstream log;
+    RecordingStreambuf* tap;
+    std::streambuf* original;   // std::cin's own buffer, restored on stop()
+    std::chrono::steady_clock::time_point started;
+
+    // Disable copying
+    SessionRecorder(const SessionRecorder&);
+    SessionRecorder& operator=(const SessionRecorder&);
+
+public:
+    SessionRecorder() : tap(nullptr), original(nullptr) {}
+
+    /**
+     * Destructor - writes any pending action and stops recording
+     */
+    ~SessionRecorder();
+
+    /**
+     * Starts copying std::cin input to a new session log
+     * @return false if the log cannot be created
+     */
+    bool start(const std::string& filename);
+
+    /**
+     * Writes the input consumed since the previous call as one record
+     * (does nothing when not recording)
+     */
+    void finishAction();
+
+    /**
+     * Writes any pending action and restores std::cin
+     */
+    void stop();
+
+    bool isRecording() const {
+        return tap != nullptr;
+    }
+};
+
+/**
+ * Escapes / restores a record's input for the one-line log format
+ */
+std::string escapeSessionInput(const std::string& input);
+std::string unescapeSessionInput(const std::string& escaped);
+
+/**
+ * Entry point for "--replay-session" mode
+ * @return Process exit code
+ */
+int runSessionReplayMode(int argc, char* argv[]);
+
+#endif // SESSION_LOG_HPP
@@ -0,0 +1,131 @@
+#ifndef SHARED_SITE_TABLE_HPP
+#define SHARED_SITE_TABLE_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+#include <stdint.h>
+
+/**
+ * SharedSiteTable - site counts shared by every process on the host
+ *
+ * The table lives in a file mapped MAP_SHARED into each running instance, so
+ * a deployment made by one operator is visible to the others immediately.
+ * Counts change only through atomic compare-and-swap on the mapped memory: a
+ * slot is claimed only while the site still has room, so two processes can
+ * never both take the last place. A generation counter changes with every
+ * update, letting each process tell cheaply whether its local copy is stale.
+ *
+ * An advisory lock (flock) on a companion ".lock" file serializes the slow
+ * paths: attaching, rebuilding the table after the site files changed,
+ * rewriting the site text files, and deploying or releasing (so each instance
+ * can read the other instances' log records before appending its own). Every attached instance also holds a shared
+ * flock on the table file itself. A rebuild (which replaces the file) only
+ * happens while nobody holds that lock, so no running instance is ever left
+ * counting on an orphaned table; an instance whose site files no longer match
+ * the table in use stays detached until the other instances restart.
+ *
+ * Linux only; elsewhere attach() fails and the registry works as before.
+ */
+class SharedSiteTable {
+public:
+    /**
+     * Mapped layout: one Header followed by siteCount Entry records
+     */
+    struct Header {
+        uint32_t magic;
+        uint32_t siteCount;
+        uint64_t generation;  // Bumped on every count change
+    };
+
+    struct Entry {
+        uint64_t key;          // Hash of region and site name
+        int32_t maxCapacity;
+        int32_t currentCount;
+    };
+
+private:
+    int lockFd;
+    int tableFd;  // Kept open for its shared flock while attached
+    Header* header;
+    Entry* entries;
+    size_t mappedBytes;
+
+    // Disable copying
+    SharedSiteTable(const SharedSiteTable&);
+    SharedSiteTable& operator=(const SharedSiteTable&);
+
+public:
+    static const uint32_t MAGIC = 0x54535356;  // "VSST"
+
+    /**
+     * Constructor - initializes a detached table
+     */
+    SharedSiteTable();
+
+    /**
+     * Destructor - unmaps the table
+     */
+    ~SharedSiteTable();
+
+    /**
+     * Maps the table file, creating it from the given sites when it does not
+     * exist or was built for a different site layout.
+     * @param keys Identity of each site (see siteKey), in registry order
+     * @param sites Loaded site records, in the same order
+     * @param created Set to true if this call (re)built the table
+     * @param inUse Set to true if the table needed rebuilding but other
+     *              instances still have it attached
+     * @return false if shared memory is unavailable or the table is in use
+     */
+    bool attach(const std::string& path, const CustomArray<uint64_t>& keys,
+                const CustomArray<ReliefSite>& sites, bool& created, bool& inUse);
+
+    /**
+     * Unmaps the table and closes the file
+     */
+    void detach();
+
+    bool attached() const {
+        return header != nullptr;
+    }
+
+    int size() const {
+        return header ? (int)header->siteCount : 0;
+    }
+
+    /**
+     * Change counter; differs from an earlier value if any count changed since
+     */
+    uint64_t generation() const;
+
+    /**
+     * Current count of one site
+     */
+    int count(int slot) const;
+
+    /**
+     * Atomically takes one place at a site
+     * @return false if the site is already full
+     */
+    bool claim(int slot);
+
+    /**
+     * Atomically frees one place at a site (never goes below zero)
+     * @return false if the site was already empty
+     */
+    bool release(int slot);
+
+    /**
+     * Takes or releases the advisory lock on the table file
+     */
+    void lock();
+    void unlock();
+
+    /**
+     * Identity of a site in the table
+     */
+    static uint64_t siteKey(const std::string& region, const ReliefSite& site);
+};
+
+#endif // SHARED_SITE_TABLE_HPP
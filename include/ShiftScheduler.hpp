@@ -0,0 +1,277 @@
+#ifndef SHIFT_SCHEDULER_HPP
+#define SHIFT_SCHEDULER_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+#include <algorithm>
+
+/**
+ * A span of time in minutes since Monday 00:00, half-open [start, end)
+ */
+struct TimeWindow {
+    int start;
+    int end;
+
+    TimeWindow(int s = 0, int e = 0) : start(s), end(e) {}
+
+    int length() const {
+        return end - start;
+    }
+};
+
+const int MINUTES_PER_DAY = 24 * 60;
+const int MINUTES_PER_WEEK = 7 * MINUTES_PER_DAY;
+
+/**
+ * Parses "Mon 08:00-16:00"; an end at or before the start runs into the next day
+ */
+bool parseTimeWindow(const std::string& text, TimeWindow& window);
+
+/**
+ * Formats a window as "Mon 08:00-16:00"
+ */
+std::string formatTimeWindow(const TimeWindow& window);
+
+/**
+ * IntervalTree - static interval tree over TimeWindows
+ *
+ * Intervals are sorted by start and laid out as an implicit balanced tree
+ * (each subtree is a contiguous range whose root is the middle element).
+ * Every root also stores the largest and smallest end in its subtree, so
+ * containment queries skip whole subtrees and cost O(log n + k).
+ */
+template<typename T>
+class IntervalTree {
+private:
+    struct Item {
+        TimeWindow window;
+        T value;
+        int maxEnd;  // Largest end in the subtree rooted here
+        int minEnd;  // Smallest end in the subtree rooted here
+    };
+
+    CustomArray<Item> items;
+
+    void augment(int lo, int hi) {
+        if (lo >= hi) return;
+        int mid = lo + (hi - lo) / 2;
+        augment(lo, mid);
+        augment(mid + 1, hi);
+
+        Item& root = items[mid];
+        root.maxEnd = root.minEnd = root.window.end;
+        if (lo < mid) {
+            const Item& left = items[lo + (mid - lo) / 2];
+            if (left.maxEnd > root.maxEnd) root.maxEnd = left.maxEnd;
+            if (left.minEnd < root.minEnd) root.minEnd = left.minEnd;
+        }
+        if (mid + 1 < hi) {
+            const Item& right = items[mid + 1 + (hi - mid - 1) / 2];
+            if (right.maxEnd > root.maxEnd) root.maxEnd = right.maxEnd;
+            if (right.minEnd < root.minEnd) root.minEnd = right.minEnd;
+        }
+    }
+
+    template<typename Func>
+    void containing(int lo, int hi, const TimeWindow& query, Func& func) const {
+        if (lo >= hi) return;
+        int mid = lo + (hi - lo) / 2;
+        const Item& root = items[mid];
+        if (root.maxEnd < query.end) return;  // Nothing here lasts long enough
+
+        containing(lo, mid, query, func);
+        if (root.window.start > query.start) return;  // Right side starts even later
+        if (root.window.end >= query.end) func(root.window, root.value);
+        containing(mid + 1, hi, query, func);
+    }
+
+    template<typename Func>
+    void within(int lo, int hi, const TimeWindow& query, Func& func) const {
+        if (lo >= hi) return;
+        int mid = lo + (hi - lo) / 2;
+        const Item& root = items[mid];
+        if (root.minEnd > query.end) return;  // Everything here ends too late
+
+        if (root.window.start >= query.start) {
+            within(lo, mid, query, func);
+            if (root.window.end <= query.end) func(root.window, root.value);
+        }
+        if (root.window.start > query.end) return;  // Right side starts after the query
+        within(mid + 1, hi, query, func);
+    }
+
+public:
+    void clear() {
+        items.clear();
+    }
+
+    void insert(const TimeWindow& window, const T& value) {
+        Item item;
+        item.window = window;
+        item.value = value;
+        item.maxEnd = item.minEnd = window.end;
+        items.push_back(item);
+    }
+
+    /**
+     * Sorts and augments the inserted intervals; required before querying
+     */
+    void build() {
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return a.window.start < b.window.start ||
+                   (a.window.start == b.window.start && a.window.end < b.window.end);
+        });
+        augment(0, items.size());
+    }
+
+    /**
+     * Calls func(window, value) for every interval covering all of query
+     */
+    template<typename Func>
+    void forEachContaining(const TimeWindow& query, Func func) const {
+        containing(0, items.size(), query, func);
+    }
+
+    /**
+     * Calls func(window, value) for every interval lying entirely inside query
+     */
+    template<typename Func>
+    void forEachWithin(const TimeWindow& query, Func func) const {
+        within(0, items.size(), query, func);
+    }
+
+    int size() const {
+        return items.size();
+    }
+};
+
+/**
+ * Open positions for one shift at one site
+ */
+struct ShiftSlot {
+    std::string site;
+    TimeWindow window;
+    int slots;
+
+    ShiftSlot(const std::string& s = "", const TimeWindow& w = TimeWindow(), int n = 0)
+        : site(s), window(w), slots(n) {}
+};
+
+/**
+ * One volunteer placed on one shift
+ */
+struct RosterAssignment {
+    int shift;      // Index into the scheduler's shifts
+    int volunteer;  // Index into the scheduler's volunteers
+
+    RosterAssignment(int s = -1, int v = -1) : shift(s), volunteer(v) {}
+};
+
+/**
+ * ShiftScheduler - matches volunteer availability against site shifts
+ *
+ * Availability windows and shifts are kept in two interval trees, so "who can
+ * work this shift" and "which shifts fit this volunteer" are both answered in
+ * O(log n + k). buildRoster() fills every shift of the week in one pass.
+ */
+class ShiftScheduler {
+private:
+    struct Candidate {
+        Volunteer volunteer;
+        CustomArray<TimeWindow> windows;  // Sorted, merged availability
+    };
+
+    CustomArray<Candidate> volunteers;
+    CustomArray<ShiftSlot> shifts;
+    IntervalTree<int> availability;  // Window -> volunteer index
+    IntervalTree<int> shiftTree;     // Shift window -> shift index
+    CustomHashMap<std::string, int> byContact;
+
+    void collectAvailable(const TimeWindow& window, CustomArray<int>& result) const;
+
+public:
+    /**
+     * Adds a volunteer; overlapping or touching windows are merged
+     * @return Index of the volunteer
+     */
+    int addVolunteer(const Volunteer& volunteer, const CustomArray<TimeWindow>& windows);
+
+    /**
+     * Adds a shift
+     * @return Index of the shift
+     */
+    int addShift(const ShiftSlot& shift);
+
+    /**
+     * Indexes everything added so far; call before any query
+     */
+    void build();
+
+    /**
+     * Volunteers whose availability covers a time span, in registration order
+     */
+    void availableFor(const TimeWindow& window, CustomArray<int>& result) const;
+
+    /**
+     * Shifts that fit entirely inside one of a volunteer's windows, by start time
+     */
+    void shiftsFor(int volunteerIndex, CustomArray<int>& result) const;
+
+    /**
+     * Fills every shift in start order. Each slot goes to the available
+     * volunteer with the fewest minutes assigned so far (earliest registered
+     * on ties); a volunteer never works overlapping shifts or more than
+     * maxMinutesPerVolunteer in the week.
+     * @return Number of slots filled
+     */
+    int buildRoster(CustomArray<RosterAssignment>& roster, int maxMinutesPerVolunteer) const;
+
+    /**
+     * Index of the volunteer with this contact, or -1
+     */
+    int indexOf(const std::string& contact) const {
+        const int* index = byContact.find(contact);
+        return index ? *index : -1;
+    }
+
+    const Volunteer& volunteer(int index) const {
+        return volunteers[index].volunteer;
+    }
+
+    const CustomArray<TimeWindow>& windowsOf(int index) const {
+        return volunteers[index].windows;
+    }
+
+    const ShiftSlot& shift(int index) const {
+        return shifts[index];
+    }
+
+    int volunteerCount() const {
+        return volunteers.size();
+    }
+
+    int shiftCount() const {
+        return shifts.size();
+    }
+
+    int totalSlots() const;
+};
+
+/**
+ * Reads weekly availability ("Contact,Mon 08:00-16:00,Tue 09:00-17:00" per
+ * line); a later line for the same contact replaces the earlier one
+ */
+void loadAvailability(CustomHashMap<std::string, CustomArray<TimeWindow> >& availability, const std::string& filename);
+
+/**
+ * Reads shifts ("SiteName Mon 08:00-16:00 Slots" per line)
+ */
+void loadShifts(CustomArray<ShiftSlot>& shifts, const std::string& filename);
+
+/**
+ * Parses a comma-separated list of windows; returns false if any is malformed
+ */
+bool parseTimeWindowList(const std::string& text, CustomArray<TimeWindow>& windows);
+
+#endif // SHIFT_SCHEDULER_HPP
@@ -0,0 +1,99 @@
+#ifndef SIMULATOR_HPP
+#define SIMULATOR_HPP
+
+#include "VolunteerQueue.hpp"
+#include "SiteAlgorithm.hpp"
+#include "CustomLists.hpp"
+#include <string>
+
+/**
+ * Arrival stream used to generate synthetic volunteers
+ */
+enum ArrivalPattern {
+    ARRIVAL_POISSON,  // Constant-rate Poisson arrivals
+    ARRIVAL_BURSTY,   // Alternates between normal and surge rates (two-state MMPP)
+    ARRIVAL_REPLAY    // Arrival times replayed from a log file
+};
+
+/**
+ * Parameters for a what-if deployment simulation (all times in hours)
+ */
+struct SimulationConfig {
+    ArrivalPattern pattern;
+    double arrivalRate;      // Mean arrivals per hour (normal state for bursty)
+    double burstFactor;      // Arrival rate multiplier while in a surge
+    double burstFraction;    // Long-run fraction of time spent in surges
+    double meanBurstLength;  // Mean surge duration
+    double meanShiftLength;  // Mean time a deployed volunteer stays at a site
+    double duration;         // Simulated time span
+    double reportInterval;   // Time between report samples
+    unsigned seed;
+    std::string replayFile;  // Used by ARRIVAL_REPLAY
+    SitePolicyKind policy;   // Site-selection rule used for dispatch
+
+    // Constructor with defaults for a one-week Poisson run
+    SimulationConfig()
+        : pattern(ARRIVAL_POISSON), arrivalRate(10.0), burstFactor(5.0), burstFraction(0.1),
+          meanBurstLength(4.0), meanShiftLength(8.0), duration(168.0), reportInterval(12.0),
+          seed(42), replayFile(""), policy(POLICY_LOWEST_RATIO) {}
+};
+
+/**
+ * State of the simulation over one report interval
+ */
+struct SimulationSample {
+    double time;          // End of the interval
+    int queueDepth;       // Volunteers waiting at the end of the interval
+    int maxQueueDepth;    // Peak queue depth within the interval
+    double meanWait;      // Mean wait of volunteers deployed within the interval
+    double utilization;   // Time-weighted share of total site capacity in use
+    long long deployed;   // Deployments within the interval
+
+    SimulationSample()
+        : time(0), queueDepth(0), maxQueueDepth(0), meanWait(0), utilization(0), deployed(0) {}
+};
+
+/**
+ * Results of a simulation run
+ */
+struct SimulationResult {
+    CustomArray<SimulationSample> samples;
+    CustomArray<double> siteUtilization;  // Time-weighted fill ratio per site
+    long long events;
+    long long arrivals;
+    long long deployments;
+    long long departures;
+    int maxQueueDepth;
+    double meanWait;
+    double maxWait;
+    double wallSeconds;   // Real time spent in the event loop
+
+    SimulationResult()
+        : events(0), arrivals(0), deployments(0), departures(0),
+          maxQueueDepth(0), meanWait(0), maxWait(0), wallSeconds(0) {}
+};
+
+/**
+ * Runs a discrete-event simulation of arrivals, deployments and shift ends.
+ * Volunteers wait in a VolunteerQueue and are dispatched with the
+ * configured site-selection policy (by default the same rule as
+ * deployVolunteer). No console or file I/O happens
+ * inside the event loop (replay files are read before it starts).
+ * @param sites Starting site layout (copied, never modified)
+ * @param config Simulation parameters
+ */
+SimulationResult runSimulation(const CustomLinkedList<ReliefSite>& sites, const SimulationConfig& config);
+
+/**
+ * Prints the time series, per-site utilization and throughput of a run
+ */
+void printSimulationReport(const CustomLinkedList<ReliefSite>& sites, const SimulationConfig& config,
+                           const SimulationResult& result);
+
+/**
+ * Entry point for "--simulate" mode; parses options and prints the report
+ * @return Process exit code
+ */
+int runSimulationMode(int argc, char* argv[]);
+
+#endif // SIMULATOR_HPP
@@ -1,33 +1,234 @@
+#ifndef SITE_ALGORITHM_HPP
+#define SITE_ALGORITHM_HPP
+
+#include "VolunteerQueue.hpp"
 #include "CustomLists.hpp"
 #include <iomanip>
+#include <string>
+
+
+/**
+ * Site-selection policies
+ *
+ * A policy decides which of two open (non-full) sites is preferred through
+ * prefer(candidate, candidateIndex, best, bestIndex), which must be strict so
+ * the earlier site wins ties, and is told the final choice through chose().
+ * selectSite() is the single scan shared by every policy; because the policy
+ * is a template argument the comparison inlines into that loop.
+ */
+
+/**
+ * Lowest fill ratio first (the default rule, same order as SitePriorityIndex)
+ */
+struct LowestRatioPolicy {
+    bool prefer(const ReliefSite& a, int, const ReliefSite& b, int) const {
+        return (long long)a.currentCount * b.maxCapacity < (long long)b.currentCount * a.maxCapacity;
+    }
+    void chose(int) {}
+};
+
+/**
+ * Fewest volunteers on site first, regardless of capacity
+ */
+struct LowestCountPolicy {
+    bool prefer(const ReliefSite& a, int, const ReliefSite& b, int) const {
+        return a.currentCount < b.currentCount;
+    }
+    void chose(int) {}
+};
+
+/**
+ * Most free places first
+ */
+struct MostFreeSlotsPolicy {
+    bool prefer(const ReliefSite& a, int, const ReliefSite& b, int) const {
+        return a.maxCapacity - a.currentCount > b.maxCapacity - b.currentCount;
+    }
+    void chose(int) {}
+};
+
+/**
+ * Lowest weighted score: ratioWeight * fill ratio + countWeight * currentCount.
+ * The defaults rank by fill ratio and break near-ties toward smaller crews.
+ */
+struct WeightedPolicy {
+    double ratioWeight;
+    double countWeight;
+
+    WeightedPolicy(double ratio = 1.0, double count = 0.01) : ratioWeight(ratio), countWeight(count) {}
 
+    double score(const ReliefSite& site) const {
+        return ratioWeight * site.currentCount / site.maxCapacity + countWeight * site.currentCount;
+    }
+    // score(a) < score(b) with both sides scaled by the two capacities, so no division
+    bool prefer(const ReliefSite& a, int, const ReliefSite& b, int) const {
+        double capacities = (double)a.maxCapacity * b.maxCapacity;
+        double ratioTerm = (double)a.currentCount * b.maxCapacity - (double)b.currentCount * a.maxCapacity;
+        return ratioWeight * ratioTerm + countWeight * (a.currentCount - b.currentCount) * capacities < 0;
+    }
+    void chose(int) {}
+};
+
+/**
+ * Next open site after the previously chosen one, wrapping around
+ */
+struct RoundRobinPolicy {
+    int last;  // Index chosen last time, -1 before the first choice
 
-int findMostNeededSite(const CustomLinkedList<ReliefSite>& sites) {
+    RoundRobinPolicy() : last(-1) {}
+
+    bool prefer(const ReliefSite&, int a, const ReliefSite&, int b) const {
+        return a > last && b <= last;
+    }
+    void chose(int index) {
+        if (index != -1) last = index;
+    }
+};
+
+/**
+ * Pure site selection - returns the index of the open site the policy
+ * prefers (first one wins on ties), or -1 if every site is full.
+ * Works on any container of ReliefSite with begin()/end() iteration.
+ */
+template<typename Policy, typename SiteContainer>
+inline int selectSite(const SiteContainer& sites, Policy& policy) {
     int bestSiteIndex = -1;
-    double lowestPercentage = 1.1; // Start above 100%
-    
+    const ReliefSite* bestSite = nullptr;
+
+    int index = 0;
+    for (auto it = sites.begin(); it != sites.end(); ++it, ++index) {
+        if (it->currentCount < it->maxCapacity &&
+            (bestSite == nullptr || policy.prefer(*it, index, *bestSite, bestSiteIndex))) {
+            bestSite = &*it;
+            bestSiteIndex = index;
+        }
+    }
+
+    policy.chose(bestSiteIndex);
+    return bestSiteIndex;
+}
+
+/**
+ * Site with the lowest fill ratio, or -1 if every site is full
+ */
+template<typename SiteContainer>
+inline int selectMostNeededSite(const SiteContainer& sites) {
+    LowestRatioPolicy policy;
+    return selectSite(sites, policy);
+}
+
+/**
+ * Policies selectable at run time (option values and table order)
+ */
+enum SitePolicyKind {
+    POLICY_LOWEST_RATIO,
+    POLICY_LOWEST_COUNT,
+    POLICY_MOST_FREE,
+    POLICY_WEIGHTED,
+    POLICY_ROUND_ROBIN,
+    SITE_POLICY_COUNT
+};
+
+/**
+ * Option name of a policy ("lowest-ratio", "lowest-count", ...)
+ */
+inline const char* sitePolicyName(SitePolicyKind kind) {
+    static const char* const names[SITE_POLICY_COUNT] = {
+        "lowest-ratio", "lowest-count", "most-free", "weighted", "round-robin"
+    };
+    return names[kind];
+}
+
+/**
+ * Looks a policy up by option name
+ * @return false if the name is unknown
+ */
+inline bool parseSitePolicy(const std::string& name, SitePolicyKind& kind) {
+    for (int i = 0; i < SITE_POLICY_COUNT; i++) {
+        if (name == sitePolicyName((SitePolicyKind)i)) {
+            kind = (SitePolicyKind)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Policy instances for run-time selection; stateful policies (round-robin)
+ * keep their state here between calls
+ */
+struct SiteSelectionState {
+    WeightedPolicy weighted;
+    RoundRobinPolicy roundRobin;
+};
+
+template<typename SiteContainer>
+inline int selectLowestRatio(const SiteContainer& sites, SiteSelectionState&) {
+    LowestRatioPolicy policy;
+    return selectSite(sites, policy);
+}
+
+template<typename SiteContainer>
+inline int selectLowestCount(const SiteContainer& sites, SiteSelectionState&) {
+    LowestCountPolicy policy;
+    return selectSite(sites, policy);
+}
+
+template<typename SiteContainer>
+inline int selectMostFree(const SiteContainer& sites, SiteSelectionState&) {
+    MostFreeSlotsPolicy policy;
+    return selectSite(sites, policy);
+}
+
+template<typename SiteContainer>
+inline int selectWeighted(const SiteContainer& sites, SiteSelectionState& state) {
+    return selectSite(sites, state.weighted);
+}
+
+template<typename SiteContainer>
+inline int selectRoundRobin(const SiteContainer& sites, SiteSelectionState& state) {
+    return selectSite(sites, state.roundRobin);
+}
+
+/**
+ * Run-time dispatch through a table of the instantiated selectors; each entry
+ * is still a fully inlined scan, only the call itself is indirect
+ */
+template<typename SiteContainer>
+inline int selectSiteByPolicy(SitePolicyKind kind, const SiteContainer& sites, SiteSelectionState& state) {
+    typedef int (*Selector)(const SiteContainer&, SiteSelectionState&);
+    static const Selector table[SITE_POLICY_COUNT] = {
+        &selectLowestRatio<SiteContainer>,
+        &selectLowestCount<SiteContainer>,
+        &selectMostFree<SiteContainer>,
+        &selectWeighted<SiteContainer>,
+        &selectRoundRobin<SiteContainer>
+    };
+    return table[kind](sites, state);
+}
+
+/**
+ * Prints the priority analysis table, marking the chosen site as HIGHEST
+ */
+template<typename SiteContainer>
+inline void printSitePriorityAnalysis(const SiteContainer& sites, int bestSiteIndex) {
     std::cout << "\n=== SITE PRIORITY ANALYSIS ===\n";
-    std::cout << std::left << std::setw(20) << "Site Name" 
+    std::cout << std::left << std::setw(20) << "Site Name"
               << std::setw(15) << "Current/Max"
               << std::setw(12) << "% Filled"
               << std::setw(10) << "Priority" << "\n";
     std::cout << std::string(57, '-') << "\n";
-    
+
     int index = 0;
     for (auto it = sites.begin(); it != sites.end(); ++it, ++index) {
         if (it->currentCount < it->maxCapacity) {
             double percentage = (double)it->currentCount / it->maxCapacity;
-            std::string priority = (percentage < lowestPercentage) ? "HIGHEST" : "Lower";
-            
+            std::string priority = (index == bestSiteIndex) ? "HIGHEST" : "Lower";
+
             std::cout << std::left << std::setw(20) << it->name
                       << std::setw(15) << (std::to_string(it->currentCount) + "/" + std::to_string(it->maxCapacity))
                       << std::setw(12) << (std::to_string((int)(percentage * 100)) + "%")
                       << std::setw(10) << priority << "\n";
-            
-            if (percentage < lowestPercentage) {
-                lowestPercentage = percentage;
-                bestSiteIndex = index;
-            }
         } else {
             std::cout << std::left << std::setw(20) << it->name
                       << std::setw(15) << (std::to_string(it->currentCount) + "/" + std::to_string(it->maxCapacity))
@@ -36,6 +237,163 @@ int findMostNeededSite(const CustomLinkedList<ReliefSite>& sites) {
         }
     }
     std::cout << std::string(57, '-') << "\n\n";
-    
+}
+
+/**
+ * Selects the most needed site and prints the priority analysis table
+ */
+template<typename SiteContainer>
+inline int findMostNeededSite(const SiteContainer& sites) {
+    int bestSiteIndex = selectMostNeededSite(sites);
+    printSitePriorityAnalysis(sites, bestSiteIndex);
     return bestSiteIndex;
-}
\ No newline at end of file
+}
+
+/**
+ * SitePriorityIndex - resident site table with an indexed min-heap of non-full
+ * sites ordered by fill ratio (then table position), so best() picks the same
+ * site as selectMostNeededSite in O(1) and each count change costs O(log S)
+ * instead of a rescan.
+ */
+class SitePriorityIndex {
+private:
+    CustomArray<ReliefSite> sites;
+    CustomArray<int> heap;       // Site indexes of non-full sites
+    CustomArray<int> position;   // Heap slot of each site, -1 when full
+    CustomHashMap<std::string, int> byName;
+
+    // Compares fill ratios exactly by cross-multiplying
+    bool higherPriority(int a, int b) const {
+        long long lhs = (long long)sites[a].currentCount * sites[b].maxCapacity;
+        long long rhs = (long long)sites[b].currentCount * sites[a].maxCapacity;
+        return lhs < rhs || (lhs == rhs && a < b);
+    }
+
+    bool isOpen(int index) const {
+        return sites[index].currentCount < sites[index].maxCapacity;
+    }
+
+    void swapSlots(int i, int j) {
+        int temp = heap[i];
+        heap[i] = heap[j];
+        heap[j] = temp;
+        position[heap[i]] = i;
+        position[heap[j]] = j;
+    }
+
+    void siftUp(int slot) {
+        while (slot > 0) {
+            int parent = (slot - 1) / 2;
+            if (!higherPriority(heap[slot], heap[parent])) break;
+            swapSlots(slot, parent);
+            slot = parent;
+        }
+    }
+
+    void siftDown(int slot) {
+        int n = heap.size();
+        for (;;) {
+            int best = slot;
+            int left = 2 * slot + 1;
+            int right = left + 1;
+            if (left < n && higherPriority(heap[left], heap[best])) best = left;
+            if (right < n && higherPriority(heap[right], heap[best])) best = right;
+            if (best == slot) break;
+            swapSlots(slot, best);
+            slot = best;
+        }
+    }
+
+    void removeSlot(int slot) {
+        int last = heap.size() - 1;
+        position[heap[slot]] = -1;
+        if (slot != last) {
+            heap[slot] = heap[last];
+            position[heap[slot]] = slot;
+        }
+        heap.pop_back();
+        if (slot < heap.size()) {
+            siftDown(slot);
+            siftUp(slot);
+        }
+    }
+
+public:
+    /**
+     * Replaces the table contents with the given sites
+     */
+    template<typename SiteContainer>
+    void load(const SiteContainer& source) {
+        sites.clear();
+        heap.clear();
+        position.clear();
+        byName.clear();
+
+        for (auto it = source.begin(); it != source.end(); ++it) {
+            byName.insert(it->name, sites.size());
+            position.push_back(-1);
+            sites.push_back(*it);
+        }
+        for (int i = 0; i < sites.size(); i++) {
+            if (isOpen(i)) {
+                position[i] = heap.size();
+                heap.push_back(i);
+                siftUp(heap.size() - 1);
+            }
+        }
+    }
+
+    /**
+     * Index of the most needed non-full site, or -1 if every site is full
+     */
+    int best() const {
+        return heap.empty() ? -1 : heap[0];
+    }
+
+    /**
+     * Index of the site with the given name, or -1 if unknown
+     */
+    int indexOf(const std::string& name) const {
+        const int* index = byName.find(name);
+        return index ? *index : -1;
+    }
+
+    /**
+     * Changes a site's currentCount and repositions it in O(log S)
+     */
+    void adjustCount(int index, int delta) {
+        sites[index].currentCount += delta;
+
+        int slot = position[index];
+        if (slot == -1) {
+            if (isOpen(index)) {
+                position[index] = heap.size();
+                heap.push_back(index);
+                siftUp(heap.size() - 1);
+            }
+        } else if (!isOpen(index)) {
+            removeSlot(slot);
+        } else {
+            siftUp(slot);
+            siftDown(position[index]);
+        }
+    }
+
+    const ReliefSite& site(int index) const {
+        return sites[index];
+    }
+
+    const CustomArray<ReliefSite>& all() const {
+        return sites;
+    }
+
+    int size() const {
+        return sites.size();
+    }
+
+    bool empty() const {
+        return sites.empty();
+    }
+};
+
+#endif // SITE_ALGORITHM_HPP
@@ -0,0 +1,108 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <memory>
+#include <string>
+
+class RegionRegistry;
+
+/**
+ * Immutable point-in-time copy of the pending queue, in dispatch order
+ */
+struct QueueView {
+    long long version;                 // Queue version this view was taken at
+    QueueLaneRules::DispatchMode mode;
+    CustomArray<Volunteer> volunteers;
+    CustomArray<int> lanes;            // Priority lane of each volunteer
+
+    QueueView() : version(-1), mode(QueueLaneRules::FIFO_DISPATCH) {}
+
+    /**
+     * Copies the queue's current contents in dispatch order (either backend)
+     */
+    template<typename Queue>
+    void capture(const Queue& queue) {
+        version = queue.getVersion();
+        mode = queue.dispatchMode();
+        volunteers.clear();
+        lanes.clear();
+        volunteers.reserve(queue.size());
+        lanes.reserve(queue.size());
+
+        queue.forEachInDispatchOrder([this](const Volunteer& v, int lane) {
+            volunteers.push_back(v);
+            lanes.push_back(lane);
+        });
+    }
+
+    /**
+     * Prints the volunteer table (same layout as VolunteerQueue::displayAll)
+     */
+    void display() const;
+};
+
+/**
+ * Immutable point-in-time copy of every relief site
+ */
+struct SiteView {
+    long long version;                 // Registry version this view was taken at
+    CustomArray<ReliefSite> sites;
+    CustomArray<std::string> regions;  // Region of each site
+
+    SiteView() : version(-1) {}
+
+    /**
+     * Copies every shard's sites
+     */
+    void capture(const RegionRegistry& registry);
+};
+
+/**
+ * SnapshotStore - versioned read views of the queue and site table
+ *
+ * The queue and registry bump a version on every change, which is the only
+ * cost on the deploy path. publish*() runs on the thread that owns the live
+ * structures, between operations, and copies a structure only when it changed
+ * since the last published view. Readers take the latest view with an atomic
+ * shared_ptr load and keep it as long as they like: a view is never modified,
+ * and a newer publish just swaps the pointer, so a long report never holds up
+ * deployments and deployments never change a report halfway through.
+ */
+class SnapshotStore {
+private:
+    std::shared_ptr<const QueueView> queueSnapshot;
+    std::shared_ptr<const SiteView> siteSnapshot;
+
+    // Disable copying
+    SnapshotStore(const SnapshotStore&);
+    SnapshotStore& operator=(const SnapshotStore&);
+
+public:
+    SnapshotStore();
+
+    /**
+     * Publishes a new queue view if the queue changed (owner thread only)
+     * @return true if a new view was published
+     */
+    bool publishQueue(const VolunteerQueue& queue);
+
+    /**
+     * Publishes a new site view if any site count changed (owner thread only)
+     * @return true if a new view was published
+     */
+    bool publishSites(const RegionRegistry& registry);
+
+    /**
+     * Latest published queue view; safe to call from any thread
+     */
+    std::shared_ptr<const QueueView> queueView() const;
+
+    /**
+     * Latest published site view; safe to call from any thread
+     */
+    std::shared_ptr<const SiteView> siteView() const;
+};
+
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,155 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include "CustomLists.hpp"
+
+/**
+ * Position of a site inside the registry (shard, index within shard)
+ */
+struct SiteLocation {
+    int shard;
+    int index;
+
+    // Constructor - defaults to "no site"
+    SiteLocation(int s = -1, int i = -1) : shard(s), index(i) {}
+
+    bool valid() const {
+        return shard >= 0 && index >= 0;
+    }
+};
+
+/**
+ * SiteSpatialIndex - 2-d tree over site coordinates
+ *
+ * Coordinates are projected onto a flat plane in kilometres around the mean
+ * latitude of the indexed sites (accurate for regional distances). Every node
+ * tracks how many non-full sites its subtree holds, so full subtrees are pruned
+ * from the search and a capacity change updates one root path in O(log S).
+ */
+class SiteSpatialIndex {
+private:
+    struct KdNode {
+        double x, y;                      // Projected position (km)
+        double minX, maxX, minY, maxY;    // Bounding box of the subtree
+        SiteLocation location;
+        int left, right, parent;
+        int axis;                         // 0 splits on x, 1 on y
+        int openCount;                    // Non-full sites in the subtree
+        bool open;
+
+        KdNode() : x(0), y(0), minX(0), maxX(0), minY(0), maxY(0),
+                   left(-1), right(-1), parent(-1), axis(0), openCount(0), open(false) {}
+    };
+
+    CustomArray<KdNode> nodes;
+    CustomHashMap<long long, int> nodeOf;  // (shard << 32 | index) -> node
+    int root;
+    double kmPerDegreeLon;
+
+    static long long key(const SiteLocation& location) {
+        return ((long long)location.shard << 32) | (unsigned int)location.index;
+    }
+
+    int build(int* order, int count, int depth, int parent);
+
+    double boxDistance2(const KdNode& node, double qx, double qy) const {
+        double dx = qx < node.minX ? node.minX - qx : (qx > node.maxX ? qx - node.maxX : 0);
+        double dy = qy < node.minY ? node.minY - qy : (qy > node.maxY ? qy - node.maxY : 0);
+        return dx * dx + dy * dy;
+    }
+
+    template<typename Accept, typename Rank>
+    void search(int index, double qx, double qy, double& bestDist2, SiteLocation& best, Accept& accept,
+                Rank& better) const {
+        if (index == -1) return;
+        const KdNode& node = nodes[index];
+        if (node.openCount == 0 || boxDistance2(node, qx, qy) > bestDist2) return;
+
+        if (node.open && accept(node.location)) {
+            double dx = node.x - qx;
+            double dy = node.y - qy;
+            double dist2 = dx * dx + dy * dy;
+            // Equally distant sites are tie-broken by the caller's ranking (fill ratio)
+            if (dist2 < bestDist2 || (dist2 == bestDist2 && (!best.valid() || better(node.location, best)))) {
+                bestDist2 = dist2;
+                best = node.location;
+            }
+        }
+
+        double diff = node.axis == 0 ? qx - node.x : qy - node.y;
+        int nearer = diff < 0 ? node.left : node.right;
+        int farther = diff < 0 ? node.right : node.left;
+        search(nearer, qx, qy, bestDist2, best, accept, better);
+        search(farther, qx, qy, bestDist2, best, accept, better);
+    }
+
+public:
+    /**
+     * One site to index
+     */
+    struct Entry {
+        double latitude;
+        double longitude;
+        SiteLocation location;
+        bool open;
+
+        Entry(double lat = 0, double lon = 0, const SiteLocation& loc = SiteLocation(), bool o = false)
+            : latitude(lat), longitude(lon), location(loc), open(o) {}
+    };
+
+    SiteSpatialIndex() : root(-1), kmPerDegreeLon(111.32) {}
+
+    /**
+     * Rebuilds the tree (balanced, median splits) from the given sites
+     */
+    void build(const CustomArray<Entry>& entries);
+
+    /**
+     * Marks a site as having room or being full, updating subtree counts
+     */
+    void setOpen(const SiteLocation& location, bool open);
+
+    /**
+     * Nearest non-full site within radiusKm of a point
+     * @param better Callable better(a, b) ranking equally distant sites
+     * @return Invalid location if no open site is within the radius
+     */
+    template<typename Rank>
+    SiteLocation nearestOpen(double latitude, double longitude, double radiusKm, Rank better) const {
+        auto any = [](const SiteLocation&) {
+            return true;
+        };
+        return nearestOpenWhere(latitude, longitude, radiusKm, any, better);
+    }
+
+    /**
+     * Nearest open site within radiusKm that accept(location) also admits;
+     * for callers tracking fullness outside the index (the open flags are
+     * only read, so concurrent searches are safe while nothing calls setOpen)
+     */
+    template<typename Accept, typename Rank>
+    SiteLocation nearestOpenWhere(double latitude, double longitude, double radiusKm, Accept accept,
+                                  Rank better) const {
+        SiteLocation best;
+        double bestDist2 = radiusKm * radiusKm;
+        search(root, longitude * kmPerDegreeLon, latitude * KM_PER_DEGREE_LAT, bestDist2, best, accept, better);
+        return best;
+    }
+
+    /**
+     * Approximate distance in km between two coordinates in this index's projection
+     */
+    double distanceKm(double lat1, double lon1, double lat2, double lon2) const;
+
+    int size() const {
+        return nodes.size();
+    }
+
+    bool empty() const {
+        return nodes.empty();
+    }
+
+    static constexpr double KM_PER_DEGREE_LAT = 110.574;
+};
+
+#endif // SPATIAL_INDEX_HPP
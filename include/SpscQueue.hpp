@@ -0,0 +1,108 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <thread>
+
+/**
+ * SpscQueue - bounded single-producer / single-consumer ring connecting two
+ * pipeline stages
+ *
+ * The producer owns tail and the consumer owns head; each keeps a cached copy
+ * of the other's index and only reloads it when the ring looks full or empty,
+ * so the two threads touch a shared cache line about once per lap rather than
+ * once per item. A full ring makes push wait and an empty one makes pop wait
+ * (spinning briefly, then yielding). The producer calls close() after its
+ * last item; pop then drains what is left and returns false.
+ */
+template<typename T>
+class SpscQueue {
+private:
+    static const unsigned SPINS_BEFORE_YIELD = 64;
+
+    T* slots;
+    unsigned mask;  // Capacity - 1 (capacity is a power of two)
+
+    alignas(64) std::atomic<unsigned> head;  // Next slot to pop
+    unsigned cachedTail;                     // Consumer's last view of tail
+    alignas(64) std::atomic<unsigned> tail;  // Next slot to push
+    unsigned cachedHead;                     // Producer's last view of head
+    alignas(64) std::atomic<bool> closed;
+
+    // Disable copying
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+
+    static void backOff(unsigned& spins) {
+        if (++spins >= SPINS_BEFORE_YIELD) {
+            std::this_thread::yield();
+        }
+    }
+
+public:
+    /**
+     * Constructor - capacity is rounded up to a power of two
+     */
+    explicit SpscQueue(unsigned capacity)
+        : slots(nullptr), mask(0), head(0), cachedTail(0), tail(0), cachedHead(0), closed(false) {
+        unsigned size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots = new T[size];
+        mask = size - 1;
+    }
+
+    ~SpscQueue() {
+        delete[] slots;
+    }
+
+    /**
+     * Adds an item, waiting while the ring is full (producer only)
+     */
+    void push(const T& item) {
+        unsigned position = tail.load(std::memory_order_relaxed);
+        unsigned spins = 0;
+        while (position - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead > mask) {
+                backOff(spins);
+            }
+        }
+        slots[position & mask] = item;
+        tail.store(position + 1, std::memory_order_release);
+    }
+
+    /**
+     * Marks the end of the stream (producer only, after its last push)
+     */
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Takes the oldest item, waiting while the ring is empty (consumer only)
+     * @return false once the producer has closed and every item was taken
+     */
+    bool pop(T& item) {
+        unsigned position = head.load(std::memory_order_relaxed);
+        unsigned spins = 0;
+        while (position == cachedTail) {
+            // Read closed before tail: a close seen here means every push is visible
+            bool finished = closed.load(std::memory_order_acquire);
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position != cachedTail) {
+                break;
+            }
+            if (finished) {
+                return false;
+            }
+            backOff(spins);
+        }
+        item = slots[position & mask];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,39 @@
+#ifndef STARTUP_LOADER_HPP
+#define STARTUP_LOADER_HPP
+
+#include "VolunteerQueue.hpp"
+#include "HistoryArchive.hpp"
+#include <string>
+
+/**
+ * Counts from one pass of the registration loading pipeline
+ */
+struct RegistrationLoadResult {
+    long long offset;     // Registration log bytes read (startOffset + everything after it)
+    int loaded;
+    int skipped;          // Already deployed, so not queued
+    bool archiveCorrupt;  // Archived registrations after a corrupt block were skipped
+
+    RegistrationLoadResult() : offset(0), loaded(0), skipped(0), archiveCorrupt(false) {}
+};
+
+/**
+ * Loads the registration history into a queue through a staged pipeline:
+ *
+ *   reader -> parser -> deployed filter -> enqueue
+ *
+ * The reader (archive blocks, then the text log from startOffset in large
+ * chunks), the parser (trim and parse) and the filter run on their own
+ * threads and hand batches of records down bounded SPSC queues; the filter
+ * counts active deployments from the deployed and released logs before its
+ * first batch, while the reader and parser get ahead. The enqueue stage runs
+ * on the calling thread, so volunteers reach the queue, and skipped ones are
+ * reported, in exact log order.
+ *
+ * @param archive Open archive to read first, or nullptr
+ */
+RegistrationLoadResult loadRegistrationsPipelined(VolunteerQueue& queue, HistoryArchive* archive,
+                                                  const std::string& registrationFile, long long startOffset,
+                                                  const std::string& deployedFile, const std::string& releasedFile);
+
+#endif // STARTUP_LOADER_HPP
@@ -1,6 +1,7 @@
 #ifndef VOLUNTEER_QUEUE_HPP
 #define VOLUNTEER_QUEUE_HPP
 
+#include "CustomLists.hpp"
 #include <string>
 
 /**
@@ -10,21 +11,34 @@ struct Volunteer {
     std::string name;
     std::string contact;
     std::string skill;
+    bool hasLocation;     // Optional home location (decimal degrees)
+    double latitude;
+    double longitude;
     
     // Constructor for easy initialization
     Volunteer(const std::string& n = "", const std::string& c = "", const std::string& s = "")
-        : name(n), contact(c), skill(s) {}
+        : name(n), contact(c), skill(s), hasLocation(false), latitude(0), longitude(0) {}
+    
+    void setLocation(double lat, double lon) {
+        hasLocation = true;
+        latitude = lat;
+        longitude = lon;
+    }
 };
 
 /**
- * Node struct for singly-linked list implementation
+ * Node struct for the queue's linked lists
  */
 struct Node {
     Volunteer data;
-    Node* next;
+    Node* next;      // Next in arrival order
+    Node* prev;      // Previous in arrival order
+    Node* laneNext;  // Next in the same priority lane
+    int lane;
     
     // Constructor
-    Node(const Volunteer& volunteer) : data(volunteer), next(nullptr) {}
+    Node(const Volunteer& volunteer, int l = 0)
+        : data(volunteer), next(nullptr), prev(nullptr), laneNext(nullptr), lane(l) {}
 };
 
 /**
@@ -34,31 +48,140 @@ struct ReliefSite {
     std::string name;
     int currentCount;
     int maxCapacity;
+    bool hasLocation;     // Optional coordinates (decimal degrees)
+    double latitude;
+    double longitude;
     
     // Constructor
     ReliefSite(const std::string& n = "", int current = 0, int max = 0)
-        : name(n), currentCount(current), maxCapacity(max) {}
+        : name(n), currentCount(current), maxCapacity(max), hasLocation(false), latitude(0), longitude(0) {}
+    
+    void setLocation(double lat, double lon) {
+        hasLocation = true;
+        latitude = lat;
+        longitude = lon;
+    }
+};
+
+class VolunteerSpill;
+
+/**
+ * Dispatch modes and the skill/contact lane rules shared by both queue backends
+ */
+class QueueLaneRules {
+public:
+    static const int PRIORITY_LEVELS = 8;  // Lanes 0 (normal) to 7 (most urgent)
+    
+    enum DispatchMode {
+        FIFO_DISPATCH,
+        PRIORITY_DISPATCH
+    };
+    
+protected:
+    CustomHashMap<std::string, int> skillPriority;
+    CustomHashMap<std::string, int> contactPriority;
+    
+public:
+    /**
+     * Lane rules applied when volunteers are enqueued; a volunteer gets the
+     * highest lane matching their skill or contact
+     */
+    void setSkillPriority(const std::string& skill, int level);
+    void setContactPriority(const std::string& contact, int level);
+    
+    /**
+     * Lane a volunteer would be placed in
+     */
+    int priorityOf(const Volunteer& v) const;
 };
 
 /**
- * VolunteerQueue class - FIFO queue implementation using singly-linked list
+ * LinkedVolunteerQueue class - FIFO queue implementation using linked lists
  * No STL containers used for the core queue functionality
+ *
+ * Every volunteer is linked both in arrival order and into one of
+ * PRIORITY_LEVELS FIFO lanes (chosen from skill/contact rules at enqueue).
+ * FIFO dispatch takes the oldest volunteer; priority dispatch takes the head
+ * of the highest non-empty lane, found in O(1) from a lane bitmap. With aging
+ * enabled, after a number of dispatches in a row that skip the longest-waiting
+ * volunteer, that volunteer is served next so lower lanes cannot starve.
+ *
+ * With a memory budget, only the oldest volunteers that fit in half the
+ * budget are kept as nodes; later arrivals go to a VolunteerSpill, whose
+ * middle lives in segment files, and move up into the resident window in
+ * arrival order as dispatches make room. Priority dispatch then chooses
+ * among the resident window.
  */
-class VolunteerQueue {
+class LinkedVolunteerQueue : public QueueLaneRules {
 private:
     Node* head;  // Points to the front of the queue (first to be dequeued)
     Node* tail;  // Points to the rear of the queue (last enqueued)
+    Node* laneHead[PRIORITY_LEVELS];
+    Node* laneTail[PRIORITY_LEVELS];
+    unsigned int laneMask;  // Bit i set when lane i is non-empty
+    int count;
+    long long version;  // Bumped on every change, so read views know when they are stale
+    
+    DispatchMode mode;
+    int agingThreshold;  // 0 disables aging
+    int bypassCount;     // Dispatches in a row that skipped the oldest volunteer
+    
+    CustomHashMap<std::string, int> queuedPerSkill;  // Resident and spilled, kept on every change
+    
+    long long memoryBudget;    // 0 keeps every volunteer in memory
+    long long residentBytes;   // Estimated footprint of the node window
+    std::string spillDirectory;
+    VolunteerSpill* spill;     // Arrivals beyond the resident window, oldest first
+    
+    // Disable copying
+    LinkedVolunteerQueue(const LinkedVolunteerQueue&);
+    LinkedVolunteerQueue& operator=(const LinkedVolunteerQueue&);
+    
+    /**
+     * Node the next dequeue will remove (queue must not be empty)
+     */
+    Node* nextToDispatch() const;
+    
+    /**
+     * Links a volunteer in as a resident node at the rear
+     */
+    void linkNode(const Volunteer& v, int lane);
+    
+    /**
+     * Moves spilled volunteers into the resident window while it has room
+     */
+    void admitSpilled();
+    
+    /**
+     * One part of the spilled volunteers, front part first (see VolunteerSpill::readPart)
+     */
+    bool readSpilledPart(int part, CustomArray<Volunteer>& out) const;
+    
+    /**
+     * Takes a volunteer off the per-skill counts
+     */
+    void forgetQueued(const Volunteer& v);
+    
+    /**
+     * removeIf steps: unlink a node from arrival order and free it (lanes are
+     * relinked by the caller), pass spilled volunteers through once, then
+     * close the relinked lanes and refill the resident window
+     */
+    void unlinkForRemoval(Node* node);
+    bool popSpilled(Volunteer& v);
+    void pushSpilled(const Volunteer& v);
+    void finishRemoval(Node* const* laneLast, int removed);
     
 public:
     /**
      * Constructor - initializes empty queue
      */
-    VolunteerQueue();
+    LinkedVolunteerQueue();
     
     /**
      * Destructor - cleans up all allocated memory
      */
-    ~VolunteerQueue();
+    ~LinkedVolunteerQueue();
     
     /**
      * Adds a volunteer to the rear of the queue
@@ -66,6 +189,35 @@ public:
      */
     void enqueue(const Volunteer& v);
     
+    /**
+     * Moves every volunteer of batch to the rear of this queue, keeping their
+     * order and lanes, in O(PRIORITY_LEVELS) regardless of batch size; batch
+     * is left empty. Lanes were chosen by batch's rules, so build batches
+     * after copyLaneRulesFrom(this queue).
+     */
+    void enqueueBulk(LinkedVolunteerQueue& batch);
+    
+    /**
+     * Uses the same skill/contact lane rules and memory budget as another queue
+     */
+    void copyLaneRulesFrom(const LinkedVolunteerQueue& other);
+    
+    /**
+     * Bounds the memory used by queued volunteers; arrivals beyond half the
+     * budget are spilled to segment files in directory (0 disables spilling
+     * and brings every volunteer back into memory)
+     */
+    void setMemoryBudget(long long bytes, const std::string& directory);
+    
+    long long getMemoryBudget() const {
+        return memoryBudget;
+    }
+    
+    /**
+     * Number of volunteers currently spilled out of the resident window
+     */
+    long long spilledCount() const;
+    
     /**
      * Removes and returns the volunteer at the front of the queue
      * @return The volunteer at the front
@@ -89,7 +241,400 @@ public:
      * @return The size of the queue
      */
     int size() const;
+    
+    /**
+     * Returns the volunteer the next dequeue will remove, without removing it
+     * @throws std::runtime_error if queue is empty
+     */
+    const Volunteer& front() const;
+    
+    /**
+     * Chooses strict FIFO or priority-lane dispatch; takes effect on the next
+     * dequeue and works on volunteers already queued
+     */
+    void setDispatchMode(DispatchMode newMode);
+    
+    DispatchMode dispatchMode() const {
+        return mode;
+    }
+    
+    /**
+     * Enables aging: after this many priority dispatches in a row that skip the
+     * longest-waiting volunteer, that volunteer goes next (0 disables)
+     */
+    void setAgingThreshold(int threshold);
+    
+    int getAgingThreshold() const {
+        return agingThreshold;
+    }
+    
+    /**
+     * Number of resident volunteers waiting in one lane
+     */
+    int laneSize(int lane) const;
+    
+    /**
+     * Number of queued volunteers (resident or spilled) with a skill, in O(1)
+     */
+    int countWithSkill(const std::string& skill) const;
+    
+    /**
+     * Visits the queued count of every skill present, without walking the queue
+     * @param visit Callable invoked as visit(const std::string& skill, int count)
+     */
+    template<typename Func>
+    void forEachSkillCount(Func visit) const {
+        queuedPerSkill.forEach(visit);
+    }
+    
+    /**
+     * Visits every volunteer from front to rear without modifying the queue
+     * @param visit Callable invoked as visit(const Volunteer&)
+     */
+    template<typename Func>
+    void forEach(Func visit) const {
+        for (Node* current = head; current != nullptr; current = current->next) {
+            visit(current->data);
+        }
+        CustomArray<Volunteer> part;
+        for (int p = 0; readSpilledPart(p, part); p++) {
+            for (int i = 0; i < part.size(); i++) {
+                visit(part[i]);
+            }
+        }
+    }
+    
+    /**
+     * Visits every volunteer in the order the current dispatch mode serves them
+     * (ignoring aging): arrival order, or highest lane first; spilled
+     * volunteers follow the resident window in arrival order
+     * @param visit Callable invoked as visit(const Volunteer&, int lane)
+     */
+    template<typename Func>
+    void forEachInDispatchOrder(Func visit) const {
+        if (mode == FIFO_DISPATCH) {
+            for (Node* current = head; current != nullptr; current = current->next) {
+                visit(current->data, current->lane);
+            }
+        } else {
+            for (int lane = PRIORITY_LEVELS - 1; lane >= 0; lane--) {
+                for (Node* current = laneHead[lane]; current != nullptr; current = current->laneNext) {
+                    visit(current->data, lane);
+                }
+            }
+        }
+        CustomArray<Volunteer> part;
+        for (int p = 0; readSpilledPart(p, part); p++) {
+            for (int i = 0; i < part.size(); i++) {
+                visit(part[i], priorityOf(part[i]));
+            }
+        }
+    }
+    
+    /**
+     * Removes every volunteer (resident or spilled) for whom
+     * shouldRemove(const Volunteer&) is true, in one pass and without copying
+     * the queue; everyone else keeps their place in arrival order and in their
+     * lane. Each node is unlinked in O(1) and the lanes are relinked from the
+     * survivors; spilled volunteers stream through the spill once.
+     * @return Number of volunteers removed
+     */
+    template<typename Predicate>
+    int removeIf(Predicate shouldRemove) {
+        Node* laneLast[PRIORITY_LEVELS];
+        for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+            laneHead[lane] = laneLast[lane] = nullptr;
+        }
+        
+        int removed = 0;
+        Node* current = head;
+        while (current != nullptr) {
+            Node* next = current->next;
+            if (shouldRemove(static_cast<const Volunteer&>(current->data))) {
+                unlinkForRemoval(current);
+                removed++;
+            } else {
+                // Arrival order within a lane is lane order
+                int lane = current->lane;
+                if (laneLast[lane] == nullptr) {
+                    laneHead[lane] = current;
+                } else {
+                    laneLast[lane]->laneNext = current;
+                }
+                laneLast[lane] = current;
+            }
+            current = next;
+        }
+        
+        long long spilled = spilledCount();
+        Volunteer v;
+        for (long long i = 0; i < spilled && popSpilled(v); i++) {
+            if (shouldRemove(static_cast<const Volunteer&>(v))) {
+                forgetQueued(v);
+                removed++;
+            } else {
+                pushSpilled(v);
+            }
+        }
+        
+        finishRemoval(laneLast, removed);
+        return removed;
+    }
+    
+    /**
+     * Change counter; differs whenever contents or dispatch order differ
+     */
+    long long getVersion() const {
+        return version;
+    }
+};
+
+/**
+ * RingVolunteerQueue class - the same queue kept in contiguous storage
+ *
+ * Each priority lane is a CustomRing of volunteers stamped with an arrival
+ * sequence number, so enqueue and dequeue are amortized O(1) with no node per
+ * volunteer, and walking a lane is a linear scan. The oldest volunteer is the
+ * lane front with the lowest sequence number (at most PRIORITY_LEVELS
+ * compares); arrival order walks merge the lane rings by sequence number,
+ * which with no lane rules is a single scan of lane 0.
+ *
+ * Behaves like LinkedVolunteerQueue (dispatch modes, aging, memory budget
+ * and spilling) with the same public API. Entries are smaller than linked
+ * nodes, so under a memory budget the resident window holds a few more
+ * volunteers, and priority dispatch chooses among them. The one difference
+ * in cost: enqueueBulk moves each volunteer instead of relinking whole chains.
+ */
+class RingVolunteerQueue : public QueueLaneRules {
+private:
+    struct Entry {
+        Volunteer data;
+        long long sequence;  // Arrival order across lanes
+        
+        Entry(const Volunteer& v, long long s) : data(v), sequence(s) {}
+    };
+    
+    CustomRing<Entry> lanes[PRIORITY_LEVELS];
+    unsigned int laneMask;  // Bit i set when lane i is non-empty
+    int count;
+    long long nextSequence;
+    long long version;
+    
+    DispatchMode mode;
+    int agingThreshold;
+    int bypassCount;
+    
+    CustomHashMap<std::string, int> queuedPerSkill;
+    
+    long long memoryBudget;
+    long long residentBytes;
+    std::string spillDirectory;
+    VolunteerSpill* spill;
+    
+    // Disable copying
+    RingVolunteerQueue(const RingVolunteerQueue&);
+    RingVolunteerQueue& operator=(const RingVolunteerQueue&);
+    
+    /**
+     * Lane holding the longest-waiting resident volunteer (queue must not be empty)
+     */
+    int oldestLane() const;
+    
+    /**
+     * Lane the next dequeue takes from (queue must not be empty)
+     */
+    int laneToDispatch() const;
+    
+    void pushResident(const Volunteer& v, int lane);
+    void admitSpilled();
+    bool readSpilledPart(int part, CustomArray<Volunteer>& out) const;
+    
+    /**
+     * removeIf steps (as in LinkedVolunteerQueue)
+     */
+    void forgetQueued(const Volunteer& v);
+    void forgetResident(const Entry& entry);
+    bool popSpilled(Volunteer& v);
+    void pushSpilled(const Volunteer& v);
+    void finishRemoval(int removed);
+    
+    /**
+     * Visits resident volunteers in arrival order as visit(const Volunteer&, int lane)
+     */
+    template<typename Func>
+    void forEachResident(Func visit) const {
+        if ((laneMask & (laneMask - 1)) == 0) {
+            // One lane (or none): its ring already is arrival order
+            for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+                for (int i = 0; i < lanes[lane].size(); i++) {
+                    visit(lanes[lane][i].data, lane);
+                }
+            }
+            return;
+        }
+        int position[PRIORITY_LEVELS] = {0};
+        for (int remaining = count; remaining > 0; remaining--) {
+            int best = -1;
+            for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+                if (position[lane] < lanes[lane].size() &&
+                    (best < 0 || lanes[lane][position[lane]].sequence < lanes[best][position[best]].sequence)) {
+                    best = lane;
+                }
+            }
+            visit(lanes[best][position[best]++].data, best);
+        }
+    }
+    
+public:
+    /**
+     * Constructor - initializes empty queue
+     */
+    RingVolunteerQueue();
+    
+    /**
+     * Destructor - frees the spill (the rings free themselves)
+     */
+    ~RingVolunteerQueue();
+    
+    void enqueue(const Volunteer& v);
+    
+    /**
+     * Moves every volunteer of batch to the rear of this queue, keeping their
+     * order and lanes (O(batch size)); batch is left empty
+     */
+    void enqueueBulk(RingVolunteerQueue& batch);
+    
+    void copyLaneRulesFrom(const RingVolunteerQueue& other);
+    void setMemoryBudget(long long bytes, const std::string& directory);
+    
+    long long getMemoryBudget() const {
+        return memoryBudget;
+    }
+    
+    long long spilledCount() const;
+    
+    /**
+     * Removes and returns the volunteer the dispatch mode serves next
+     * @throws std::runtime_error if queue is empty
+     */
+    Volunteer dequeue();
+    
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    void displayAll() const;
+    int size() const;
+    
+    /**
+     * @throws std::runtime_error if queue is empty
+     */
+    const Volunteer& front() const;
+    
+    void setDispatchMode(DispatchMode newMode);
+    
+    DispatchMode dispatchMode() const {
+        return mode;
+    }
+    
+    void setAgingThreshold(int threshold);
+    
+    int getAgingThreshold() const {
+        return agingThreshold;
+    }
+    
+    /**
+     * Number of resident volunteers waiting in one lane, in O(1)
+     */
+    int laneSize(int lane) const {
+        return lanes[lane].size();
+    }
+    
+    int countWithSkill(const std::string& skill) const;
+    
+    template<typename Func>
+    void forEachSkillCount(Func visit) const {
+        queuedPerSkill.forEach(visit);
+    }
+    
+    template<typename Func>
+    void forEach(Func visit) const {
+        forEachResident([&visit](const Volunteer& v, int) {
+            visit(v);
+        });
+        CustomArray<Volunteer> part;
+        for (int p = 0; readSpilledPart(p, part); p++) {
+            for (int i = 0; i < part.size(); i++) {
+                visit(part[i]);
+            }
+        }
+    }
+    
+    template<typename Func>
+    void forEachInDispatchOrder(Func visit) const {
+        if (mode == FIFO_DISPATCH) {
+            forEachResident(visit);
+        } else {
+            for (int lane = PRIORITY_LEVELS - 1; lane >= 0; lane--) {
+                for (int i = 0; i < lanes[lane].size(); i++) {
+                    visit(lanes[lane][i].data, lane);
+                }
+            }
+        }
+        CustomArray<Volunteer> part;
+        for (int p = 0; readSpilledPart(p, part); p++) {
+            for (int i = 0; i < part.size(); i++) {
+                visit(part[i], priorityOf(part[i]));
+            }
+        }
+    }
+    
+    /**
+     * Removes every volunteer for whom shouldRemove(const Volunteer&) is true,
+     * keeping everyone else's order; each lane ring is compacted in place
+     * @return Number of volunteers removed
+     */
+    template<typename Predicate>
+    int removeIf(Predicate shouldRemove) {
+        int removed = 0;
+        for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+            removed += lanes[lane].remove_if([this, &shouldRemove](const Entry& entry) {
+                if (!shouldRemove(entry.data)) {
+                    return false;
+                }
+                forgetResident(entry);
+                return true;
+            });
+        }
+        
+        long long spilled = spilledCount();
+        Volunteer v;
+        for (long long i = 0; i < spilled && popSpilled(v); i++) {
+            if (shouldRemove(static_cast<const Volunteer&>(v))) {
+                forgetQueued(v);
+                removed++;
+            } else {
+                pushSpilled(v);
+            }
+        }
+        
+        finishRemoval(removed);
+        return removed;
+    }
+    
+    long long getVersion() const {
+        return version;
+    }
 };
 
+/**
+ * Queue backend used by the application: the linked one unless built with
+ * -DVOLUNTEER_QUEUE_RING (both are always compiled; --bench-queues compares them)
+ */
+#ifdef VOLUNTEER_QUEUE_RING
+typedef RingVolunteerQueue VolunteerQueue;
+#else
+typedef LinkedVolunteerQueue VolunteerQueue;
+#endif
 
 #endif // VOLUNTEER_QUEUE_HPP
@@ -0,0 +1,153 @@
+#ifndef VOLUNTEER_SEARCH_HPP
+#define VOLUNTEER_SEARCH_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+
+/**
+ * Name normalization shared by indexing and queries: lowercase ASCII with
+ * Latin accents folded ("García" -> "garcia"), apostrophes dropped and every
+ * other non-alphanumeric character splitting tokens
+ * @param tokens Receives the name's tokens in order
+ */
+void tokenizeName(const std::string& name, CustomArray<std::string>& tokens);
+
+/**
+ * VolunteerSearchIndex - name lookup over every registered volunteer
+ *
+ * Each registration (archived and text log) is one record, keyed like the
+ * logs by volunteerKey() and carrying whether the volunteer is queued,
+ * deployed or neither. Names are split into normalized tokens; each distinct
+ * token has a posting list of record ids (ascending, i.e. oldest first), and
+ * the vocabulary is held twice more: sorted, for prefix ranges, and as a
+ * BK-tree under edit distance, for typos.
+ *
+ * A query token matches a name token exactly (cost 0), as a prefix (cost 1)
+ * or within 1 edit (2, tokens of 4+ characters) or 2 edits (3, 7+
+ * characters); two swapped adjacent letters count as one edit. Every query
+ * token must match some name token; a record costs the sum of its best
+ * matches, and records more than one worse than the best are left out.
+ *
+ * Candidates come from the query token with the fewest postings, walked by
+ * how closely it matched (exact first) and newest record first within
+ * that. The walk stops once no remaining record can make the list, or
+ * after SCAN_LIMIT candidates, so a lookup touches a few thousand records
+ * at most whether the roster holds a thousand or a million (see
+ * --bench-search). Results are ordered by cost, then newest first.
+ *
+ * Registrations, deployments and releases made by this process update the
+ * index as they happen (see volunteerSearch() in main.cpp).
+ */
+class VolunteerSearchIndex {
+public:
+    enum Status {
+        REGISTERED,  // In the history but neither queued nor deployed
+        QUEUED,
+        DEPLOYED
+    };
+
+    static const int SCAN_LIMIT = 20000;  // Candidate records examined per query at most
+
+    struct Match {
+        Volunteer volunteer;
+        Status status;
+        int cost;  // 0 when every query token matched a name token exactly
+    };
+
+private:
+    struct Record {
+        std::string name;
+        std::string contact;
+        std::string skill;
+        Status status;
+    };
+
+    // Token vocabulary; a token's id is also its BK-tree node
+    struct BkNode {
+        int firstChild;   // -1 if none
+        int nextSibling;  // -1 if none
+        int distance;     // Edit distance to the parent node
+        int farthestChild;  // Largest distance among the children, -1 if none
+    };
+
+    CustomArray<Record> records;
+    CustomHashMap<std::string, int> recordByKey;
+    CustomArray<int> recordTokens;  // Each record's token ids, record after record
+    CustomArray<int> tokenStart;    // Record id -> its first entry in recordTokens, plus the end
+
+    CustomArray<std::string> tokens;
+    CustomHashMap<std::string, int> tokenIds;
+    CustomArray<CustomArray<int> > postings;  // Token id -> record ids, ascending
+    CustomArray<BkNode> bkTree;               // Root is token 0
+    CustomArray<int> sortedTokens;            // Token ids in string order
+    CustomArray<int> unsortedTokens;          // Newer token ids, merged in batches
+
+    bool built;
+
+    // Disable copying
+    VolunteerSearchIndex(const VolunteerSearchIndex&);
+    VolunteerSearchIndex& operator=(const VolunteerSearchIndex&);
+
+    int tokenIdFor(const std::string& token);
+    void mergeUnsortedTokens();
+    int recordFor(const Volunteer& volunteer);
+    void setStatus(const Volunteer& volunteer, Status status);
+
+    /**
+     * Adds every vocabulary token a query token matches: its cost goes in
+     * costs (indexed by token id) and its id in matched
+     */
+    void matchToken(const std::string& queryToken, unsigned char* costs, CustomArray<int>& matched) const;
+    void searchBkTree(const std::string& queryToken, int radius, unsigned char* costs, CustomArray<int>& matched) const;
+
+public:
+    /**
+     * Constructor - empty, unbuilt index
+     */
+    VolunteerSearchIndex();
+
+    /**
+     * Indexes the registration history (archive, then text log) and takes
+     * each volunteer's status from the queue and the active deployment counts
+     */
+    void build(const std::string& registrationLog, const std::string& deployedLog, const std::string& releasedLog,
+               const VolunteerQueue& queue);
+
+    /**
+     * Indexes one registration (status REGISTERED if it is new); a repeat
+     * registration of the same volunteer keeps its record
+     */
+    void addRegistration(const Volunteer& volunteer);
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    /**
+     * Incremental updates (ignored until built)
+     */
+    void noteQueued(const Volunteer& volunteer);
+    void noteDeployed(const Volunteer& volunteer);
+    void noteReleased(const Volunteer& volunteer, bool requeued);
+
+    /**
+     * Best matches for a name, prefix or misspelling
+     * @param limit Most matches to return
+     * @param truncated Set when the SCAN_LIMIT stopped the walk before
+     *                  every candidate was seen
+     */
+    void search(const std::string& query, int limit, CustomArray<Match>& matches, bool& truncated) const;
+
+    int recordCount() const {
+        return records.size();
+    }
+
+    int tokenCount() const {
+        return tokens.size();
+    }
+
+    static const char* statusName(Status status);
+};
+
+#endif // VOLUNTEER_SEARCH_HPP
@@ -0,0 +1,84 @@
+#ifndef VOLUNTEER_SPILL_HPP
+#define VOLUNTEER_SPILL_HPP
+
+#include "VolunteerQueue.hpp"
+#include "CustomLists.hpp"
+#include <string>
+#include <thread>
+
+/**
+ * VolunteerSpill - FIFO of volunteers whose middle lives on disk
+ *
+ * Only two buffers stay in memory: the head being consumed and the tail
+ * being filled. When the tail reaches segmentRecords volunteers it is written
+ * out as one sequential segment file. As soon as the head starts on a
+ * buffer, the oldest segment on disk is read back on a background thread,
+ * so by the time the head runs dry its successor is normally already in
+ * memory and pop() never waits for the disk. Memory use is therefore about
+ * three segments (head, tail, prefetched) however long the FIFO grows.
+ */
+class VolunteerSpill {
+private:
+    std::string prefix;                  // Segment files are prefix + number + ".seg"
+    int segmentRecords;
+    CustomArray<Volunteer> headBuffer;
+    int headPos;                         // Next volunteer to pop from headBuffer
+    CustomArray<Volunteer> tailBuffer;
+    long long firstSegment;              // Segments [firstSegment, nextSegment) are on disk
+    long long nextSegment;
+    long long total;
+
+    std::thread* prefetcher;             // Reads firstSegment into prefetched
+    CustomArray<Volunteer> prefetched;
+    bool prefetchOk;
+    bool writeFailed;                    // Fell back to growing the tail in memory
+
+    // Disable copying
+    VolunteerSpill(const VolunteerSpill&);
+    VolunteerSpill& operator=(const VolunteerSpill&);
+
+    std::string segmentFile(long long segment) const;
+    void startPrefetch(const std::string& consumed = "");
+    void refillHead();
+
+public:
+    /**
+     * Constructor
+     * @param directory Where segment files are written
+     * @param recordsPerSegment Volunteers per segment file
+     */
+    VolunteerSpill(const std::string& directory, int recordsPerSegment);
+
+    /**
+     * Destructor - waits for any prefetch and deletes the segment files
+     */
+    ~VolunteerSpill();
+
+    /**
+     * Adds a volunteer at the back
+     */
+    void push(const Volunteer& v);
+
+    /**
+     * Removes the volunteer at the front
+     * @return false if empty
+     */
+    bool pop(Volunteer& v);
+
+    long long size() const {
+        return total;
+    }
+
+    bool empty() const {
+        return total == 0;
+    }
+
+    /**
+     * Copies one part of the FIFO, front part first: the head remainder,
+     * then each segment on disk, then the tail (used for saving and reports)
+     * @return false once part is past the last one
+     */
+    bool readPart(int part, CustomArray<Volunteer>& out) const;
+};
+
+#endif // VOLUNTEER_SPILL_HPP
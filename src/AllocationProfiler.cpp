@@ -0,0 +1,193 @@
+#include "../include/AllocationProfiler.hpp"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+/**
+ * Counters for one scope
+ */
+struct ScopeCounters {
+    std::atomic<long long> allocations;
+    std::atomic<long long> bytes;
+    std::atomic<long long> frees;
+};
+
+static std::atomic<bool> profiling(false);
+static ScopeCounters counters[AllocationProfiler::SCOPE_COUNT];
+static thread_local AllocationProfiler::Scope threadScope = AllocationProfiler::OTHER;
+
+static void printReportAtExit() {
+    AllocationProfiler::printReport();
+}
+
+void AllocationProfiler::enable() {
+    static bool reportRegistered = false;
+    if (profiling.load()) {
+        return;
+    }
+    for (int i = 0; i < SCOPE_COUNT; i++) {
+        counters[i].allocations.store(0);
+        counters[i].bytes.store(0);
+        counters[i].frees.store(0);
+    }
+    if (!reportRegistered) {
+        reportRegistered = true;
+        std::atexit(printReportAtExit);
+    }
+    profiling.store(true);
+}
+
+void AllocationProfiler::enableIfRequested() {
+#ifdef VOLUNTEER_ALLOC_PROFILE
+    enable();
+#else
+    const char* setting = std::getenv("VOLUNTEER_ALLOC_PROFILE");
+    if (setting != nullptr && *setting != '\0' && std::string(setting) != "0") {
+        enable();
+    }
+#endif
+}
+
+bool AllocationProfiler::isEnabled() {
+    return profiling.load(std::memory_order_relaxed);
+}
+
+AllocationProfiler::Scope AllocationProfiler::currentScope() {
+    return threadScope;
+}
+
+void AllocationProfiler::setCurrentScope(Scope scope) {
+    threadScope = scope;
+}
+
+const char* AllocationProfiler::scopeName(Scope scope) {
+    static const char* const names[SCOPE_COUNT] = {
+        "other", "load", "register", "deploy", "release", "report", "save"
+    };
+    return scope >= 0 && scope < SCOPE_COUNT ? names[scope] : "?";
+}
+
+void AllocationProfiler::noteAllocation(std::size_t bytes) {
+    if (!profiling.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ScopeCounters& scope = counters[threadScope];
+    scope.allocations.fetch_add(1, std::memory_order_relaxed);
+    scope.bytes.fetch_add((long long)bytes, std::memory_order_relaxed);
+}
+
+void AllocationProfiler::noteFree() {
+    if (!profiling.load(std::memory_order_relaxed)) {
+        return;
+    }
+    counters[threadScope].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Prints allocations, bytes and frees per scope
+ */
+void AllocationProfiler::printReport() {
+    bool wasProfiling = profiling.exchange(false);
+
+    long long totalAllocations = 0, totalBytes = 0, totalFrees = 0;
+    std::cout << "\n=== ALLOCATION PROFILE ===\n";
+    std::cout << std::left << std::setw(12) << "Scope"
+              << std::right << std::setw(14) << "Allocations"
+              << std::setw(16) << "Bytes"
+              << std::setw(12) << "Avg bytes"
+              << std::setw(14) << "Frees" << "\n";
+    std::cout << std::string(68, '-') << "\n";
+    for (int i = 0; i < SCOPE_COUNT; i++) {
+        long long allocations = counters[i].allocations.load();
+        long long bytes = counters[i].bytes.load();
+        long long frees = counters[i].frees.load();
+        totalAllocations += allocations;
+        totalBytes += bytes;
+        totalFrees += frees;
+        std::cout << std::left << std::setw(12) << scopeName((Scope)i)
+                  << std::right << std::setw(14) << allocations
+                  << std::setw(16) << bytes
+                  << std::setw(12) << (allocations > 0 ? bytes / allocations : 0)
+                  << std::setw(14) << frees << "\n";
+    }
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << std::left << std::setw(12) << "Total"
+              << std::right << std::setw(14) << totalAllocations
+              << std::setw(16) << totalBytes
+              << std::setw(12) << (totalAllocations > 0 ? totalBytes / totalAllocations : 0)
+              << std::setw(14) << totalFrees << "\n";
+    std::cout << std::left;
+
+    profiling.store(wasProfiling);
+}
+
+/**
+ * Global allocation functions
+ *
+ * Every form of new and delete goes through these two, so the counts cover
+ * strings, streams, list and queue nodes and all other heap use alike.
+ */
+static void* allocate(std::size_t size) {
+    if (size == 0) {
+        size = 1;
+    }
+    void* memory;
+    while ((memory = std::malloc(size)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    AllocationProfiler::noteAllocation(size);
+    return memory;
+}
+
+static void release(void* memory) {
+    if (memory != nullptr) {
+        AllocationProfiler::noteFree();
+        std::free(memory);
+    }
+}
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    release(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    release(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    release(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    release(memory);
+}
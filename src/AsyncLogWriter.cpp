@@ -0,0 +1,207 @@
+#include "../include/AsyncLogWriter.hpp"
+#include <chrono>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define LOG_OPEN(path) _open(path, _O_RDWR | _O_APPEND | _O_CREAT | _O_BINARY, 0644)
+#define LOG_LSEEK _lseek
+#define LOG_READ _read
+#define LOG_WRITE _write
+#define LOG_SYNC _commit
+#define LOG_CLOSE _close
+#else
+#include <unistd.h>
+#define LOG_OPEN(path) ::open(path, O_RDWR | O_APPEND | O_CREAT, 0644)
+#define LOG_LSEEK ::lseek
+#define LOG_READ ::read
+#define LOG_WRITE ::write
+#define LOG_SYNC ::fsync
+#define LOG_CLOSE ::close
+#endif
+
+/**
+ * Constructor - starts the writer thread
+ */
+AsyncLogWriter::AsyncLogWriter()
+    : enqueuePos(0), dequeuePos(0), persisted(0), writeFailed(false), stopping(false) {
+    for (unsigned i = 0; i < CAPACITY; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    worker = std::thread(&AsyncLogWriter::run, this);
+}
+
+/**
+ * Destructor - writes every queued record to disk, then stops the thread
+ */
+AsyncLogWriter::~AsyncLogWriter() {
+    stopping.store(true);
+    workAvailable.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * Queues one record for appending to a file
+ */
+void AsyncLogWriter::append(const std::string& filename, const std::string& line) {
+    // Bounded MPMC ring (Vyukov): a slot is free for position pos when its
+    // sequence equals pos, and holds data for the writer when it equals pos + 1
+    unsigned long long pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &ring[pos & (CAPACITY - 1)];
+        unsigned long long seq = slot->sequence.load(std::memory_order_acquire);
+        long long diff = (long long)seq - (long long)pos;
+
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring is full - let the writer catch up
+            workAvailable.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->filename = filename;
+    slot->line = line;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    workAvailable.notify_one();
+}
+
+/**
+ * Waits until every record appended before this call is on disk
+ */
+bool AsyncLogWriter::flush() {
+    unsigned long long target = enqueuePos.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(waitMutex);
+    workAvailable.notify_one();
+    batchDone.wait(lock, [this, target]() {
+        return persisted.load(std::memory_order_acquire) >= target;
+    });
+
+    return !writeFailed.exchange(false);
+}
+
+/**
+ * Collects every published record (up to a full ring) without copying them
+ * @return Number of slots placed in batch
+ */
+unsigned AsyncLogWriter::drainBatch(Slot** batch) {
+    unsigned count = 0;
+    while (count < CAPACITY) {
+        Slot* slot = &ring[(dequeuePos + count) & (CAPACITY - 1)];
+        unsigned long long seq = slot->sequence.load(std::memory_order_acquire);
+        if (seq != dequeuePos + count + 1) {
+            break;
+        }
+        batch[count++] = slot;
+    }
+    return count;
+}
+
+/**
+ * Writer thread loop - one append + fsync per file per batch
+ */
+void AsyncLogWriter::run() {
+    Slot* batch[CAPACITY];
+    bool grouped[CAPACITY];
+
+    for (;;) {
+        unsigned count = drainBatch(batch);
+
+        if (count == 0) {
+            if (stopping.load()) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(waitMutex);
+            workAvailable.wait_for(lock, std::chrono::milliseconds(20));
+            continue;
+        }
+
+        // Group records by file, keeping append order within each file
+        for (unsigned i = 0; i < count; i++) {
+            grouped[i] = false;
+        }
+        for (unsigned i = 0; i < count; i++) {
+            if (grouped[i]) continue;
+
+            std::string data;
+            for (unsigned j = i; j < count; j++) {
+                if (!grouped[j] && batch[j]->filename == batch[i]->filename) {
+                    data += batch[j]->line;
+                    data += '\n';
+                    grouped[j] = true;
+                }
+            }
+
+            if (!writeFile(batch[i]->filename, data)) {
+                writeFailed.store(true);
+            }
+        }
+
+        // Hand the slots back to producers
+        for (unsigned i = 0; i < count; i++) {
+            batch[i]->filename.clear();
+            batch[i]->line.clear();
+            batch[i]->sequence.store(dequeuePos + i + CAPACITY, std::memory_order_release);
+        }
+        dequeuePos += count;
+
+        {
+            std::lock_guard<std::mutex> lock(waitMutex);
+            persisted.fetch_add(count, std::memory_order_release);
+        }
+        batchDone.notify_all();
+    }
+}
+
+/**
+ * Appends data to a file with a single write and fsync
+ */
+bool AsyncLogWriter::writeFile(const std::string& filename, const std::string& data) {
+    int fd = LOG_OPEN(filename.c_str());
+    if (fd < 0) {
+        return false;
+    }
+
+    // Start on a fresh line if the file was left without a trailing newline
+    std::string payload;
+    char lastChar;
+    if (LOG_LSEEK(fd, -1, SEEK_END) >= 0 && LOG_READ(fd, &lastChar, 1) == 1 && lastChar != '\n') {
+        payload = "\n" + data;
+    }
+    const std::string& out = payload.empty() ? data : payload;
+
+    bool ok = true;
+    size_t written = 0;
+    while (written < out.size()) {
+        long result = (long)LOG_WRITE(fd, out.data() + written, (unsigned)(out.size() - written));
+        if (result <= 0) {
+            ok = false;
+            break;
+        }
+        written += (size_t)result;
+    }
+
+    if (LOG_SYNC(fd) != 0) {
+        ok = false;
+    }
+    LOG_CLOSE(fd);
+    return ok;
+}
+
+/**
+ * Returns the process-wide log writer, flushed automatically at exit
+ */
+AsyncLogWriter& logWriter() {
+    static AsyncLogWriter writer;
+    return writer;
+}
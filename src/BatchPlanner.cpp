@@ -0,0 +1,173 @@
+#include "../include/BatchPlanner.hpp"
+#include <algorithm>
+#include <thread>
+
+/**
+ * Constructor - copies the site table and seeds one counter per site
+ */
+BatchPlanner::BatchPlanner(const CustomArray<ReliefSite>& siteTable) : sites(siteTable) {
+    counters = new SiteCounter[sites.size() > 0 ? sites.size() : 1];
+    CustomArray<SiteSpatialIndex::Entry> located;
+    for (int i = 0; i < sites.size(); i++) {
+        counters[i].count.store(sites[i].currentCount, std::memory_order_relaxed);
+        if (sites[i].hasLocation) {
+            located.push_back(SiteSpatialIndex::Entry(sites[i].latitude, sites[i].longitude, SiteLocation(0, i),
+                                                      sites[i].currentCount < sites[i].maxCapacity));
+        }
+    }
+    spatial.build(located);
+}
+
+BatchPlanner::~BatchPlanner() {
+    delete[] counters;
+}
+
+/**
+ * Takes one place at a site if its count is still the one the caller saw
+ * @return false if another worker changed the count first, or the site is full
+ */
+bool BatchPlanner::tryReserve(int site, int seen) {
+    return seen < sites[site].maxCapacity &&
+           counters[site].count.compare_exchange_strong(seen, seen + 1, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire);
+}
+
+/**
+ * Nearest site with room within the radius, reserved; -1 if there is none
+ */
+int BatchPlanner::reserveNearest(const Volunteer& volunteer, double radiusKm) {
+    auto hasRoom = [this](const SiteLocation& location) {
+        return reservedCount(location.index) < sites[location.index].maxCapacity;
+    };
+    // Equally distant sites: lowest fill ratio, then table order
+    auto better = [this](const SiteLocation& a, const SiteLocation& b) {
+        long long lhs = (long long)reservedCount(a.index) * sites[b.index].maxCapacity;
+        long long rhs = (long long)reservedCount(b.index) * sites[a.index].maxCapacity;
+        return lhs < rhs || (lhs == rhs && a.index < b.index);
+    };
+
+    for (;;) {
+        SiteLocation nearest = spatial.nearestOpenWhere(volunteer.latitude, volunteer.longitude, radiusKm,
+                                                        hasRoom, better);
+        if (!nearest.valid()) {
+            return -1;
+        }
+        if (tryReserve(nearest.index, reservedCount(nearest.index))) {
+            return nearest.index;
+        }
+        // Lost the race: search again with the new count
+    }
+}
+
+namespace {
+/**
+ * Site in a worker's heap, keyed by the count the worker last saw
+ */
+struct HeapSite {
+    int site;
+    int seen;
+};
+}
+
+/**
+ * Plans volunteers [first, last) of the batch
+ */
+void BatchPlanner::planSlice(const CustomArray<Volunteer>& volunteers, int first, int last, bool useLocations,
+                             double radiusKm, CustomArray<int>& plan) {
+    // Heap order: lower fill ratio first, then table order (std heaps keep the largest on top)
+    auto lessNeeded = [this](const HeapSite& a, const HeapSite& b) {
+        long long lhs = (long long)a.seen * sites[b.site].maxCapacity;
+        long long rhs = (long long)b.seen * sites[a.site].maxCapacity;
+        return lhs > rhs || (lhs == rhs && a.site > b.site);
+    };
+    CustomArray<HeapSite> heap;
+    for (int i = 0; i < sites.size(); i++) {
+        HeapSite entry = { i, reservedCount(i) };
+        if (entry.seen < sites[i].maxCapacity) {
+            heap.push_back(entry);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), lessNeeded);
+
+    bool useSpatial = useLocations && !spatial.empty();
+    for (int v = first; v < last; v++) {
+        int site = -1;
+        if (useSpatial && volunteers[v].hasLocation) {
+            site = reserveNearest(volunteers[v], radiusKm);
+        }
+
+        while (site == -1 && !heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), lessNeeded);
+            HeapSite& top = heap[heap.size() - 1];
+            int current = reservedCount(top.site);
+            if (current == top.seen && tryReserve(top.site, current)) {
+                site = top.site;
+                current++;
+            }
+            // Re-rank with the newest count (ours or another worker's); full sites leave the heap
+            if (current < sites[top.site].maxCapacity) {
+                top.seen = current;
+                std::push_heap(heap.begin(), heap.end(), lessNeeded);
+            } else {
+                heap.pop_back();
+            }
+        }
+        plan[v] = site;
+    }
+}
+
+/**
+ * Reserves a place for each volunteer, front of the batch first
+ */
+int BatchPlanner::plan(const CustomArray<Volunteer>& volunteers, bool useLocations, double radiusKm, int workers,
+                       CustomArray<int>& plan) {
+    int planned = volunteers.size() < freePlaces() ? volunteers.size() : freePlaces();
+    plan.clear();
+    for (int i = 0; i < planned; i++) {
+        plan.push_back(-1);
+    }
+    if (planned == 0) {
+        return 0;
+    }
+
+    if (workers <= 0) {
+        workers = (int)std::thread::hardware_concurrency();
+    }
+    int maxWorkers = (planned + MIN_SLICE - 1) / MIN_SLICE;
+    if (workers > maxWorkers) workers = maxWorkers;
+    if (workers < 1) workers = 1;
+
+    if (workers == 1) {
+        planSlice(volunteers, 0, planned, useLocations, radiusKm, plan);
+        return planned;
+    }
+
+    // Each worker plans a contiguous slice and writes only its own plan entries
+    CustomArray<std::thread*> threads;
+    int block = (planned + workers - 1) / workers;
+    for (int w = 0; w < workers; w++) {
+        int first = w * block;
+        int last = first + block < planned ? first + block : planned;
+        if (first >= last) break;
+        threads.push_back(new std::thread([this, &volunteers, &plan, first, last, useLocations, radiusKm]() {
+            planSlice(volunteers, first, last, useLocations, radiusKm, plan);
+        }));
+    }
+    for (int w = 0; w < threads.size(); w++) {
+        threads[w]->join();
+        delete threads[w];
+    }
+    return planned;
+}
+
+/**
+ * Places still free across all sites
+ */
+int BatchPlanner::freePlaces() const {
+    long long free = 0;
+    for (int i = 0; i < sites.size(); i++) {
+        int room = sites[i].maxCapacity - reservedCount(i);
+        free += room > 0 ? room : 0;
+    }
+    return free > 0x7fffffff ? 0x7fffffff : (int)free;
+}
@@ -0,0 +1,757 @@
+#include "../include/Benchmarks.hpp"
+#include "../include/SiteAlgorithm.hpp"
+#include "../include/VolunteerSearch.hpp"
+#include "../include/BatchPlanner.hpp"
+#include "../include/Prototypes.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Outcome of one policy benchmark run
+ */
+struct PolicyBenchResult {
+    double nanosPerSelection;
+    double meanFill;    // Mean fill ratio across sites at the end
+    double fillSpread;  // Standard deviation of the fill ratio across sites
+
+    PolicyBenchResult() : nanosPerSelection(0), meanFill(0), fillSpread(0) {}
+};
+
+/**
+ * Runs the same seeded workload against a fresh copy of the table: volunteers
+ * are deployed to the site chosen by select(table) until the table is
+ * BENCH_TARGET_FILL full, after which every deployment is preceded by the
+ * release of a random volunteer, so selection always runs on a busy but
+ * never saturated table
+ */
+static const double BENCH_TARGET_FILL = 0.7;
+
+template<typename Select>
+static PolicyBenchResult benchmarkPolicy(const CustomArray<ReliefSite>& layout, long long selections,
+                                         unsigned seed, Select select) {
+    PolicyBenchResult result;
+    CustomArray<ReliefSite> table = layout;
+    long long capacity = 0;
+    for (int i = 0; i < table.size(); i++) {
+        capacity += table[i].maxCapacity;
+    }
+    long long target = (long long)(capacity * BENCH_TARGET_FILL);
+    long long occupied = 0;
+    uint64_t state = seed;  // LCG keeps the random picks cheap next to the selection
+
+    auto started = std::chrono::steady_clock::now();
+    for (long long made = 0; made < selections; made++) {
+        if (occupied >= target) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            int index = (int)((state >> 33) % (uint64_t)table.size());
+            while (table[index].currentCount == 0) {
+                index = (index + 1) % table.size();
+            }
+            table[index].currentCount--;
+            occupied--;
+        }
+
+        int best = select(table);
+        if (best != -1) {
+            table[best].currentCount++;
+            occupied++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.nanosPerSelection = seconds * 1e9 / selections;
+
+    double sum = 0;
+    double sumSquares = 0;
+    for (int i = 0; i < table.size(); i++) {
+        double ratio = (double)table[i].currentCount / table[i].maxCapacity;
+        sum += ratio;
+        sumSquares += ratio * ratio;
+    }
+    result.meanFill = sum / table.size();
+    double variance = sumSquares / table.size() - result.meanFill * result.meanFill;
+    result.fillSpread = variance > 0 ? std::sqrt(variance) : 0;
+    return result;
+}
+
+/**
+ * Benchmarks one policy called directly (compile-time choice)
+ */
+template<typename Policy>
+static PolicyBenchResult benchmarkDirect(const CustomArray<ReliefSite>& layout, long long selections,
+                                         unsigned seed, Policy policy) {
+    return benchmarkPolicy(layout, selections, seed, [&policy](const CustomArray<ReliefSite>& table) {
+        return selectSite(table, policy);
+    });
+}
+
+/**
+ * Prints command-line help for policy benchmark mode
+ */
+static void printPolicyBenchmarkUsage() {
+    std::cout << "Usage: volunteer_system --bench-policies [options]\n"
+              << "  --sites N         Synthetic sites (default 256)\n"
+              << "  --selections N    Site selections per policy (default 1000000)\n"
+              << "  --seed N          Random seed (default 42)\n";
+}
+
+/**
+ * Entry point for "--bench-policies" mode
+ */
+int runPolicyBenchmarkMode(int argc, char* argv[]) {
+    int siteCount = 256;
+    long long selections = 1000000;
+    unsigned seed = 42;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--help") {
+            printPolicyBenchmarkUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Error: Missing value for option '" << option << "'\n";
+            printPolicyBenchmarkUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--sites") siteCount = std::atoi(value.c_str());
+        else if (option == "--selections") selections = std::atoll(value.c_str());
+        else if (option == "--seed") seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printPolicyBenchmarkUsage();
+            return 1;
+        }
+    }
+    if (siteCount <= 0 || selections <= 0) {
+        std::cout << "Error: Site and selection counts must be positive.\n";
+        return 1;
+    }
+
+    // Synthetic layout with mixed capacities, all sites empty
+    CustomArray<ReliefSite> layout;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> capacity(5, 50);
+    for (int i = 0; i < siteCount; i++) {
+        layout.push_back(ReliefSite("Site" + std::to_string(i + 1), 0, capacity(rng)));
+    }
+
+    std::cout << "\n=== SITE POLICY BENCHMARK ===\n";
+    std::cout << "Sites: " << siteCount << " | Selections per policy: " << selections
+              << " | Seed: " << seed << "\n\n";
+    std::cout << std::left << std::setw(16) << "Policy"
+              << std::setw(14) << "Direct(ns)"
+              << std::setw(14) << "Table(ns)"
+              << std::setw(12) << "Mean Fill"
+              << std::setw(12) << "Fill StdDev" << "\n";
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << std::fixed;
+
+    for (int k = 0; k < SITE_POLICY_COUNT; k++) {
+        SitePolicyKind kind = (SitePolicyKind)k;
+        PolicyBenchResult direct;
+        switch (kind) {
+            case POLICY_LOWEST_COUNT: direct = benchmarkDirect(layout, selections, seed, LowestCountPolicy()); break;
+            case POLICY_MOST_FREE: direct = benchmarkDirect(layout, selections, seed, MostFreeSlotsPolicy()); break;
+            case POLICY_WEIGHTED: direct = benchmarkDirect(layout, selections, seed, WeightedPolicy()); break;
+            case POLICY_ROUND_ROBIN: direct = benchmarkDirect(layout, selections, seed, RoundRobinPolicy()); break;
+            default: direct = benchmarkDirect(layout, selections, seed, LowestRatioPolicy()); break;
+        }
+
+        SiteSelectionState state;
+        PolicyBenchResult table = benchmarkPolicy(layout, selections, seed,
+            [kind, &state](const CustomArray<ReliefSite>& sites) {
+                return selectSiteByPolicy(kind, sites, state);
+            });
+
+        std::cout << std::left << std::setw(16) << sitePolicyName(kind)
+                  << std::setw(14) << std::setprecision(1) << direct.nanosPerSelection
+                  << std::setw(14) << table.nanosPerSelection
+                  << std::setw(12) << (std::to_string((int)(direct.meanFill * 100)) + "%")
+                  << std::setw(12) << std::setprecision(3) << direct.fillSpread << "\n";
+    }
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << "Times include the workload's releases; a lower fill standard deviation means\n"
+              << "the policy spreads volunteers more evenly across sites.\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    return 0;
+}
+
+/**
+ * Queue backend benchmark
+ *
+ * Every scenario runs the same volunteers (short strings, so neither backend
+ * pays for string allocation) through a LinkedVolunteerQueue and a
+ * RingVolunteerQueue and reports nanoseconds per operation.
+ */
+static volatile size_t queueBenchSink;  // Keeps results alive past the optimizer
+
+static double nanosSince(std::chrono::steady_clock::time_point started, long long operations) {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - started;
+    return operations > 0 ? elapsed.count() / operations : 0;
+}
+
+/**
+ * Enqueue and dequeue in turn with a steady backlog of resident volunteers
+ */
+template<typename Queue>
+static double benchQueueChurn(const CustomArray<Volunteer>& pool, int backlog, long long operations, bool priority) {
+    Queue queue;
+    if (priority) {
+        queue.setSkillPriority("Medical", 5);
+        queue.setSkillPriority("Rescue", 2);
+        queue.setDispatchMode(QueueLaneRules::PRIORITY_DISPATCH);
+    }
+    for (int i = 0; i < backlog; i++) {
+        queue.enqueue(pool[i % pool.size()]);
+    }
+
+    size_t sink = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        queue.enqueue(pool[(int)((backlog + i) % pool.size())]);
+        sink += queue.dequeue().name.size();
+    }
+    double nanos = nanosSince(started, operations);
+    queueBenchSink = sink;
+    return nanos;
+}
+
+/**
+ * Fill an empty queue, then drain it (ns per volunteer through the queue)
+ */
+template<typename Queue>
+static double benchQueueFillDrain(const CustomArray<Volunteer>& pool, int volunteers) {
+    Queue queue;
+    size_t sink = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < volunteers; i++) {
+        queue.enqueue(pool[i % pool.size()]);
+    }
+    while (!queue.isEmpty()) {
+        sink += queue.dequeue().name.size();
+    }
+    double nanos = nanosSince(started, volunteers);
+    queueBenchSink = sink;
+    return nanos;
+}
+
+/**
+ * Walk every queued volunteer (ns per volunteer visited); the queue is built
+ * by churn so the linked nodes come from a well-used heap
+ */
+template<typename Queue>
+static double benchQueueIterate(const CustomArray<Volunteer>& pool, int volunteers, long long operations) {
+    Queue queue;
+    for (int i = 0; i < volunteers; i++) {
+        queue.enqueue(pool[i % pool.size()]);
+    }
+    for (int i = 0; i < volunteers; i++) {
+        queue.enqueue(pool[(volunteers + i) % pool.size()]);
+        queue.dequeue();
+    }
+
+    long long passes = operations / volunteers > 0 ? operations / volunteers : 1;
+    size_t sink = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (long long p = 0; p < passes; p++) {
+        queue.forEach([&sink](const Volunteer& v) {
+            sink += v.skill.size();
+        });
+    }
+    double nanos = nanosSince(started, passes * volunteers);
+    queueBenchSink = sink;
+    return nanos;
+}
+
+/**
+ * Splice batches onto a queue with enqueueBulk (ns per volunteer moved)
+ */
+template<typename Queue>
+static double benchQueueBulk(const CustomArray<Volunteer>& pool, int volunteers, int batchSize) {
+    Queue queue;
+    double nanos = 0;
+    for (int moved = 0; moved < volunteers; moved += batchSize) {
+        Queue batch;
+        batch.copyLaneRulesFrom(queue);
+        for (int i = 0; i < batchSize; i++) {
+            batch.enqueue(pool[(moved + i) % pool.size()]);
+        }
+        auto started = std::chrono::steady_clock::now();
+        queue.enqueueBulk(batch);
+        nanos += nanosSince(started, 1);
+    }
+    queueBenchSink = queue.size();
+    return nanos / volunteers;
+}
+
+/**
+ * Count one lane's volunteers (ns per laneSize call)
+ */
+template<typename Queue>
+static double benchQueueLaneSize(const CustomArray<Volunteer>& pool, int volunteers, long long calls) {
+    Queue queue;
+    for (int i = 0; i < volunteers; i++) {
+        queue.enqueue(pool[i % pool.size()]);
+    }
+    size_t sink = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (long long i = 0; i < calls; i++) {
+        sink += queue.laneSize(0);
+    }
+    double nanos = nanosSince(started, calls);
+    queueBenchSink = sink;
+    return nanos;
+}
+
+static void printQueueBenchmarkRow(const std::string& scenario, double linked, double ring) {
+    std::string faster = linked <= ring ? "linked" : "ring";
+    double ratio = linked <= ring ? (linked > 0 ? ring / linked : 0) : (ring > 0 ? linked / ring : 0);
+    std::ostringstream speedup;
+    speedup << std::fixed << std::setprecision(1) << ratio << "x " << faster;
+
+    std::cout << std::left << std::setw(22) << scenario
+              << std::setw(14) << std::setprecision(1) << linked
+              << std::setw(14) << ring
+              << speedup.str() << "\n";
+}
+
+static void printQueueBenchmarkUsage() {
+    std::cout << "Usage: volunteer_system --bench-queues [options]\n"
+              << "  --volunteers N    Queue size for the fill, walk and lane scenarios (default 100000)\n"
+              << "  --operations N    Enqueue/dequeue pairs or volunteers visited (default 2000000)\n"
+              << "  --batch N         Batch size for enqueueBulk (default 256)\n";
+}
+
+/**
+ * Entry point for "--bench-queues" mode
+ */
+int runQueueBenchmarkMode(int argc, char* argv[]) {
+    int volunteers = 100000;
+    long long operations = 2000000;
+    int batchSize = 256;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--help") {
+            printQueueBenchmarkUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Error: Missing value for option '" << option << "'\n";
+            printQueueBenchmarkUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--volunteers") volunteers = std::atoi(value.c_str());
+        else if (option == "--operations") operations = std::atoll(value.c_str());
+        else if (option == "--batch") batchSize = std::atoi(value.c_str());
+        else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printQueueBenchmarkUsage();
+            return 1;
+        }
+    }
+    if (volunteers <= 0 || operations <= 0 || batchSize <= 0) {
+        std::cout << "Error: Volunteer, operation and batch counts must be positive.\n";
+        return 1;
+    }
+
+    // Names and contacts short enough to stay inside std::string's own buffer
+    static const char* const skills[] = { "Medical", "Logistics", "Rescue", "Food" };
+    CustomArray<Volunteer> pool;
+    for (int i = 0; i < 4096; i++) {
+        pool.push_back(Volunteer("V" + std::to_string(i), "v" + std::to_string(i) + "@x.org", skills[i % 4]));
+    }
+    long long laneCalls = 20000000LL / volunteers > 0 ? 20000000LL / volunteers : 1;
+
+    std::cout << "\n=== QUEUE BACKEND BENCHMARK ===\n";
+    std::cout << "Volunteers: " << volunteers << " | Operations: " << operations
+              << " | Batch: " << batchSize << "\n\n";
+    std::cout << std::left << std::setw(22) << "Scenario (ns/op)"
+              << std::setw(14) << "Linked"
+              << std::setw(14) << "Ring"
+              << "Faster" << "\n";
+    std::cout << std::string(62, '-') << "\n";
+    std::cout << std::fixed;
+
+    printQueueBenchmarkRow("FIFO churn (small)", benchQueueChurn<LinkedVolunteerQueue>(pool, 64, operations, false),
+                           benchQueueChurn<RingVolunteerQueue>(pool, 64, operations, false));
+    printQueueBenchmarkRow("FIFO churn (backlog)",
+                           benchQueueChurn<LinkedVolunteerQueue>(pool, volunteers, operations, false),
+                           benchQueueChurn<RingVolunteerQueue>(pool, volunteers, operations, false));
+    printQueueBenchmarkRow("Priority churn",
+                           benchQueueChurn<LinkedVolunteerQueue>(pool, volunteers, operations, true),
+                           benchQueueChurn<RingVolunteerQueue>(pool, volunteers, operations, true));
+    printQueueBenchmarkRow("Fill then drain", benchQueueFillDrain<LinkedVolunteerQueue>(pool, volunteers),
+                           benchQueueFillDrain<RingVolunteerQueue>(pool, volunteers));
+    printQueueBenchmarkRow("Walk (forEach)", benchQueueIterate<LinkedVolunteerQueue>(pool, volunteers, operations),
+                           benchQueueIterate<RingVolunteerQueue>(pool, volunteers, operations));
+    printQueueBenchmarkRow("enqueueBulk splice", benchQueueBulk<LinkedVolunteerQueue>(pool, volunteers, batchSize),
+                           benchQueueBulk<RingVolunteerQueue>(pool, volunteers, batchSize));
+    printQueueBenchmarkRow("laneSize", benchQueueLaneSize<LinkedVolunteerQueue>(pool, volunteers, laneCalls),
+                           benchQueueLaneSize<RingVolunteerQueue>(pool, volunteers, laneCalls));
+
+    std::cout << std::string(62, '-') << "\n";
+    std::cout << "enqueueBulk is per volunteer moved (the linked queue relinks whole lanes);\n"
+              << "laneSize is per call (the linked queue walks the lane).\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    return 0;
+}
+
+/**
+ * Name search benchmark
+ *
+ * Indexes synthetic registrations whose names are built from syllables (so
+ * the vocabulary grows with the roster, as real surnames do) and times
+ * exact, prefix and misspelled lookups of names that are in the index.
+ */
+static const char* const NAME_SYLLABLES[] = {
+    "ka", "ri", "mo", "na", "le", "ta", "so", "mi", "ra", "do", "ve", "lu", "sa", "ni", "ro", "be",
+    "gar", "cia", "lin", "ton", "mar", "el", "an", "son", "ber", "ez", "ov", "ski", "wa", "ha", "zu", "pe"
+};
+static const int NAME_SYLLABLE_COUNT = sizeof(NAME_SYLLABLES) / sizeof(NAME_SYLLABLES[0]);
+
+static std::string syntheticNamePart(std::mt19937& random, int syllables) {
+    std::string part;
+    for (int i = 0; i < syllables; i++) {
+        part += NAME_SYLLABLES[random() % NAME_SYLLABLE_COUNT];
+    }
+    part[0] = (char)(part[0] - 'a' + 'A');
+    return part;
+}
+
+/**
+ * Swaps two adjacent letters in the longest word of a name
+ */
+static std::string misspellName(const std::string& name, std::mt19937& random) {
+    size_t start = 0, longestStart = 0, longestLength = 0;
+    while (start < name.size()) {
+        size_t end = name.find(' ', start);
+        if (end == std::string::npos) end = name.size();
+        if (end - start > longestLength) {
+            longestStart = start;
+            longestLength = end - start;
+        }
+        start = end + 1;
+    }
+    std::string misspelled = name;
+    if (longestLength >= 4) {
+        size_t at = longestStart + 1 + random() % (longestLength - 2);
+        std::swap(misspelled[at], misspelled[at + 1]);
+    }
+    return misspelled;
+}
+
+struct SearchBenchResult {
+    double averageMicros;
+    double worstMicros;
+    double foundRate;  // Share of queries whose intended volunteer was among the matches
+};
+
+static SearchBenchResult benchSearchQueries(const VolunteerSearchIndex& index, const CustomArray<std::string>& queries,
+                                            const CustomArray<std::string>& expected, int limit) {
+    SearchBenchResult result = { 0, 0, 0 };
+    CustomArray<VolunteerSearchIndex::Match> matches;
+    bool truncated = false;
+    int found = 0;
+    for (int i = 0; i < queries.size(); i++) {
+        auto started = std::chrono::steady_clock::now();
+        index.search(queries[i], limit, matches, truncated);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - started;
+        result.averageMicros += elapsed.count();
+        result.worstMicros = elapsed.count() > result.worstMicros ? elapsed.count() : result.worstMicros;
+        for (int m = 0; m < matches.size(); m++) {
+            if (matches[m].volunteer.name == expected[i]) {
+                found++;
+                break;
+            }
+        }
+    }
+    if (queries.size() > 0) {
+        result.averageMicros /= queries.size();
+        result.foundRate = (double)found / queries.size();
+    }
+    return result;
+}
+
+static void printSearchBenchmarkUsage() {
+    std::cout << "Usage: volunteer_system --bench-search [options]\n"
+              << "  --volunteers N    Registrations to index (default 1000000)\n"
+              << "  --queries N       Lookups per query kind (default 2000)\n"
+              << "  --limit N         Matches returned per lookup (default 10)\n"
+              << "  --seed N          Random seed (default 42)\n";
+}
+
+/**
+ * Entry point for "--bench-search" mode
+ */
+int runSearchBenchmarkMode(int argc, char* argv[]) {
+    int volunteers = 1000000;
+    int queryCount = 2000;
+    int limit = 10;
+    unsigned seed = 42;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--help") {
+            printSearchBenchmarkUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Error: Missing value for option '" << option << "'\n";
+            printSearchBenchmarkUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--volunteers") volunteers = std::atoi(value.c_str());
+        else if (option == "--queries") queryCount = std::atoi(value.c_str());
+        else if (option == "--limit") limit = std::atoi(value.c_str());
+        else if (option == "--seed") seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printSearchBenchmarkUsage();
+            return 1;
+        }
+    }
+    if (volunteers <= 0 || queryCount <= 0 || limit <= 0) {
+        std::cout << "Error: Volunteer, query and limit counts must be positive.\n";
+        return 1;
+    }
+
+    static const char* const skills[] = { "Medical", "Logistics", "Rescue", "Food" };
+    std::mt19937 random(seed);
+    VolunteerSearchIndex index;
+    CustomArray<std::string> names;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < volunteers; i++) {
+        std::string name = syntheticNamePart(random, 1 + random() % 2) + " " + syntheticNamePart(random, 2 + random() % 2);
+        index.addRegistration(Volunteer(name, "v" + std::to_string(i) + "@x.org", skills[i % 4]));
+        if (i % (volunteers / queryCount > 0 ? volunteers / queryCount : 1) == 0 && names.size() < queryCount) {
+            names.push_back(name);
+        }
+    }
+    std::chrono::duration<double> buildSeconds = std::chrono::steady_clock::now() - started;
+
+    CustomArray<std::string> exact, prefix, misspelled;
+    for (int i = 0; i < names.size(); i++) {
+        const std::string& name = names[i];
+        size_t space = name.find(' ');
+        exact.push_back(name);
+        prefix.push_back(name.substr(0, space) + " " + name.substr(space + 1, 3));
+        misspelled.push_back(misspellName(name, random));
+    }
+
+    std::cout << "\n=== NAME SEARCH BENCHMARK ===\n";
+    std::cout << "Volunteers: " << index.recordCount() << " | Distinct name tokens: " << index.tokenCount()
+              << " | Built in " << std::fixed << std::setprecision(2) << buildSeconds.count() << " s\n\n";
+    std::cout << std::left << std::setw(26) << "Query kind"
+              << std::setw(14) << "Avg (us)"
+              << std::setw(14) << "Worst (us)"
+              << "Found" << "\n";
+    std::cout << std::string(62, '-') << "\n";
+
+    const char* const kinds[] = { "Exact name", "First + surname prefix", "Misspelled" };
+    const CustomArray<std::string>* queries[] = { &exact, &prefix, &misspelled };
+    for (int k = 0; k < 3; k++) {
+        SearchBenchResult result = benchSearchQueries(index, *queries[k], names, limit);
+        std::cout << std::setw(26) << kinds[k]
+                  << std::setw(14) << std::setprecision(1) << result.averageMicros
+                  << std::setw(14) << result.worstMicros
+                  << std::setprecision(0) << result.foundRate * 100 << "%\n";
+    }
+    std::cout << std::string(62, '-') << "\n";
+    std::cout << "Found is the share of lookups whose intended volunteer was in the top " << limit << ".\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    return 0;
+}
+
+/**
+ * Batch planner benchmark
+ *
+ * Plans the same batch on a fresh planner per worker count and checks each
+ * plan: every volunteer placed (up to the free places) and no site above
+ * its capacity.
+ */
+struct PlannerBenchResult {
+    double milliseconds;
+    int planned;
+    bool valid;        // Plan respects every capacity and places every planned volunteer
+    double nearShare;  // Share of located volunteers placed within the radius
+
+    PlannerBenchResult() : milliseconds(0), planned(0), valid(false), nearShare(0) {}
+};
+
+static PlannerBenchResult benchPlanner(const CustomArray<ReliefSite>& layout, const CustomArray<Volunteer>& batch,
+                                       double radiusKm, int workers) {
+    PlannerBenchResult result;
+    BatchPlanner planner(layout);
+    int freePlaces = planner.freePlaces();
+    CustomArray<int> plan;
+
+    auto started = std::chrono::steady_clock::now();
+    result.planned = planner.plan(batch, true, radiusKm, workers, plan);
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    CustomArray<int> counts;
+    for (int i = 0; i < layout.size(); i++) {
+        counts.push_back(layout[i].currentCount);
+    }
+    result.valid = result.planned == (batch.size() < freePlaces ? batch.size() : freePlaces);
+    int located = 0;
+    int near = 0;
+    for (int v = 0; v < result.planned && result.valid; v++) {
+        if (plan[v] < 0 || plan[v] >= layout.size()) {
+            result.valid = false;
+            break;
+        }
+        counts[plan[v]]++;
+        const ReliefSite& site = layout[plan[v]];
+        if (batch[v].hasLocation) {
+            located++;
+            if (site.hasLocation && planner.distanceKm(batch[v].latitude, batch[v].longitude, plan[v]) <= radiusKm) {
+                near++;
+            }
+        }
+    }
+    for (int i = 0; i < layout.size() && result.valid; i++) {
+        result.valid = counts[i] <= layout[i].maxCapacity && counts[i] == planner.reservedCount(i);
+    }
+    result.nearShare = located > 0 ? (double)near / located : 0;
+    return result;
+}
+
+/**
+ * Prints command-line help for planner benchmark mode
+ */
+static void printPlannerBenchmarkUsage() {
+    std::cout << "Usage: volunteer_system --bench-planner [options]\n"
+              << "  --sites N         Synthetic sites (default 5000)\n"
+              << "  --volunteers N    Batch size (default 200000)\n"
+              << "  --located N       Percent of volunteers with a location (default 50)\n"
+              << "  --radius KM       Travel radius (default 50)\n"
+              << "  --workers N       Most worker threads to try (default: hardware threads)\n"
+              << "  --seed N          Random seed (default 42)\n";
+}
+
+/**
+ * Entry point for "--bench-planner" mode
+ */
+int runPlannerBenchmarkMode(int argc, char* argv[]) {
+    int siteCount = 5000;
+    int volunteers = 200000;
+    int locatedPercent = 50;
+    double radiusKm = DEFAULT_TRAVEL_RADIUS_KM;
+    int hardware = (int)std::thread::hardware_concurrency();
+    int maxWorkers = hardware > 1 ? hardware : 1;
+    unsigned seed = 42;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--help") {
+            printPlannerBenchmarkUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Error: Missing value for option '" << option << "'\n";
+            printPlannerBenchmarkUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--sites") siteCount = std::atoi(value.c_str());
+        else if (option == "--volunteers") volunteers = std::atoi(value.c_str());
+        else if (option == "--located") locatedPercent = std::atoi(value.c_str());
+        else if (option == "--radius") radiusKm = std::atof(value.c_str());
+        else if (option == "--workers") maxWorkers = std::atoi(value.c_str());
+        else if (option == "--seed") seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printPlannerBenchmarkUsage();
+            return 1;
+        }
+    }
+    if (siteCount <= 0 || volunteers <= 0 || radiusKm <= 0 || maxWorkers <= 0 || locatedPercent < 0 ||
+        locatedPercent > 100) {
+        std::cout << "Error: Site, volunteer and worker counts and the radius must be positive, located 0-100.\n";
+        return 1;
+    }
+
+    // Sites spread over a region about 500 km across, most with coordinates, partly filled
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> capacity(10, 200);
+    std::uniform_real_distribution<double> latitude(10.0, 14.5);
+    std::uniform_real_distribution<double> longitude(120.0, 124.5);
+    CustomArray<ReliefSite> layout;
+    for (int i = 0; i < siteCount; i++) {
+        int max = capacity(rng);
+        ReliefSite site("Site" + std::to_string(i + 1), (int)(rng() % (max / 2 + 1)), max);
+        if (rng() % 10 != 0) {
+            site.setLocation(latitude(rng), longitude(rng));
+        }
+        layout.push_back(site);
+    }
+
+    static const char* const skills[] = { "Medical", "Logistics", "Rescue", "Food" };
+    CustomArray<Volunteer> batch;
+    for (int i = 0; i < volunteers; i++) {
+        Volunteer volunteer("V" + std::to_string(i), "v" + std::to_string(i) + "@x.org", skills[i % 4]);
+        if ((int)(rng() % 100) < locatedPercent) {
+            volunteer.setLocation(latitude(rng), longitude(rng));
+        }
+        batch.push_back(volunteer);
+    }
+
+    CustomArray<int> workerCounts;
+    for (int w = 1; w < maxWorkers; w *= 2) {
+        workerCounts.push_back(w);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    BatchPlanner probe(layout);
+    std::cout << "\n=== BATCH PLANNER BENCHMARK ===\n";
+    std::cout << "Sites: " << siteCount << " | Free places: " << probe.freePlaces() << " | Batch: " << volunteers
+              << " (" << locatedPercent << "% located) | Radius: " << radiusKm << " km | Hardware threads: "
+              << hardware << "\n\n";
+    std::cout << std::left << std::setw(10) << "Workers"
+              << std::setw(12) << "Planned"
+              << std::setw(12) << "Time (ms)"
+              << std::setw(10) << "Speedup"
+              << std::setw(12) << "Near site"
+              << "Plan check" << "\n";
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << std::fixed;
+
+    bool allValid = true;
+    double baseline = 0;
+    for (int k = 0; k < workerCounts.size(); k++) {
+        PlannerBenchResult result = benchPlanner(layout, batch, radiusKm, workerCounts[k]);
+        if (k == 0) baseline = result.milliseconds;
+        allValid = allValid && result.valid;
+        std::cout << std::setw(10) << workerCounts[k]
+                  << std::setw(12) << result.planned
+                  << std::setw(12) << std::setprecision(1) << result.milliseconds
+                  << std::setw(10) << std::setprecision(2) << (result.milliseconds > 0 ? baseline / result.milliseconds : 0)
+                  << std::setw(12) << (std::to_string((int)(result.nearShare * 100 + 0.5)) + "%")
+                  << (result.valid ? "OK" : "FAILED") << "\n";
+    }
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << "Near site is the share of located volunteers placed within the radius; the plan check\n"
+              << "confirms every volunteer got a place and no site went over capacity.\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    return allValid ? 0 : 1;
+}
@@ -0,0 +1,610 @@
+#include "../include/Daemon.hpp"
+#include "../include/Prototypes.hpp"
+#include "../include/AsyncLogWriter.hpp"
+#include "../include/AllocationProfiler.hpp"
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Splits a payload on tabs
+ */
+static void splitFields(const std::string& payload, CustomArray<std::string>& fields) {
+    size_t start = 0;
+    while (true) {
+        size_t tab = payload.find('\t', start);
+        fields.push_back(payload.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+}
+
+static std::string errorResponse(const std::string& message) {
+    return "ERR\t" + message;
+}
+
+/**
+ * Fields end up in comma-separated logs, so they must not contain separators
+ */
+static bool validField(const std::string& field) {
+    return !field.empty() && field.find_first_of(",\n\r") == std::string::npos;
+}
+
+/**
+ * Scope a request's allocations are charged to (by its command)
+ */
+static AllocationProfiler::Scope requestAllocationScope(const std::string& request) {
+    std::string command = request.substr(0, request.find('\t'));
+    if (command == "REGISTER") return AllocationProfiler::REGISTER;
+    if (command == "DEPLOY" || command == "BATCH") return AllocationProfiler::DEPLOY;
+    if (command == "RELEASE") return AllocationProfiler::RELEASE;
+    if (command == "PING") return AllocationProfiler::OTHER;
+    return AllocationProfiler::REPORT;
+}
+
+/**
+ * Whether a request can leave site counts to save (reports and PING never do)
+ */
+static bool isMutatingRequest(const std::string& request) {
+    AllocationProfiler::Scope scope = requestAllocationScope(request);
+    return scope != AllocationProfiler::REPORT && scope != AllocationProfiler::OTHER;
+}
+
+/**
+ * Executes one request payload against the resident state
+ */
+std::string handleDaemonRequest(VolunteerQueue& queue, const std::string& request) {
+    AllocationScope scope(requestAllocationScope(request));
+    CustomArray<std::string> fields;
+    splitFields(request, fields);
+    const std::string& command = fields[0];
+    RegionRegistry& registry = siteRegistry();
+
+    if (command == "PING") {
+        return "OK\tPONG";
+    }
+
+    if (command == "REGISTER") {
+        if (fields.size() != 4 && fields.size() != 6) {
+            return errorResponse("REGISTER expects name, contact, skill and optional latitude, longitude");
+        }
+        Volunteer volunteer(trim(fields[1]), trim(fields[2]), trim(fields[3]));
+        if (!validField(volunteer.name) || !validField(volunteer.contact) || !validField(volunteer.skill)) {
+            return errorResponse("Fields must be non-empty and must not contain commas");
+        }
+        if (fields.size() == 6) {
+            double latitude, longitude;
+            if (!parseCoordinates(fields[4] + "," + fields[5], latitude, longitude)) {
+                return errorResponse("Invalid location");
+            }
+            volunteer.setLocation(latitude, longitude);
+        }
+
+        queue.enqueue(volunteer);
+        saveVolunteerToFile(volunteer, "../data/volunteers.txt");
+        return "OK\t" + std::to_string(queue.size());
+    }
+
+    if (command == "DEPLOY") {
+        if (queue.isEmpty()) {
+            return errorResponse("No volunteers available in queue");
+        }
+        std::string region = fields.size() > 1 ? trim(fields[1]) : "";
+        if (!region.empty() && registry.shardIndex(region) == -1) {
+            return errorResponse("Unknown region '" + region + "'");
+        }
+
+        double radius = fields.size() > 2 ? std::atof(fields[2].c_str()) : DEFAULT_TRAVEL_RADIUS_KM;
+        if (radius <= 0) {
+            radius = DEFAULT_TRAVEL_RADIUS_KM;
+        }
+
+        // Same rule as the console: nearest open site for located volunteers, else most needed.
+        // A lost race means another instance just took a place, so choose again.
+        const int MAX_ATTEMPTS = 8;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            if (queue.isEmpty()) {
+                return errorResponse("No volunteers available in queue");
+            }
+            SiteLocation best = chooseDeploymentSite(queue.front(), region, radius);
+            if (!best.valid()) {
+                return errorResponse("All relief sites are at maximum capacity");
+            }
+
+            Volunteer volunteer;
+            if (commitDeployment(queue, best, volunteer)) {
+                return "OK\t" + volunteer.name + "\t" + volunteer.contact + "\t" + volunteer.skill + "\t" +
+                       registry.site(best).name;
+            }
+        }
+        return errorResponse("Sites kept filling up in other instances; try again");
+    }
+
+    if (command == "BATCH") {
+        if (fields.size() < 2 || fields.size() > 4) {
+            return errorResponse("BATCH expects count and optional region, radius-km");
+        }
+        int count = std::atoi(fields[1].c_str());
+        if (count <= 0) {
+            return errorResponse("Count must be a positive number");
+        }
+        if (queue.isEmpty()) {
+            return errorResponse("No volunteers available in queue");
+        }
+        std::string region = fields.size() > 2 ? trim(fields[2]) : "";
+        if (!region.empty() && registry.shardIndex(region) == -1) {
+            return errorResponse("Unknown region '" + region + "'");
+        }
+
+        double radius = fields.size() > 3 ? std::atof(fields[3].c_str()) : DEFAULT_TRAVEL_RADIUS_KM;
+        if (radius <= 0) {
+            radius = DEFAULT_TRAVEL_RADIUS_KM;
+        }
+
+        CustomLinkedList<DeploymentNode> deployed;
+        int total = commitBatchDeployment(queue, count, region, radius, deployed);
+        if (total == 0) {
+            return errorResponse("All relief sites are at maximum capacity");
+        }
+
+        std::string response = "OK\t" + std::to_string(total) + "\t" + std::to_string(queue.size());
+        for (CustomLinkedList<DeploymentNode>::Iterator it = deployed.begin(); it != deployed.end(); ++it) {
+            const Volunteer& volunteer = (*it).volunteer;
+            response += "\n" + volunteer.name + "\t" + volunteer.contact + "\t" + volunteer.skill + "\t" + (*it).site;
+        }
+        return response;
+    }
+
+    if (command == "RELEASE") {
+        if (fields.size() < 2 || fields.size() > 3) {
+            return errorResponse("RELEASE expects contact and optional requeue|checkout");
+        }
+        std::string action = fields.size() == 3 ? fields[2] : "checkout";
+        if (action != "requeue" && action != "checkout") {
+            return errorResponse("Release action must be requeue or checkout");
+        }
+
+        DeploymentNode released(Volunteer(), "");
+        SiteLocation location;
+        std::string error;
+        if (!commitRelease(queue, trim(fields[1]), action == "requeue", released, location, error)) {
+            return errorResponse(error);
+        }
+        const ReliefSite& site = registry.site(location);
+        return "OK\t" + site.name + "\t" + std::to_string(site.currentCount) + "\t" + std::to_string(site.maxCapacity);
+    }
+
+    if (command == "QUEUE") {
+        return "OK\t" + std::to_string(queue.size()) + "\t" + (queue.isEmpty() ? "" : queue.front().name);
+    }
+
+    if (command == "STATS") {
+        logWriter().flush();
+        LiveStats& stats = liveStats();
+        stats.reconcile();
+        const LiveStats::Totals& totals = stats.totals();
+        std::string response = "OK\t" + std::to_string(totals.registered) + "\t" + std::to_string(queue.size()) +
+                               "\t" + std::to_string(totals.deployed) + "\t" + std::to_string(totals.released) +
+                               "\t" + std::to_string(totals.requeued);
+        totals.registeredBySkill.forEach([&](const std::string& skill, long long registered) {
+            const long long* deployed = totals.deployedBySkill.find(skill);
+            response += "\nskill\t" + skill + "\t" + std::to_string(registered) + "\t" +
+                        std::to_string(deployed != nullptr ? *deployed : 0) + "\t" +
+                        std::to_string(queue.countWithSkill(skill));
+        });
+        totals.deployedBySite.forEach([&](const std::string& site, long long deployed) {
+            const long long* released = totals.releasedBySite.find(site);
+            response += "\nsite\t" + site + "\t" + std::to_string(deployed) + "\t" +
+                        std::to_string(released != nullptr ? *released : 0);
+        });
+        return response;
+    }
+
+    if (command == "WHERE") {
+        if (fields.size() != 2) {
+            return errorResponse("WHERE expects a contact");
+        }
+        const DeploymentNode* deployment = deploymentIndex().find(trim(fields[1]));
+        if (deployment == nullptr) {
+            return errorResponse("No active deployment for '" + trim(fields[1]) + "'");
+        }
+        return "OK\t" + deployment->site + "\t" + deployment->deployedAt;
+    }
+
+    if (command == "AT") {
+        if (fields.size() != 2) {
+            return errorResponse("AT expects a site name");
+        }
+        std::string site = trim(fields[1]);
+        if (!registry.find(site).valid() && deploymentIndex().countAtSite(site) == 0) {
+            return errorResponse("Unknown site '" + site + "'");
+        }
+        std::string response = "OK\t" + std::to_string(deploymentIndex().countAtSite(site));
+        deploymentIndex().forEachAtSite(site, [&response](const DeploymentNode& node) {
+            response += "\n" + node.volunteer.name + "\t" + node.volunteer.contact + "\t" +
+                        node.volunteer.skill + "\t" + node.deployedAt;
+        });
+        return response;
+    }
+
+    if (command == "FIND") {
+        if (fields.size() != 2 || trim(fields[1]).empty()) {
+            return errorResponse("FIND expects a name, prefix or misspelling");
+        }
+        CustomArray<VolunteerSearchIndex::Match> matches;
+        bool truncated = false;
+        builtVolunteerSearch(queue).search(trim(fields[1]), 10, matches, truncated);
+        std::string response = "OK\t" + std::to_string(matches.size());
+        for (int i = 0; i < matches.size(); i++) {
+            const Volunteer& volunteer = matches[i].volunteer;
+            const DeploymentNode* deployment = deploymentIndex().find(volunteer.contact);
+            bool deployed = matches[i].status == VolunteerSearchIndex::DEPLOYED && deployment != nullptr;
+            response += "\n" + volunteer.name + "\t" + volunteer.contact + "\t" + volunteer.skill + "\t" +
+                        VolunteerSearchIndex::statusName(matches[i].status) + "\t" +
+                        (deployed ? deployment->site : "");
+        }
+        return response;
+    }
+
+    if (command == "SITES") {
+        std::string response = "OK";
+        for (int s = 0; s < registry.shardCount(); s++) {
+            const RegionShard& shard = registry.shard(s);
+            const CustomArray<ReliefSite>& sites = shard.sites.all();
+            for (int i = 0; i < sites.size(); i++) {
+                response += "\n" + shard.region + "\t" + sites[i].name + "\t" +
+                            std::to_string(sites[i].currentCount) + "\t" + std::to_string(sites[i].maxCapacity);
+            }
+        }
+        return response;
+    }
+
+    return errorResponse("Unknown command '" + command + "'");
+}
+
+#ifdef __linux__
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onStopSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * One client connection with its unparsed input and unsent output
+ */
+struct DaemonConnection {
+    int fd;
+    std::string input;
+    std::string output;
+    size_t outputSent;
+    bool watchingWrites;  // EPOLLOUT registered because output is backed up
+    bool readingPaused;   // EPOLLIN dropped until the client reads its answers
+
+    DaemonConnection(int f) : fd(f), outputSent(0), watchingWrites(false), readingPaused(false) {}
+
+    size_t unsent() const {
+        return output.size() - outputSent;
+    }
+};
+
+static bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+static void appendFrame(std::string& output, const std::string& payload) {
+    uint32_t length = (uint32_t)payload.size();
+    for (int i = 0; i < 4; i++) {
+        output.push_back((char)((length >> (8 * i)) & 0xFF));
+    }
+    output += payload;
+}
+
+/**
+ * Sends as much pending output as the socket takes; false on a write error
+ */
+static bool flushOutput(int epollFd, DaemonConnection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent,
+                            connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        connection.outputSent += (size_t)sent;
+    }
+
+    bool backedUp = connection.outputSent < connection.output.size();
+    if (!backedUp) {
+        connection.output.clear();
+        connection.outputSent = 0;
+    }
+
+    // Only wait for writability while output is backed up, and leave requests
+    // in the socket while a full backlog of answers is waiting
+    bool paused = connection.unsent() > MAX_DAEMON_BACKLOG;
+    if (backedUp != connection.watchingWrites || paused != connection.readingPaused) {
+        epoll_event event;
+        event.events = (paused ? 0u : (uint32_t)EPOLLIN) | (backedUp ? (uint32_t)EPOLLOUT : 0u);
+        event.data.fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.watchingWrites = backedUp;
+        connection.readingPaused = paused;
+    }
+    return true;
+}
+
+/**
+ * Runs the complete frames in the input buffer until a full backlog of
+ * answers is waiting; false if the client broke framing
+ * @param mutated Set when a request may have changed site counts
+ */
+static bool processFrames(VolunteerQueue& queue, DaemonConnection& connection, long long& served, bool& mutated) {
+    size_t offset = 0;
+    std::string& input = connection.input;
+    while (input.size() - offset >= 4) {
+        uint32_t length = 0;
+        for (int i = 0; i < 4; i++) {
+            length |= (uint32_t)(unsigned char)input[offset + i] << (8 * i);
+        }
+        if (length == 0 || length > MAX_DAEMON_FRAME) {
+            return false;
+        }
+        if (input.size() - offset - 4 < length) {
+            break;  // Rest of the frame has not arrived yet
+        }
+        if (connection.unsent() > MAX_DAEMON_BACKLOG) {
+            break;  // The rest waits until the client has read more answers
+        }
+
+        std::string request = input.substr(offset + 4, length);
+        if (isMutatingRequest(request)) {
+            mutated = true;
+        }
+        appendFrame(connection.output, handleDaemonRequest(queue, request));
+        offset += 4 + length;
+        served++;
+    }
+    input.erase(0, offset);
+    return true;
+}
+
+static void closeConnection(int epollFd, CustomHashMap<int, DaemonConnection*>& connections, int fd) {
+    DaemonConnection** found = connections.find(fd);
+    if (found == nullptr) return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    delete *found;
+    connections.erase(fd);
+}
+
+/**
+ * Binds the listening socket, refusing to take over one a live daemon still serves
+ */
+static int openListener(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cout << "Error: Socket path '" << path << "' is too long.\n";
+        return -1;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe != -1) {
+        bool live = connect(probe, (sockaddr*)&address, sizeof(address)) == 0;
+        close(probe);
+        if (live) {
+            std::cout << "Error: Another daemon is already listening on '" << path << "'.\n";
+            return -1;
+        }
+    }
+    unlink(path.c_str());  // Stale socket from a daemon that did not shut down cleanly
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1 || bind(fd, (sockaddr*)&address, sizeof(address)) == -1 ||
+        listen(fd, SOMAXCONN) == -1 || !setNonBlocking(fd)) {
+        std::cout << "Error: Could not listen on '" << path << "': " << std::strerror(errno) << "\n";
+        if (fd != -1) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Entry point for "--daemon" mode
+ */
+int runDaemonMode(int argc, char* argv[]) {
+    std::string socketPath = DEFAULT_DAEMON_SOCKET;
+    bool follow = false;
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (option == "--follow") {
+            follow = true;
+        } else {
+            std::cout << "Usage: volunteer_system --daemon [--socket PATH] [--follow]\n";
+            return option == "--help" ? 0 : 1;
+        }
+    }
+
+    // Load everything once; it stays resident for every client
+    VolunteerQueue queue;
+    std::cout << "=== DAEMON INITIALIZATION ===\n";
+    loadDispatchSettings(queue, "../data/dispatch.txt");
+    long long ingestedOffset = initializeQueue(queue);
+    if (siteRegistry().empty()) {
+        std::cout << "Error: Could not load relief sites data.\n";
+        return 1;
+    }
+    deploymentIndex();
+
+    int listener = openListener(socketPath);
+    if (listener == -1) {
+        return 1;
+    }
+    int epollFd = epoll_create1(0);
+    epoll_event listenEvent;
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listener;
+    if (epollFd == -1 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listener, &listenEvent) == -1) {
+        std::cout << "Error: Could not set up epoll: " << std::strerror(errno) << "\n";
+        close(listener);
+        unlink(socketPath.c_str());
+        return 1;
+    }
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onStopSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    // New registrations in the log wake the loop like a client request
+    RegistrationFollower& follower = registrationFollower();
+    trackRegistrations(ingestedOffset);
+    if (follow && startFollowing(ingestedOffset)) {
+        epoll_event followEvent;
+        followEvent.events = EPOLLIN;
+        followEvent.data.fd = follower.fd();
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, follower.fd(), &followEvent);
+    }
+
+    std::cout << "Listening on " << socketPath << " (" << queue.size() << " volunteers queued)\n";
+
+    CustomHashMap<int, DaemonConnection*> connections;
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    char buffer[64 * 1024];
+    long long served = 0;
+    bool mutated = false;  // Site counts may have changed since the last save
+
+    while (!stopRequested) {
+        // Timeout bounds how long a stop signal can go unnoticed
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cout << "Error: epoll_wait failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        // Deployments and releases of other instances; two file sizes when there are none
+        catchUpDeployments(queue);
+
+        for (int e = 0; e < ready; e++) {
+            int fd = events[e].data.fd;
+
+            if (fd == listener) {
+                int client;
+                while ((client = accept(listener, nullptr, nullptr)) != -1) {
+                    if (!setNonBlocking(client)) {
+                        close(client);
+                        continue;
+                    }
+                    epoll_event clientEvent;
+                    clientEvent.events = EPOLLIN;
+                    clientEvent.data.fd = client;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, client, &clientEvent);
+                    connections.insert(client, new DaemonConnection(client));
+                }
+                continue;
+            }
+            if (follower.isFollowing() && fd == follower.fd()) {
+                follower.poll(queue);
+                continue;
+            }
+
+            DaemonConnection** found = connections.find(fd);
+            if (found == nullptr) continue;
+            DaemonConnection& connection = **found;
+            bool keep = true;
+
+            // Answer complete requests in order as they arrive, so at most one
+            // read of requests is buffered. A client a full backlog behind on
+            // its answers gets what the socket takes; if that is not enough,
+            // its requests stay in the socket until EPOLLOUT says it read more.
+            while (true) {
+                if (!processFrames(queue, connection, served, mutated)) {
+                    keep = false;
+                    break;
+                }
+                if (connection.unsent() > MAX_DAEMON_BACKLOG) {
+                    if (!flushOutput(epollFd, connection)) {
+                        keep = false;
+                        break;
+                    }
+                    if (connection.unsent() > MAX_DAEMON_BACKLOG) break;
+                    continue;
+                }
+
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    connection.input.append(buffer, (size_t)received);
+                    continue;
+                }
+                if (received < 0 && errno == EINTR) continue;
+                if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    keep = false;  // Peer closed or failed; what arrived first was answered
+                }
+                break;
+            }
+
+            if (!flushOutput(epollFd, connection) || !keep) {
+                closeConnection(epollFd, connections, fd);
+            }
+        }
+
+        // One site-file write per batch of requests rather than per deployment,
+        // and none for wakeups that only read
+        if (mutated) {
+            siteRegistry().saveDirty();
+            mutated = false;
+        }
+    }
+
+    std::cout << "\nShutting down after " << served << " requests.\n";
+    CustomArray<int> open;
+    connections.forEach([&open](const int& fd, DaemonConnection* const&) {
+        open.push_back(fd);
+    });
+    for (int i = 0; i < open.size(); i++) {
+        closeConnection(epollFd, connections, open[i]);
+    }
+    close(listener);
+    close(epollFd);
+    unlink(socketPath.c_str());
+
+    // Registrations others appended are queued before the cursor moves past them
+    follower.ingest(queue);
+    follower.stop();
+    siteRegistry().saveDirty();
+    saveAllVolunteersToFile(queue, "../data/queue_state.dat");
+    return 0;
+}
+
+#else
+
+/**
+ * Entry point for "--daemon" mode (needs epoll and Unix domain sockets)
+ */
+int runDaemonMode(int, char*[]) {
+    std::cout << "Error: Daemon mode is only available on Linux.\n";
+    return 1;
+}
+
+#endif
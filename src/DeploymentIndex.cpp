@@ -0,0 +1,293 @@
+#include "../include/DeploymentIndex.hpp"
+#include "../include/Prototypes.hpp"
+#include "../include/HistoryArchive.hpp"
+#include "../include/QueueState.hpp"
+#include <fstream>
+
+/**
+ * Constructor - initializes empty index
+ */
+DeploymentIndex::DeploymentIndex() : total(0), deployedOffset(0), releasedOffset(0) {
+}
+
+/**
+ * Destructor - frees all roster nodes
+ */
+DeploymentIndex::~DeploymentIndex() {
+    clear();
+}
+
+/**
+ * Removes every deployment from the index
+ */
+void DeploymentIndex::clear() {
+    bySite.forEach([](const std::string&, const Roster& roster) {
+        DeploymentNode* node = roster.head;
+        while (node != nullptr) {
+            DeploymentNode* next = node->next;
+            delete node;
+            node = next;
+        }
+    });
+    bySite.clear();
+    byContact.clear();
+    total = 0;
+}
+
+/**
+ * Records that a volunteer is now deployed at a site
+ */
+void DeploymentIndex::recordDeployment(const Volunteer& volunteer, const std::string& site, const std::string& deployedAt) {
+    DeploymentNode* node = new DeploymentNode(volunteer, site, deployedAt);
+
+    // Push onto the front of the site roster
+    Roster& roster = bySite[site];
+    node->next = roster.head;
+    if (roster.head != nullptr) {
+        roster.head->prev = node;
+    }
+    roster.head = node;
+    roster.count++;
+
+    // Keep earlier deployments with the same contact reachable
+    DeploymentNode** existing = byContact.find(volunteer.contact);
+    if (existing != nullptr) {
+        node->olderSameContact = *existing;
+        *existing = node;
+    } else {
+        byContact.insert(volunteer.contact, node);
+    }
+    total++;
+}
+
+/**
+ * Looks up the most recent active deployment for a contact
+ */
+const DeploymentNode* DeploymentIndex::find(const std::string& contact) const {
+    DeploymentNode* const* node = byContact.find(contact);
+    return node ? *node : nullptr;
+}
+
+/**
+ * Removes the most recent active deployment for a contact in O(1)
+ */
+bool DeploymentIndex::release(const std::string& contact, DeploymentNode& released) {
+    DeploymentNode** entry = byContact.find(contact);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    DeploymentNode* node = *entry;
+    if (node->olderSameContact != nullptr) {
+        *entry = node->olderSameContact;
+    } else {
+        byContact.erase(contact);
+    }
+
+    // Unlink from the site roster
+    Roster* roster = bySite.find(node->site);
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        roster->head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    }
+    roster->count--;
+    total--;
+
+    released.volunteer = node->volunteer;
+    released.site = node->site;
+    released.deployedAt = node->deployedAt;
+    delete node;
+    return true;
+}
+
+/**
+ * Number of indexed volunteers currently at a site
+ */
+int DeploymentIndex::countAtSite(const std::string& site) const {
+    const Roster* roster = bySite.find(site);
+    return roster ? roster->count : 0;
+}
+
+/**
+ * Number of active deployments under a contact
+ */
+int DeploymentIndex::countForContact(const std::string& contact) const {
+    DeploymentNode* const* entry = byContact.find(contact);
+    int count = 0;
+    for (const DeploymentNode* node = entry ? *entry : nullptr; node != nullptr; node = node->olderSameContact) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Total number of active deployments in the index
+ */
+int DeploymentIndex::size() const {
+    return total;
+}
+
+/**
+ * Rebuilds the index from the deployment and release logs
+ */
+int DeploymentIndex::rebuildFromLogs(const std::string& deployedFile, const std::string& releasedFile) {
+    clear();
+    deployedLog = deployedFile;
+    releasedLog = releasedFile;
+    deployedOffset = 0;
+    releasedOffset = 0;
+    int withoutSite = 0;
+    std::string site, extra;
+    Volunteer volunteer;
+
+    // Archived deployments first, then the ones still in the text log
+    HistoryArchive archive;
+    if (archive.open(archiveFileFor(deployedFile))) {
+        archive.forEachLine([&](const std::string& record) {
+            if (!parseDeploymentRecord(record, volunteer, site, extra)) return;
+            if (site.empty()) {
+                withoutSite++;
+                return;
+            }
+            recordDeployment(volunteer, site, extra);
+        });
+    }
+
+    // Read to the offsets catchUp() continues from; nobody is writing a last
+    // line without its newline at startup, so it counts too
+    CustomArray<std::string> lines;
+    readAppendedLines(deployedFile, deployedOffset, lines, true);
+    for (int i = 0; i < lines.size(); i++) {
+        if (!parseDeploymentRecord(lines[i], volunteer, site, extra)) continue;
+        if (site.empty()) {
+            withoutSite++;
+            continue;
+        }
+        recordDeployment(volunteer, site, extra);
+    }
+
+    DeploymentNode released(volunteer, site);
+    readAppendedLines(releasedFile, releasedOffset, lines, true);
+    for (int i = 0; i < lines.size(); i++) {
+        if (parseDeploymentRecord(lines[i], volunteer, site, extra)) {
+            release(volunteer.contact, released);
+        }
+    }
+
+    return withoutSite;
+}
+
+/**
+ * Applies deployments and releases appended to the logs since they were last read
+ */
+int DeploymentIndex::catchUp(CustomLinkedList<DeploymentNode>& deployed, CustomLinkedList<DeploymentNode>& requeued,
+                             CustomLinkedList<DeploymentNode>& checkedOut) {
+    if (deployedLog.empty()) {
+        return 0;
+    }
+    int applied = 0;
+    std::string site, extra;
+    Volunteer volunteer;
+
+    CustomArray<std::string> lines;
+    readAppendedLines(deployedLog, deployedOffset, lines);
+    for (int i = 0; i < lines.size(); i++) {
+        if (!parseDeploymentRecord(lines[i], volunteer, site, extra) || site.empty()) continue;
+        recordDeployment(volunteer, site, extra);
+        deployed.push_back(DeploymentNode(volunteer, site, extra));
+        applied++;
+    }
+
+    DeploymentNode released(volunteer, site);
+    readAppendedLines(releasedLog, releasedOffset, lines);
+    for (int i = 0; i < lines.size(); i++) {
+        if (!parseDeploymentRecord(lines[i], volunteer, site, extra) || !release(volunteer.contact, released)) {
+            continue;
+        }
+        if (extra == "requeue") {
+            requeued.push_back(released);
+        } else {
+            checkedOut.push_back(released);
+        }
+        applied++;
+    }
+    return applied;
+}
+
+/**
+ * Marks everything now in the logs as already reflected in the index
+ */
+void DeploymentIndex::markCaughtUp() {
+    long long deployedSize = logFileSize(deployedLog);
+    long long releasedSize = logFileSize(releasedLog);
+    deployedOffset = deployedSize < 0 ? 0 : deployedSize;
+    releasedOffset = releasedSize < 0 ? 0 : releasedSize;
+}
+
+/**
+ * Builds a count of active deployments per volunteer
+ */
+void loadActiveDeploymentCounts(CustomHashMap<std::string, int>& counts,
+                                const std::string& deployedFile, const std::string& releasedFile) {
+    counts.clear();
+    std::string line, site, extra;
+    Volunteer volunteer;
+
+    forEachHistoryLine(deployedFile, [&](const std::string& record) {
+        if (parseDeploymentRecord(record, volunteer, site, extra)) {
+            counts[volunteerKey(volunteer)]++;
+        }
+    });
+
+    // Volunteers returned to the queue are waiting again
+    std::ifstream releases(releasedFile);
+    while (releases.is_open() && std::getline(releases, line)) {
+        if (parseDeploymentRecord(line, volunteer, site, extra) && extra == "requeue") {
+            int* count = counts.find(volunteerKey(volunteer));
+            if (count != nullptr && *count > 0) {
+                (*count)--;
+            }
+        }
+    }
+}
+
+/**
+ * Key identifying a volunteer record in the logs
+ */
+std::string volunteerKey(const Volunteer& volunteer) {
+    return volunteer.name + "," + volunteer.contact + "," + volunteer.skill;
+}
+
+/**
+ * Parses a log line of the form name,contact,skill[,site[,extra]]
+ */
+bool parseDeploymentRecord(const std::string& line, Volunteer& volunteer, std::string& site, std::string& extra) {
+    std::string fields[5];
+    int fieldCount = 0;
+    size_t start = 0;
+
+    // The last field keeps any remaining commas
+    while (fieldCount < 4) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string::npos) break;
+        fields[fieldCount++] = line.substr(start, comma - start);
+        start = comma + 1;
+    }
+    fields[fieldCount++] = line.substr(start);
+
+    if (fieldCount < 3) {
+        return false;
+    }
+
+    volunteer.name = trim(fields[0]);
+    volunteer.contact = trim(fields[1]);
+    volunteer.skill = trim(fields[2]);
+    site = trim(fields[3]);
+    extra = trim(fields[4]);
+
+    return !volunteer.name.empty() && !volunteer.contact.empty() && !volunteer.skill.empty();
+}
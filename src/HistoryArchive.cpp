@@ -0,0 +1,958 @@
+#include "../include/HistoryArchive.hpp"
+#include "../include/QueueState.hpp"
+#include "../include/AsyncLogWriter.hpp"
+#include "../include/LiveStats.hpp"
+#include "../include/Prototypes.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+const char* const HistoryArchive::REGISTRATION_SPEC = "RCDRR";
+const char* const HistoryArchive::DEPLOYMENT_SPEC = "RCDDR";
+
+static const char ARCHIVE_MAGIC[4] = { 'V', 'S', 'H', 'A' };
+static const char FOOTER_MAGIC[4] = { 'V', 'S', 'H', 'F' };
+static const char TRAILER_MAGIC[4] = { 'V', 'S', 'H', 'T' };
+static const unsigned char ARCHIVE_VERSION = 1;
+static const int TRAILER_SIZE = 12;       // Footer offset (8) + magic (4)
+static const int BLOOM_BITS_PER_RECORD = 10;
+static const int BLOOM_HASHES = 3;
+
+// ---------------------------------------------------------------------------
+// Varints and fixed-width integers on byte strings
+// ---------------------------------------------------------------------------
+
+static void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+static bool getVarint(const std::string& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        unsigned char byte = (unsigned char)in[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void putString(std::string& out, const std::string& text) {
+    putVarint(out, text.size());
+    out += text;
+}
+
+static bool getString(const std::string& in, size_t& pos, std::string& text) {
+    uint64_t length;
+    if (!getVarint(in, pos, length) || length > in.size() - pos) {
+        return false;
+    }
+    text.assign(in, pos, (size_t)length);
+    pos += (size_t)length;
+    return true;
+}
+
+static void putFixed(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out += (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static uint64_t getFixed(const char* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)(unsigned char)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+// Block compression: byte-oriented LZ77 in the style of LZ4. A block is a
+// series of sequences, each a token (literal length << 4 | match length - 4),
+// the literals, then a 2-byte match offset; a length nibble of 15 continues
+// in following bytes. The last sequence has literals only.
+// ---------------------------------------------------------------------------
+
+static const int LZ_MIN_MATCH = 4;
+static const int LZ_HASH_BITS = 14;
+static const size_t LZ_MAX_OFFSET = 65535;
+
+static uint32_t lzHash(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static void lzPutLength(std::string& out, size_t length) {
+    while (length >= 255) {
+        out += (char)255;
+        length -= 255;
+    }
+    out += (char)length;
+}
+
+static void lzSequence(std::string& out, const char* literals, size_t literalLength,
+                       size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength >= LZ_MIN_MATCH ? matchLength - LZ_MIN_MATCH : 0;
+    unsigned char token = (unsigned char)(((literalLength < 15 ? literalLength : 15) << 4) |
+                                          (matchCode < 15 ? matchCode : 15));
+    out += (char)token;
+    if (literalLength >= 15) lzPutLength(out, literalLength - 15);
+    out.append(literals, literalLength);
+    if (matchLength == 0) {
+        return;  // Final sequence
+    }
+    out += (char)(offset & 0xFF);
+    out += (char)(offset >> 8);
+    if (matchCode >= 15) lzPutLength(out, matchCode - 15);
+}
+
+static void lzCompress(const std::string& in, std::string& out) {
+    out.clear();
+    const char* base = in.data();
+    size_t size = in.size();
+    size_t* table = new size_t[1 << LZ_HASH_BITS];
+    for (int i = 0; i < (1 << LZ_HASH_BITS); i++) {
+        table[i] = (size_t)-1;
+    }
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (size >= LZ_MIN_MATCH && pos <= size - LZ_MIN_MATCH) {
+        uint32_t h = lzHash(base + pos);
+        size_t candidate = table[h];
+        table[h] = pos;
+        if (candidate == (size_t)-1 || pos - candidate > LZ_MAX_OFFSET ||
+            std::memcmp(base + candidate, base + pos, LZ_MIN_MATCH) != 0) {
+            pos++;
+            continue;
+        }
+
+        size_t length = LZ_MIN_MATCH;
+        while (pos + length < size && base[candidate + length] == base[pos + length]) {
+            length++;
+        }
+        lzSequence(out, base + anchor, pos - anchor, pos - candidate, length);
+        pos += length;
+        anchor = pos;
+    }
+    lzSequence(out, base + anchor, size - anchor, 0, 0);
+    delete[] table;
+}
+
+static bool lzReadLength(const std::string& in, size_t& pos, size_t& length) {
+    for (;;) {
+        if (pos >= in.size()) return false;
+        unsigned char byte = (unsigned char)in[pos++];
+        length += byte;
+        if (byte != 255) return true;
+    }
+}
+
+static bool lzDecompress(const std::string& in, size_t rawSize, std::string& out) {
+    out.clear();
+    out.reserve(rawSize);
+    size_t pos = 0;
+    while (pos < in.size()) {
+        unsigned char token = (unsigned char)in[pos++];
+        size_t literals = token >> 4;
+        if (literals == 15 && !lzReadLength(in, pos, literals)) return false;
+        if (literals > in.size() - pos || out.size() + literals > rawSize) return false;
+        out.append(in, pos, literals);
+        pos += literals;
+        if (pos == in.size()) break;
+
+        if (in.size() - pos < 2) return false;
+        size_t offset = (unsigned char)in[pos] | ((size_t)(unsigned char)in[pos + 1] << 8);
+        pos += 2;
+        size_t length = token & 0x0F;
+        if (length == 15 && !lzReadLength(in, pos, length)) return false;
+        length += LZ_MIN_MATCH;
+        if (offset == 0 || offset > out.size() || out.size() + length > rawSize) return false;
+
+        // Byte by byte, since a match may overlap the bytes it produces
+        size_t from = out.size() - offset;
+        for (size_t i = 0; i < length; i++) {
+            out += out[from + i];
+        }
+    }
+    return out.size() == rawSize;
+}
+
+// ---------------------------------------------------------------------------
+// Record coding
+// ---------------------------------------------------------------------------
+
+static uint64_t fnv64(const std::string& text) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < text.size(); i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void bloomAdd(CustomArray<uint64_t>& bloom, const std::string& contact) {
+    uint64_t hash = fnv64(contact);
+    uint64_t step = (hash >> 33) | 1;
+    uint64_t bits = (uint64_t)bloom.size() * 64;
+    for (int i = 0; i < BLOOM_HASHES; i++) {
+        uint64_t bit = (hash + i * step) % bits;
+        bloom[(int)(bit / 64)] |= 1ULL << (bit % 64);
+    }
+}
+
+static bool bloomTest(const CustomArray<uint64_t>& bloom, const std::string& contact) {
+    if (bloom.empty()) {
+        return true;
+    }
+    uint64_t hash = fnv64(contact);
+    uint64_t step = (hash >> 33) | 1;
+    uint64_t bits = (uint64_t)bloom.size() * 64;
+    for (int i = 0; i < BLOOM_HASHES; i++) {
+        uint64_t bit = (hash + i * step) % bits;
+        if ((bloom[(int)(bit / 64)] & (1ULL << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Dictionary being extended while blocks are written
+ */
+struct ArchiveDictionary {
+    CustomArray<std::string> entries;
+    CustomHashMap<std::string, uint32_t> ids;
+
+    uint32_t idFor(const std::string& text) {
+        const uint32_t* id = ids.find(text);
+        if (id != nullptr) {
+            return *id;
+        }
+        uint32_t next = (uint32_t)entries.size();
+        entries.push_back(text);
+        ids.insert(text, next);
+        return next;
+    }
+};
+
+/**
+ * Splits a log line on commas (CSV without quoting, as the logs are written)
+ */
+static void splitLine(const std::string& line, CustomArray<std::string>& fields) {
+    fields.clear();
+    size_t start = 0;
+    for (;;) {
+        size_t comma = line.find(',', start);
+        fields.push_back(line.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+}
+
+static char columnCode(const std::string& spec, int column) {
+    return column < (int)spec.size() ? spec[column] : 'R';
+}
+
+/**
+ * Appends one encoded record to a block and updates the block's index entry
+ */
+static void encodeRecord(const std::string& line, const std::string& spec, ArchiveDictionary& dictionary,
+                         CustomHashMap<uint32_t, uint32_t>& skills, std::string& out,
+                         HistoryArchive::BlockInfo& info) {
+    CustomArray<std::string> fields;
+    splitLine(line, fields);
+    putVarint(out, fields.size());
+
+    for (int i = 0; i < fields.size(); i++) {
+        const std::string& field = fields[i];
+        switch (columnCode(spec, i)) {
+            case 'D': {
+                uint32_t id = dictionary.idFor(field);
+                putVarint(out, id);
+                if (i == 2) skills[id]++;
+                break;
+            }
+            case 'C': {
+                // Keyed like lookups, which trim the contact (see parseDeploymentRecord)
+                bloomAdd(info.bloom, trim(field));
+                size_t at = field.rfind('@');
+                if (at == std::string::npos) {
+                    putVarint(out, 0);
+                    putString(out, field);
+                } else {
+                    // Local part length + 1, so 0 can mean "no domain"
+                    putVarint(out, at + 1);
+                    out.append(field, 0, at);
+                    putVarint(out, dictionary.idFor(field.substr(at + 1)));
+                }
+                break;
+            }
+            default:
+                putString(out, field);
+                break;
+        }
+    }
+}
+
+/**
+ * Decodes one block of records back into lines
+ */
+bool HistoryArchive::decodeBlock(const std::string& raw, uint32_t expected, CustomArray<std::string>& lines) const {
+    lines.clear();
+    lines.reserve((int)expected);
+    size_t pos = 0;
+    std::string field;
+    for (uint32_t r = 0; r < expected; r++) {
+        uint64_t fieldCount;
+        if (!getVarint(raw, pos, fieldCount) || fieldCount == 0 || fieldCount > raw.size()) {
+            return false;
+        }
+        std::string line;
+        for (uint64_t i = 0; i < fieldCount; i++) {
+            if (i > 0) line += ',';
+            uint64_t value;
+            switch (columnCode(spec, (int)i)) {
+                case 'D':
+                    if (!getVarint(raw, pos, value) || value >= (uint64_t)dictionary.size()) return false;
+                    line += dictionary[(int)value];
+                    break;
+                case 'C':
+                    if (!getVarint(raw, pos, value)) return false;
+                    if (value == 0) {
+                        if (!getString(raw, pos, field)) return false;
+                        line += field;
+                    } else {
+                        size_t localLength = (size_t)value - 1;
+                        if (localLength > raw.size() - pos) return false;
+                        line.append(raw, pos, localLength);
+                        pos += localLength;
+                        if (!getVarint(raw, pos, value) || value >= (uint64_t)dictionary.size()) return false;
+                        line += '@';
+                        line += dictionary[(int)value];
+                    }
+                    break;
+                default:
+                    if (!getString(raw, pos, field)) return false;
+                    line += field;
+                    break;
+            }
+        }
+        lines.push_back(line);
+    }
+    return pos == raw.size();
+}
+
+// ---------------------------------------------------------------------------
+// HistoryArchive
+// ---------------------------------------------------------------------------
+
+/**
+ * Constructor - initializes a closed archive
+ */
+HistoryArchive::HistoryArchive() : records(0), footerOffset(0) {
+}
+
+void HistoryArchive::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    path.clear();
+    spec.clear();
+    dictionary.clear();
+    blocks.clear();
+    records = 0;
+    footerOffset = 0;
+}
+
+/**
+ * Reads the header, dictionary and block index
+ */
+bool HistoryArchive::open(const std::string& filename) {
+    close();
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Header
+    char magic[4];
+    char version = 0;
+    if (!file.read(magic, 4) || std::memcmp(magic, ARCHIVE_MAGIC, 4) != 0 ||
+        !file.get(version) || (unsigned char)version != ARCHIVE_VERSION) {
+        close();
+        return false;
+    }
+    std::string head(64, '\0');
+    file.read(&head[0], (std::streamsize)head.size());
+    head.resize((size_t)file.gcount());
+    size_t pos = 0;
+    if (!getString(head, pos, spec)) {
+        close();
+        return false;
+    }
+    file.clear();
+
+    // Trailer, then footer
+    file.seekg(0, std::ios::end);
+    long long size = (long long)file.tellg();
+    char trailer[TRAILER_SIZE];
+    if (size < 5 + TRAILER_SIZE || !file.seekg(size - TRAILER_SIZE) || !file.read(trailer, TRAILER_SIZE) ||
+        std::memcmp(trailer + 8, TRAILER_MAGIC, 4) != 0) {
+        close();
+        return false;
+    }
+    footerOffset = getFixed(trailer, 8);
+    if ((long long)footerOffset > size - TRAILER_SIZE) {
+        close();
+        return false;
+    }
+    std::string footer((size_t)(size - TRAILER_SIZE - (long long)footerOffset), '\0');
+    file.seekg((std::streamoff)footerOffset);
+    if (!file.read(&footer[0], (std::streamsize)footer.size()) ||
+        footer.size() < 4 || std::memcmp(footer.data(), FOOTER_MAGIC, 4) != 0) {
+        close();
+        return false;
+    }
+
+    pos = 4;
+    uint64_t count;
+    bool ok = getVarint(footer, pos, count);
+    for (uint64_t i = 0; ok && i < count; i++) {
+        std::string entry;
+        ok = getString(footer, pos, entry);
+        dictionary.push_back(entry);
+    }
+    ok = ok && getVarint(footer, pos, count);
+    for (uint64_t b = 0; ok && b < count; b++) {
+        BlockInfo info;
+        uint64_t compressedSize, rawSize, blockRecords, words, skillCount;
+        ok = getVarint(footer, pos, info.offset) && getVarint(footer, pos, compressedSize) &&
+             getVarint(footer, pos, rawSize) && getVarint(footer, pos, blockRecords) &&
+             getVarint(footer, pos, words) && words <= (footer.size() - pos) / 8;
+        for (uint64_t w = 0; ok && w < words; w++) {
+            info.bloom.push_back(getFixed(footer.data() + pos, 8));
+            pos += 8;
+        }
+        ok = ok && getVarint(footer, pos, skillCount);
+        for (uint64_t s = 0; ok && s < skillCount; s++) {
+            uint64_t id = 0, n = 0;
+            ok = getVarint(footer, pos, id) && getVarint(footer, pos, n) && id < (uint64_t)dictionary.size();
+            info.skillIds.push_back((uint32_t)id);
+            info.skillCounts.push_back((uint32_t)n);
+        }
+        info.compressedSize = (uint32_t)compressedSize;
+        info.rawSize = (uint32_t)rawSize;
+        info.records = (uint32_t)blockRecords;
+        ok = ok && info.offset + info.compressedSize <= footerOffset;
+        if (ok) {
+            records += info.records;
+            blocks.push_back(info);
+        }
+    }
+    if (!ok) {
+        close();
+        return false;
+    }
+
+    path = filename;
+    return true;
+}
+
+long long HistoryArchive::compressedBytes() const {
+    long long total = 0;
+    for (int b = 0; b < blocks.size(); b++) {
+        total += blocks[b].compressedSize;
+    }
+    return total;
+}
+
+long long HistoryArchive::rawBytes() const {
+    long long total = 0;
+    for (int b = 0; b < blocks.size(); b++) {
+        total += blocks[b].rawSize;
+    }
+    return total;
+}
+
+/**
+ * Decompresses one block into its lines
+ */
+bool HistoryArchive::readBlock(int block, CustomArray<std::string>& lines) const {
+    lines.clear();
+    const BlockInfo& info = blocks[block];
+    std::string compressed(info.compressedSize, '\0');
+    file.clear();
+    file.seekg((std::streamoff)info.offset);
+    if (!file.read(&compressed[0], (std::streamsize)compressed.size())) {
+        return false;
+    }
+    std::string raw;
+    return lzDecompress(compressed, info.rawSize, raw) && decodeBlock(raw, info.records, lines);
+}
+
+/**
+ * Whether a block may contain records with this contact
+ */
+bool HistoryArchive::mayContainContact(int block, const std::string& contact) const {
+    return bloomTest(blocks[block].bloom, contact);
+}
+
+/**
+ * Adds up the per-block skill counts without decompressing anything
+ */
+void HistoryArchive::skillTotals(CustomHashMap<std::string, long long>& totals) const {
+    for (int b = 0; b < blocks.size(); b++) {
+        const BlockInfo& info = blocks[b];
+        for (int s = 0; s < info.skillIds.size(); s++) {
+            totals[dictionary[(int)info.skillIds[s]]] += info.skillCounts[s];
+        }
+    }
+}
+
+/**
+ * Writes the archive with the existing blocks followed by new blocks of lines
+ */
+bool HistoryArchive::writeWithAppended(const std::string& filename, const std::string& columnSpec,
+                                       const CustomArray<std::string>& lines, int blockRecords,
+                                       std::string& tempName, std::string& error) {
+    if (blockRecords <= 0) {
+        blockRecords = DEFAULT_BLOCK_RECORDS;
+    }
+
+    HistoryArchive existing;
+    bool hasExisting = existing.open(filename);
+    if (!hasExisting && logFileSize(filename) > 0) {
+        error = "existing archive '" + filename + "' is not readable";
+        return false;
+    }
+    if (hasExisting && existing.spec != columnSpec) {
+        error = "existing archive '" + filename + "' uses a different column layout";
+        return false;
+    }
+
+    ArchiveDictionary dictionary;
+    CustomArray<BlockInfo> index;
+    if (hasExisting) {
+        for (int i = 0; i < existing.dictionary.size(); i++) {
+            dictionary.idFor(existing.dictionary[i]);
+        }
+    }
+
+    tempName = filename + ".tmp";
+    std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        error = "cannot create '" + tempName + "'";
+        return false;
+    }
+
+    std::string header(ARCHIVE_MAGIC, 4);
+    header += (char)ARCHIVE_VERSION;
+    putString(header, columnSpec);
+    out.write(header.data(), (std::streamsize)header.size());
+    uint64_t offset = header.size();
+
+    // Old blocks are copied as they are
+    for (int b = 0; hasExisting && b < existing.blocks.size(); b++) {
+        BlockInfo info = existing.blocks[b];
+        std::string compressed(info.compressedSize, '\0');
+        existing.file.clear();
+        existing.file.seekg((std::streamoff)info.offset);
+        if (!existing.file.read(&compressed[0], (std::streamsize)compressed.size())) {
+            error = "cannot read block " + std::to_string(b) + " of '" + filename + "'";
+            out.close();
+            std::remove(tempName.c_str());
+            return false;
+        }
+        out.write(compressed.data(), (std::streamsize)compressed.size());
+        info.offset = offset;
+        offset += compressed.size();
+        index.push_back(info);
+    }
+
+    // New blocks
+    std::string raw, compressed;
+    for (int first = 0; first < lines.size(); first += blockRecords) {
+        int last = first + blockRecords < lines.size() ? first + blockRecords : lines.size();
+        BlockInfo info;
+        int words = ((last - first) * BLOOM_BITS_PER_RECORD + 63) / 64;
+        for (int w = 0; w < words; w++) {
+            info.bloom.push_back(0);
+        }
+        CustomHashMap<uint32_t, uint32_t> skills;
+        raw.clear();
+        for (int i = first; i < last; i++) {
+            encodeRecord(lines[i], columnSpec, dictionary, skills, raw, info);
+        }
+        skills.forEach([&info](const uint32_t& id, const uint32_t& count) {
+            info.skillIds.push_back(id);
+            info.skillCounts.push_back(count);
+        });
+
+        lzCompress(raw, compressed);
+        info.offset = offset;
+        info.compressedSize = (uint32_t)compressed.size();
+        info.rawSize = (uint32_t)raw.size();
+        info.records = (uint32_t)(last - first);
+        out.write(compressed.data(), (std::streamsize)compressed.size());
+        offset += compressed.size();
+        index.push_back(info);
+    }
+
+    // Footer: dictionary, block index, then the trailer pointing back at it
+    std::string footer(FOOTER_MAGIC, 4);
+    putVarint(footer, dictionary.entries.size());
+    for (int i = 0; i < dictionary.entries.size(); i++) {
+        putString(footer, dictionary.entries[i]);
+    }
+    putVarint(footer, index.size());
+    for (int b = 0; b < index.size(); b++) {
+        const BlockInfo& info = index[b];
+        putVarint(footer, info.offset);
+        putVarint(footer, info.compressedSize);
+        putVarint(footer, info.rawSize);
+        putVarint(footer, info.records);
+        putVarint(footer, info.bloom.size());
+        for (int w = 0; w < info.bloom.size(); w++) {
+            putFixed(footer, info.bloom[w], 8);
+        }
+        putVarint(footer, info.skillIds.size());
+        for (int s = 0; s < info.skillIds.size(); s++) {
+            putVarint(footer, info.skillIds[s]);
+            putVarint(footer, info.skillCounts[s]);
+        }
+    }
+    putFixed(footer, offset, 8);
+    footer.append(TRAILER_MAGIC, 4);
+    out.write(footer.data(), (std::streamsize)footer.size());
+
+    out.close();
+    if (out.fail()) {
+        error = "write to '" + tempName + "' failed";
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Archive file that holds the cold history of a text log
+ */
+std::string archiveFileFor(const std::string& logFile) {
+    size_t dot = logFile.rfind('.');
+    size_t slash = logFile.rfind('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return logFile + ".archive";
+    }
+    return logFile.substr(0, dot) + ".archive";
+}
+
+// ---------------------------------------------------------------------------
+// Archive mode
+// ---------------------------------------------------------------------------
+
+/**
+ * Reads the complete, non-empty lines in [0, limit) of a text log
+ * @param limit Byte limit, or -1 for the whole file; lowered to the end of
+ *              the last complete line
+ */
+static bool readArchivableLines(const std::string& filename, long long& limit, CustomArray<std::string>& lines) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        limit = 0;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (limit < 0 || limit > (long long)data.size()) {
+        limit = (long long)data.size();
+    }
+    size_t end = limit > 0 ? data.rfind('\n', (size_t)limit - 1) : std::string::npos;
+    limit = end == std::string::npos ? 0 : (long long)end + 1;
+
+    size_t start = 0;
+    while ((long long)start < limit) {
+        size_t newline = data.find('\n', start);
+        std::string line = data.substr(start, newline - start);
+        size_t first = line.find_first_not_of(" \t\r\n");
+        if (first != std::string::npos) {
+            size_t last = line.find_last_not_of(" \t\r\n");
+            lines.push_back(line.substr(first, last - first + 1));
+        }
+        start = newline + 1;
+    }
+    return true;
+}
+
+/**
+ * Rewrites a text log without its first `bytes` bytes
+ */
+static bool dropLogPrefix(const std::string& filename, long long bytes, std::string& tempName) {
+    std::ifstream in(filename, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    tempName = filename + ".tmp";
+    std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+    out.write(data.data() + bytes, (std::streamsize)(data.size() - (size_t)bytes));
+    out.close();
+    if (out.fail()) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Replaces a file with its freshly written temporary copy
+ */
+static bool replaceFile(const std::string& tempName, const std::string& filename) {
+    std::remove(filename.c_str());
+    return std::rename(tempName.c_str(), filename.c_str()) == 0;
+}
+
+/**
+ * One log's share of an archive run, written to temporary files
+ */
+struct ArchiveStep {
+    std::string logFile;
+    std::string archiveFile;
+    std::string archiveTemp;
+    std::string logTemp;
+    long long droppedBytes;   // Log prefix moved into the archive
+    long long records;        // Records moved
+    long long archiveBefore;  // Archive records before the run
+
+    ArchiveStep() : droppedBytes(0), records(0), archiveBefore(0) {}
+};
+
+/**
+ * Writes the new archive and the shortened log of one log next to the
+ * originals, leaving both originals untouched
+ * @return false on failure (nothing to archive is not a failure)
+ */
+static bool prepareArchiveStep(const std::string& logFile, const std::string& spec, long long limit,
+                               int blockRecords, ArchiveStep& step) {
+    step.logFile = logFile;
+    step.archiveFile = archiveFileFor(logFile);
+    HistoryArchive existing;
+    step.archiveBefore = existing.open(step.archiveFile) ? existing.recordCount() : 0;
+    existing.close();
+
+    CustomArray<std::string> lines;
+    if (!readArchivableLines(logFile, limit, lines) || limit == 0) {
+        std::cout << logFile << ": nothing to archive.\n";
+        return true;
+    }
+
+    std::string error;
+    if (!HistoryArchive::writeWithAppended(step.archiveFile, spec, lines, blockRecords, step.archiveTemp, error)) {
+        std::cout << "Error: Could not archive " << logFile << ": " << error << "\n";
+        return false;
+    }
+    if (!dropLogPrefix(logFile, limit, step.logTemp)) {
+        std::remove(step.archiveTemp.c_str());
+        std::cout << "Error: Could not rewrite " << logFile << "\n";
+        return false;
+    }
+    step.droppedBytes = limit;
+    step.records = lines.size();
+    return true;
+}
+
+/**
+ * Prints what an applied step did
+ */
+static void printArchiveStep(const ArchiveStep& step) {
+    HistoryArchive archive;
+    archive.open(step.archiveFile);
+    std::cout << step.logFile << ": archived " << step.records << " records (" << step.droppedBytes << " bytes) -> "
+              << step.archiveFile << ", now " << archive.recordCount() << " records in "
+              << archive.blockCount() << " blocks, " << logFileSize(step.archiveFile) << " bytes ("
+              << std::fixed << std::setprecision(1)
+              << (archive.compressedBytes() > 0 ? (double)archive.rawBytes() / archive.compressedBytes() : 0.0)
+              << "x block compression)\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+/**
+ * Completes the run a journal describes. Every entry is idempotent (renames
+ * of temporaries that still exist, absolute cursor values, stats moves that
+ * check the archive counts they expect), so a run cut short at any point is
+ * finished by applying its journal again.
+ */
+static bool applyArchiveJournal(const std::string& journalFile) {
+    std::ifstream in(journalFile);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line) || line != "VARCHIVE 1") {
+        return false;
+    }
+
+    bool ok = true;
+    while (std::getline(in, line)) {
+        CustomArray<std::string> fields;
+        size_t start = 0;
+        for (;;) {
+            size_t tab = line.find('\t', start);
+            fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+            if (tab == std::string::npos) break;
+            start = tab + 1;
+        }
+
+        if (fields[0] == "rename" && fields.size() == 3) {
+            if (logFileSize(fields[1]) >= 0 && !replaceFile(fields[1], fields[2])) {
+                std::cout << "Error: Could not move " << fields[1] << " to " << fields[2] << ".\n";
+                ok = false;
+            }
+        } else if (fields[0] == "queue-cursor" && fields.size() == 5) {
+            QueueCursor cursor(std::atoll(fields[2].c_str()), std::atoll(fields[3].c_str()),
+                               std::atoll(fields[4].c_str()));
+            if (!rewriteQueueCursor(fields[1], cursor)) {
+                std::cout << "Warning: Could not update " << fields[1] << "; the queue will be rebuilt at startup.\n";
+            }
+        } else if (fields[0] == "stats" && fields.size() == 6) {
+            if (!LiveStats::moveCursorPastArchived(fields[1], (LiveStats::LogKind)std::atoi(fields[2].c_str()),
+                                                   std::atoll(fields[3].c_str()), std::atoll(fields[4].c_str()),
+                                                   std::atoll(fields[5].c_str())) &&
+                logFileSize(fields[1]) >= 0) {
+                std::cout << "Note: " << fields[1] << " did not cover the archived records; "
+                          << "live statistics will be rebuilt at startup.\n";
+            }
+        } else {
+            ok = false;
+        }
+    }
+    in.close();
+    if (ok) {
+        std::remove(journalFile.c_str());
+    }
+    return ok;
+}
+
+/**
+ * Completes an archive run that stopped after committing its journal
+ */
+bool finishArchiveRun(const std::string& journalFile) {
+    if (logFileSize(journalFile) < 0) {
+        return false;
+    }
+    std::cout << "Note: Completing an interrupted history archive run.\n";
+    if (!applyArchiveJournal(journalFile)) {
+        std::cout << "Error: Could not complete " << journalFile << "; run --archive-history again.\n";
+    }
+    return true;
+}
+
+/**
+ * Prints command-line help for archive mode
+ */
+static void printArchiveUsage() {
+    std::cout << "Usage: volunteer_system --archive-history [--block N]\n"
+              << "  Moves the registration and deployment logs into compressed archives.\n"
+              << "  Run it while no other instance is using the data directory.\n"
+              << "  --block N   Records per archive block (default "
+              << HistoryArchive::DEFAULT_BLOCK_RECORDS << ")\n";
+}
+
+/**
+ * Entry point for "--archive-history" mode
+ */
+int runArchiveMode(int argc, char* argv[]) {
+    int blockRecords = HistoryArchive::DEFAULT_BLOCK_RECORDS;
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--block" && i + 1 < argc) {
+            blockRecords = std::atoi(argv[++i]);
+        } else {
+            printArchiveUsage();
+            return option == "--help" ? 0 : 1;
+        }
+    }
+    if (blockRecords <= 0) {
+        std::cout << "Error: Block size must be positive.\n";
+        return 1;
+    }
+
+    const std::string stateFile = "../data/queue_state.dat";
+    const std::string volunteersFile = "../data/volunteers.txt";
+    const std::string deployedFile = "../data/deployed_volunteers.txt";
+    const std::string releasedFile = "../data/released_volunteers.txt";
+
+    // A usable saved queue already reflects registrations up to its cursor; only
+    // those are archived, so the ones after it are still read at startup.
+    // Without one, the queue is rebuilt from archive and log alike.
+    QueueCursor cursor;
+    long long deployedSize = logFileSize(deployedFile);
+    long long releasedSize = logFileSize(releasedFile);
+    bool stateUsable = readQueueCursor(stateFile, cursor) &&
+                       cursor.deployedOffset == (deployedSize < 0 ? 0 : deployedSize) &&
+                       cursor.releasedOffset == (releasedSize < 0 ? 0 : releasedSize) &&
+                       cursor.registrationOffset <= logFileSize(volunteersFile);
+
+    // Both logs are prepared next to the originals first; nothing is replaced yet
+    ArchiveStep steps[2];
+    if (!prepareArchiveStep(volunteersFile, HistoryArchive::REGISTRATION_SPEC,
+                            stateUsable ? cursor.registrationOffset : -1, blockRecords, steps[0]) ||
+        !prepareArchiveStep(deployedFile, HistoryArchive::DEPLOYMENT_SPEC, -1, blockRecords, steps[1])) {
+        for (int i = 0; i < 2; i++) {
+            if (!steps[i].archiveTemp.empty()) std::remove(steps[i].archiveTemp.c_str());
+            if (!steps[i].logTemp.empty()) std::remove(steps[i].logTemp.c_str());
+        }
+        return 1;
+    }
+    if (steps[0].records == 0 && steps[1].records == 0) {
+        return 0;
+    }
+
+    // The journal lists every change of the run. Once it is in place the run
+    // counts as done: if it stops before the end, the next start applies the
+    // journal again, so a record is never left in both an archive and its log.
+    // Saved live statistics keep covering the records that moved.
+    std::string journalTemp = std::string(ARCHIVE_JOURNAL_FILE) + ".tmp";
+    std::ofstream journal(journalTemp, std::ios::trunc);
+    journal << "VARCHIVE 1\n";
+    for (int i = 0; i < 2; i++) {
+        if (steps[i].records == 0) continue;
+        journal << "rename\t" << steps[i].archiveTemp << '\t' << steps[i].archiveFile << '\n';
+        journal << "rename\t" << steps[i].logTemp << '\t' << steps[i].logFile << '\n';
+    }
+    if (stateUsable) {
+        journal << "queue-cursor\t" << stateFile << '\t' << cursor.registrationOffset - steps[0].droppedBytes
+                << '\t' << cursor.deployedOffset - steps[1].droppedBytes << '\t' << cursor.releasedOffset << '\n';
+    }
+    const std::string statsFile = "../data/live_stats.dat";
+    for (int log = LiveStats::REGISTRATION_LOG; log <= LiveStats::DEPLOYMENT_LOG; log++) {
+        if (steps[log].records == 0) continue;
+        journal << "stats\t" << statsFile << '\t' << log << '\t' << steps[log].droppedBytes << '\t'
+                << steps[log].archiveBefore << '\t' << steps[log].archiveBefore + steps[log].records << '\n';
+    }
+    journal.close();
+    if (journal.fail() || std::rename(journalTemp.c_str(), ARCHIVE_JOURNAL_FILE) != 0) {
+        std::cout << "Error: Could not write " << ARCHIVE_JOURNAL_FILE << "; nothing was archived.\n";
+        std::remove(journalTemp.c_str());
+        for (int i = 0; i < 2; i++) {
+            std::remove(steps[i].archiveTemp.c_str());
+            std::remove(steps[i].logTemp.c_str());
+        }
+        return 1;
+    }
+
+    if (!applyArchiveJournal(ARCHIVE_JOURNAL_FILE)) {
+        std::cout << "Error: Could not finish the archive run; it is completed at the next start.\n";
+        return 1;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (steps[i].records > 0) {
+            printArchiveStep(steps[i]);
+        }
+    }
+    return 0;
+}
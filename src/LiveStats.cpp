@@ -0,0 +1,333 @@
+#include "../include/LiveStats.hpp"
+#include "../include/Prototypes.hpp"
+#include "../include/HistoryArchive.hpp"
+#include "../include/QueueState.hpp"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+
+static const char* const LIVE_STATS_HEADER = "VSTATS 1";
+
+/**
+ * Archived record count of a log (0 without an archive)
+ */
+static long long archivedRecords(const std::string& logFile) {
+    HistoryArchive archive;
+    return archive.open(archiveFileFor(logFile)) ? archive.recordCount() : 0;
+}
+
+/**
+ * Writes one "tag name count" row per entry of a per-skill or per-site total
+ */
+static void writeCounts(std::ofstream& out, const char* tag, const CustomHashMap<std::string, long long>& counts) {
+    counts.forEach([&](const std::string& name, long long count) {
+        out << tag << '\t' << name << '\t' << count << '\n';
+    });
+}
+
+/**
+ * Constructor - totals over the given logs (not read until load)
+ */
+LiveStats::LiveStats(const std::string& registrationLog, const std::string& deploymentLog,
+                     const std::string& releaseLog)
+    : loaded(false) {
+    logs[REGISTRATION_LOG] = registrationLog;
+    logs[DEPLOYMENT_LOG] = deploymentLog;
+    logs[RELEASE_LOG] = releaseLog;
+    for (int i = 0; i < LOG_COUNT; i++) {
+        cursor[i] = pending[i] = 0;
+        unterminated[i] = false;
+    }
+    archived[0] = archived[1] = 0;
+}
+
+/**
+ * Updates the totals with one log line
+ */
+void LiveStats::fold(Totals& totals, LogKind log, const std::string& line) {
+    std::string record = trim(line);
+    if (record.empty()) {
+        return;
+    }
+
+    Volunteer volunteer;
+    std::string site, extra;
+    if (log == REGISTRATION_LOG) {
+        if (parseVolunteerRecord(record, volunteer)) {
+            totals.registered++;
+            totals.registeredBySkill[volunteer.skill]++;
+        }
+    } else if (parseDeploymentRecord(record, volunteer, site, extra)) {
+        if (log == DEPLOYMENT_LOG) {
+            totals.deployed++;
+            totals.deployedBySkill[volunteer.skill]++;
+            if (!site.empty()) {
+                totals.deployedBySite[site]++;
+            }
+        } else {
+            totals.released++;
+            if (extra == "requeue") {
+                totals.requeued++;
+            }
+            if (!site.empty()) {
+                totals.releasedBySite[site]++;
+            }
+        }
+    }
+}
+
+/**
+ * Reads a stats file into base, cursor and archived
+ */
+bool LiveStats::readFile(const std::string& filename) {
+    std::ifstream in(filename);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line) || line != LIVE_STATS_HEADER) {
+        return false;
+    }
+
+    Totals read;
+    bool haveCursor = false, haveArchived = false, haveTotals = false;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        size_t tab = line.find('\t');
+        std::string tag = line.substr(0, tab);
+        std::string rest = tab == std::string::npos ? "" : line.substr(tab + 1);
+
+        // Per-skill and per-site rows: the name runs up to the last tab
+        CustomHashMap<std::string, long long>* counts = nullptr;
+        if (tag == "registered-skill") counts = &read.registeredBySkill;
+        else if (tag == "deployed-skill") counts = &read.deployedBySkill;
+        else if (tag == "deployed-site") counts = &read.deployedBySite;
+        else if (tag == "released-site") counts = &read.releasedBySite;
+        if (counts != nullptr) {
+            size_t last = rest.rfind('\t');
+            if (last == std::string::npos) return false;
+            (*counts)[rest.substr(0, last)] = std::atoll(rest.c_str() + last + 1);
+            continue;
+        }
+
+        std::istringstream fields(rest);
+        if (tag == "cursor") {
+            haveCursor = bool(fields >> cursor[REGISTRATION_LOG] >> cursor[DEPLOYMENT_LOG] >> cursor[RELEASE_LOG]);
+        } else if (tag == "archived") {
+            haveArchived = bool(fields >> archived[0] >> archived[1]);
+        } else if (tag == "totals") {
+            haveTotals = bool(fields >> read.registered >> read.deployed >> read.released >> read.requeued);
+        } else {
+            return false;
+        }
+    }
+    if (!haveCursor || !haveArchived || !haveTotals) {
+        return false;
+    }
+    base = read;
+    return true;
+}
+
+/**
+ * Writes totals with a cursor and archive counts through a temporary file
+ */
+static bool writeStatsFile(const std::string& filename, const LiveStats::Totals& totals,
+                           const long long* logBytes, const long long* archivedCounts) {
+    std::string tempFile = filename + ".tmp";
+    std::ofstream out(tempFile, std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << LIVE_STATS_HEADER << '\n';
+    out << "cursor\t" << logBytes[LiveStats::REGISTRATION_LOG] << '\t' << logBytes[LiveStats::DEPLOYMENT_LOG]
+        << '\t' << logBytes[LiveStats::RELEASE_LOG] << '\n';
+    out << "archived\t" << archivedCounts[0] << '\t' << archivedCounts[1] << '\n';
+    out << "totals\t" << totals.registered << '\t' << totals.deployed << '\t' << totals.released
+        << '\t' << totals.requeued << '\n';
+    writeCounts(out, "registered-skill", totals.registeredBySkill);
+    writeCounts(out, "deployed-skill", totals.deployedBySkill);
+    writeCounts(out, "deployed-site", totals.deployedBySite);
+    writeCounts(out, "released-site", totals.releasedBySite);
+    out.close();
+
+    if (out.fail() || std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+        std::remove(tempFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Whether a log's last byte is something other than a newline
+ */
+static bool lacksFinalNewline(const std::string& logFile) {
+    std::ifstream in(logFile, std::ios::binary);
+    char last;
+    return in.is_open() && in.seekg(-1, std::ios::end) && in.get(last) && last != '\n';
+}
+
+/**
+ * Folds the lines of a log from the cursor on into base
+ */
+bool LiveStats::foldTail(LogKind log, bool includeUnterminated) {
+    long long size = logFileSize(logs[log]);
+    if (size < 0) size = 0;
+    if (size < cursor[log]) {
+        return false;
+    }
+    if (size == cursor[log]) {
+        return true;
+    }
+
+    std::ifstream in(logs[log], std::ios::binary);
+    in.seekg(cursor[log]);
+    std::string line;
+    while (std::getline(in, line)) {
+        bool terminated = !in.eof();
+        if (!terminated && !includeUnterminated) {
+            break;  // Still being written; it is read next time
+        }
+        fold(base, log, line);
+        cursor[log] += (long long)line.size() + (terminated ? 1 : 0);
+    }
+    return true;
+}
+
+/**
+ * Notes which logs end in a record without its newline at the cursor; the
+ * log writer puts one in front of the next record it appends there
+ */
+void LiveStats::noteUnterminatedEnds() {
+    for (int log = 0; log < LOG_COUNT; log++) {
+        unterminated[log] = cursor[log] > 0 && cursor[log] == logFileSize(logs[log]) && lacksFinalNewline(logs[log]);
+    }
+}
+
+/**
+ * Rebuilds base from the archives and the whole text logs
+ */
+void LiveStats::rebuild(bool includeUnterminated) {
+    base = Totals();
+    for (int i = 0; i < LOG_COUNT; i++) {
+        cursor[i] = 0;
+    }
+
+    for (int log = REGISTRATION_LOG; log <= DEPLOYMENT_LOG; log++) {
+        HistoryArchive archive;
+        archived[log] = 0;
+        if (archive.open(archiveFileFor(logs[log]))) {
+            archived[log] = archive.recordCount();
+            archive.forEachLine([this, log](const std::string& line) {
+                fold(base, (LogKind)log, line);
+            });
+        }
+    }
+    for (int log = 0; log < LOG_COUNT; log++) {
+        foldTail((LogKind)log, includeUnterminated);
+    }
+}
+
+/**
+ * Restores saved totals and catches up with the logs, or rebuilds them
+ */
+long long LiveStats::load(const std::string& filename) {
+    // Saved totals are only usable if they cover the archives as they are now
+    // and each log still reaches their cursor
+    bool usable = readFile(filename) &&
+                  archived[0] == archivedRecords(logs[REGISTRATION_LOG]) &&
+                  archived[1] == archivedRecords(logs[DEPLOYMENT_LOG]);
+    for (int log = 0; usable && log < LOG_COUNT; log++) {
+        usable = cursor[log] <= logFileSize(logs[log]) || cursor[log] == 0;
+    }
+
+    long long before = usable ? base.registered + base.deployed + base.released : 0;
+    // Nothing is writing yet, so a last line without its newline is a
+    // complete record (the startup loader queues it too)
+    if (usable) {
+        for (int log = 0; log < LOG_COUNT; log++) {
+            foldTail((LogKind)log, true);
+        }
+    } else {
+        rebuild(true);
+    }
+    noteUnterminatedEnds();
+
+    current = base;
+    for (int i = 0; i < LOG_COUNT; i++) {
+        pending[i] = 0;
+    }
+    loaded = true;
+    return base.registered + base.deployed + base.released - before;
+}
+
+/**
+ * Counts a record this process is appending to a log
+ */
+void LiveStats::noteAppended(LogKind log, const std::string& record) {
+    fold(current, log, record);
+    pending[log] += (long long)record.size() + 1;  // The log writer ends every record with a newline
+    if (unterminated[log]) {
+        pending[log]++;  // ...and first ends the unterminated record before it
+        unterminated[log] = false;
+    }
+}
+
+/**
+ * Picks up records other processes appended
+ */
+bool LiveStats::reconcile() {
+    bool changed = false;
+    for (int log = 0; log < LOG_COUNT && !changed; log++) {
+        long long size = logFileSize(logs[log]);
+        changed = (size < 0 ? 0 : size) != cursor[log] + pending[log];
+    }
+    if (!changed) {
+        return false;
+    }
+
+    // The logs hold this process's records as well, so the tails since the
+    // cursor replace the live updates instead of adding to them
+    // A last line without its newline may still be being written, so it waits
+    bool intact = true;
+    for (int log = 0; log < LOG_COUNT; log++) {
+        intact = foldTail((LogKind)log, false) && intact;
+    }
+    if (!intact) {
+        rebuild(false);
+    }
+    noteUnterminatedEnds();
+    current = base;
+    for (int i = 0; i < LOG_COUNT; i++) {
+        pending[i] = 0;
+    }
+    return true;
+}
+
+/**
+ * Writes the totals and their cursor
+ */
+bool LiveStats::save(const std::string& filename) {
+    reconcile();
+    long long logBytes[LOG_COUNT];
+    for (int i = 0; i < LOG_COUNT; i++) {
+        logBytes[i] = cursor[i] + pending[i];
+    }
+    return writeStatsFile(filename, current, logBytes, archived);
+}
+
+/**
+ * Keeps a saved stats file valid after a log prefix moved into its archive
+ */
+bool LiveStats::moveCursorPastArchived(const std::string& filename, LogKind log, long long droppedBytes,
+                                       long long archivedBefore, long long archivedAfter) {
+    if (log == RELEASE_LOG) {
+        return false;
+    }
+
+    LiveStats saved("", "", "");
+    if (!saved.readFile(filename) || saved.archived[log] != archivedBefore || saved.cursor[log] < droppedBytes) {
+        return false;
+    }
+    saved.cursor[log] -= droppedBytes;
+    saved.archived[log] = archivedAfter;
+    return writeStatsFile(filename, saved.base, saved.cursor, saved.archived);
+}
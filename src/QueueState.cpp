@@ -0,0 +1,268 @@
+#include "../include/QueueState.hpp"
+#include "../include/CustomLists.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Queue state file layout (all integers little-endian):
+ *   "VQS3"                       magic
+ *   int64  registrationOffset
+ *   int64  deployedOffset
+ *   int64  releasedOffset
+ *   uint32 volunteer count
+ *   per volunteer: name, contact, skill as (uint16 length + bytes),
+ *                  uint8 has-location flag, then latitude and longitude
+ *                  as IEEE-754 doubles when the flag is set
+ */
+static const char QUEUE_STATE_MAGIC[4] = { 'V', 'Q', 'S', '3' };
+
+static void writeInt(std::ostream& out, uint64_t value, int bytes) {
+    char buffer[8];
+    for (int i = 0; i < bytes; i++) {
+        buffer[i] = (char)((value >> (8 * i)) & 0xFF);
+    }
+    out.write(buffer, bytes);
+}
+
+static bool readInt(std::ifstream& in, uint64_t& value, int bytes) {
+    unsigned char buffer[8];
+    if (!in.read((char*)buffer, bytes)) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)buffer[i] << (8 * i);
+    }
+    return true;
+}
+
+static void writeField(std::ofstream& out, const std::string& field) {
+    // Fields longer than 64 KiB are truncated; console input never gets close
+    size_t length = field.size() > 0xFFFF ? 0xFFFF : field.size();
+    writeInt(out, length, 2);
+    out.write(field.data(), length);
+}
+
+static bool readField(std::ifstream& in, std::string& field) {
+    uint64_t length;
+    if (!readInt(in, length, 2)) {
+        return false;
+    }
+    field.resize((size_t)length);
+    return length == 0 || (bool)in.read(&field[0], (std::streamsize)length);
+}
+
+static void writeDouble(std::ofstream& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeInt(out, bits, 8);
+}
+
+static bool readDouble(std::ifstream& in, double& value) {
+    uint64_t bits;
+    if (!readInt(in, bits, 8)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+/**
+ * Writes one volunteer in the queue state record layout
+ */
+void writeVolunteerRecord(std::ofstream& out, const Volunteer& v) {
+    writeField(out, v.name);
+    writeField(out, v.contact);
+    writeField(out, v.skill);
+    writeInt(out, v.hasLocation ? 1 : 0, 1);
+    if (v.hasLocation) {
+        writeDouble(out, v.latitude);
+        writeDouble(out, v.longitude);
+    }
+}
+
+/**
+ * Reads one volunteer written by writeVolunteerRecord
+ */
+bool readVolunteerRecord(std::ifstream& in, Volunteer& v) {
+    uint64_t hasLocation;
+    v = Volunteer();
+    if (!readField(in, v.name) || !readField(in, v.contact) || !readField(in, v.skill) ||
+        !readInt(in, hasLocation, 1)) {
+        return false;
+    }
+    if (hasLocation) {
+        double latitude, longitude;
+        if (!readDouble(in, latitude) || !readDouble(in, longitude)) {
+            return false;
+        }
+        v.setLocation(latitude, longitude);
+    }
+    return true;
+}
+
+static bool readHeader(std::ifstream& in, QueueCursor& cursor, uint64_t& count) {
+    char magic[4];
+    uint64_t registration, deployed, released;
+    if (!in.read(magic, 4) ||
+        magic[0] != QUEUE_STATE_MAGIC[0] || magic[1] != QUEUE_STATE_MAGIC[1] ||
+        magic[2] != QUEUE_STATE_MAGIC[2] || magic[3] != QUEUE_STATE_MAGIC[3]) {
+        return false;
+    }
+    if (!readInt(in, registration, 8) || !readInt(in, deployed, 8) ||
+        !readInt(in, released, 8) || !readInt(in, count, 4)) {
+        return false;
+    }
+    cursor = QueueCursor((long long)registration, (long long)deployed, (long long)released);
+    return true;
+}
+
+/**
+ * Writes the pending queue and its cursor to a compact binary file
+ */
+bool saveQueueState(const VolunteerQueue& queue, const QueueCursor& cursor, const std::string& filename) {
+    std::string tempName = filename + ".tmp";
+    std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out.write(QUEUE_STATE_MAGIC, 4);
+    writeInt(out, (uint64_t)cursor.registrationOffset, 8);
+    writeInt(out, (uint64_t)cursor.deployedOffset, 8);
+    writeInt(out, (uint64_t)cursor.releasedOffset, 8);
+    writeInt(out, (uint64_t)queue.size(), 4);
+
+    queue.forEach([&out](const Volunteer& v) {
+        writeVolunteerRecord(out, v);
+    });
+
+    out.close();
+    if (out.fail()) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+
+    // rename() does not replace an existing file on every platform
+    std::remove(filename.c_str());
+    return std::rename(tempName.c_str(), filename.c_str()) == 0;
+}
+
+/**
+ * Reads only the cursor from a saved queue state file
+ */
+bool readQueueCursor(const std::string& filename, QueueCursor& cursor) {
+    std::ifstream in(filename, std::ios::binary);
+    uint64_t count;
+    return in.is_open() && readHeader(in, cursor, count);
+}
+
+/**
+ * Overwrites the cursor of a saved queue state file in place
+ */
+bool rewriteQueueCursor(const std::string& filename, const QueueCursor& cursor) {
+    QueueCursor current;
+    if (!readQueueCursor(filename, current)) {
+        return false;
+    }
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(4);
+    writeInt(file, (uint64_t)cursor.registrationOffset, 8);
+    writeInt(file, (uint64_t)cursor.deployedOffset, 8);
+    writeInt(file, (uint64_t)cursor.releasedOffset, 8);
+    file.close();
+    return !file.fail();
+}
+
+/**
+ * Appends the saved volunteers to the queue in their saved order
+ */
+bool loadQueueState(VolunteerQueue& queue, QueueCursor& cursor, const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    QueueCursor savedCursor;
+    uint64_t count;
+    if (!readHeader(in, savedCursor, count)) {
+        return false;
+    }
+
+    // Stage everything first so a truncated file leaves the queue untouched
+    VolunteerQueue staged;
+    staged.copyLaneRulesFrom(queue);
+    for (uint64_t i = 0; i < count; i++) {
+        Volunteer v;
+        if (!readVolunteerRecord(in, v)) {
+            return false;
+        }
+        staged.enqueue(v);
+    }
+
+    queue.enqueueBulk(staged);
+    cursor = savedCursor;
+    return true;
+}
+
+/**
+ * Returns the size of a file in bytes, or -1 if it cannot be opened
+ */
+long long logFileSize(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return -1;
+    }
+    return (long long)file.tellg();
+}
+
+/**
+ * Reads the lines appended to a log since offset and advances it
+ */
+void readAppendedLines(const std::string& filename, long long& offset, CustomArray<std::string>& lines,
+                       bool includeUnterminated) {
+    lines.clear();
+    long long size = logFileSize(filename);
+    if (size < 0) {
+        return;
+    }
+    if (size < offset) {
+        // Truncated or replaced: the records now in it are all new
+        std::cout << "Warning: " << filename << " shrank; reading it again from the start.\n";
+        offset = 0;
+    }
+    if (size == offset) {
+        return;
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    file.seekg(offset);
+    std::string buffer((size_t)(size - offset), '\0');
+    file.read(&buffer[0], (std::streamsize)buffer.size());
+    buffer.resize((size_t)file.gcount());
+
+    // A line still being written has no newline yet; leave it for next time
+    size_t end = buffer.rfind('\n');
+    size_t consumed = end == std::string::npos ? 0 : end + 1;
+    if (includeUnterminated && consumed < buffer.size()) {
+        consumed = buffer.size();
+        buffer.push_back('\n');
+        end = consumed;
+    }
+    if (consumed == 0) {
+        return;
+    }
+    size_t start = 0;
+    while (start <= end) {
+        size_t newline = buffer.find('\n', start);
+        lines.push_back(buffer.substr(start, newline - start));
+        start = newline + 1;
+    }
+    offset += (long long)consumed;
+}
@@ -0,0 +1,389 @@
+#include "../include/RegionRegistry.hpp"
+#include "../include/Prototypes.hpp"
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+/**
+ * Constructor - initializes empty registry
+ */
+RegionRegistry::RegionRegistry() : version(0), seenGeneration(0), policy(POLICY_LOWEST_RATIO) {
+}
+
+/**
+ * Destructor - frees all shards
+ */
+RegionRegistry::~RegionRegistry() {
+    clear();
+}
+
+/**
+ * Removes every shard
+ */
+void RegionRegistry::clear() {
+    shared.detach();
+    sharedOffset.clear();
+    for (int i = 0; i < shards.size(); i++) {
+        delete shards[i];
+    }
+    shards.clear();
+    shardByRegion.clear();
+    version++;
+    siteByName.clear();
+    spatial.build(CustomArray<SiteSpatialIndex::Entry>());
+}
+
+/**
+ * Loads the regions listed in a manifest, reading the shard files in parallel
+ */
+int RegionRegistry::load(const std::string& manifestFile, const std::string& dataDir, const std::string& fallbackFile) {
+    clear();
+
+    std::ifstream manifest(manifestFile);
+    if (manifest.is_open()) {
+        std::string line;
+        while (std::getline(manifest, line)) {
+            line = trim(line);
+            if (line.empty() || line[0] == '#') continue;
+
+            std::stringstream ss(line);
+            std::string region, file;
+            if (ss >> region >> file && shardByRegion.find(region) == nullptr) {
+                shardByRegion.insert(region, shards.size());
+                shards.push_back(new RegionShard(region, dataDir + "/" + file));
+            }
+        }
+        manifest.close();
+    }
+
+    if (shards.empty()) {
+        shardByRegion.insert("Default", 0);
+        shards.push_back(new RegionShard("Default", fallbackFile));
+    }
+
+    // Each shard owns its file and index, so they load independently. A
+    // worker is only started per PARALLEL_LOAD_THRESHOLD files, which repay it
+    int workerCount = (int)std::thread::hardware_concurrency();
+    int worthWorkers = shards.size() / PARALLEL_LOAD_THRESHOLD;
+    if (workerCount > worthWorkers) workerCount = worthWorkers;
+
+    if (workerCount < 2) {
+        for (int i = 0; i < shards.size(); i++) {
+            shards[i]->sites.load(loadReliefSites(shards[i]->filename));
+        }
+    } else {
+        CustomArray<std::thread*> workers;
+        for (int w = 0; w < workerCount; w++) {
+            workers.push_back(new std::thread([this, w, workerCount]() {
+                for (int i = w; i < shards.size(); i += workerCount) {
+                    shards[i]->sites.load(loadReliefSites(shards[i]->filename));
+                }
+            }));
+        }
+        for (int w = 0; w < workers.size(); w++) {
+            workers[w]->join();
+            delete workers[w];
+        }
+    }
+
+    for (int s = 0; s < shards.size(); s++) {
+        const CustomArray<ReliefSite>& sites = shards[s]->sites.all();
+        for (int i = 0; i < sites.size(); i++) {
+            if (siteByName.find(sites[i].name) != nullptr) {
+                std::cout << "Warning: Site '" << sites[i].name << "' in region " << shards[s]->region
+                          << " duplicates a site name in another region; only the first is addressable by name.\n";
+                continue;
+            }
+            siteByName.insert(sites[i].name, SiteLocation(s, i));
+        }
+    }
+
+    // Spatial index over every site that has coordinates
+    CustomArray<SiteSpatialIndex::Entry> located;
+    for (int s = 0; s < shards.size(); s++) {
+        const CustomArray<ReliefSite>& sites = shards[s]->sites.all();
+        for (int i = 0; i < sites.size(); i++) {
+            if (sites[i].hasLocation) {
+                located.push_back(SiteSpatialIndex::Entry(sites[i].latitude, sites[i].longitude, SiteLocation(s, i),
+                                                          sites[i].currentCount < sites[i].maxCapacity));
+            }
+        }
+    }
+    spatial.build(located);
+    version++;
+
+    return shards.size();
+}
+
+/**
+ * Ranks two candidate sites by fill ratio, then by registry order
+ */
+static bool morePreferred(const RegionRegistry& registry, const SiteLocation& a, const SiteLocation& b) {
+    if (!b.valid()) return a.valid();
+    if (!a.valid()) return false;
+
+    const ReliefSite& siteA = registry.site(a);
+    const ReliefSite& siteB = registry.site(b);
+    long long lhs = (long long)siteA.currentCount * siteB.maxCapacity;
+    long long rhs = (long long)siteB.currentCount * siteA.maxCapacity;
+    if (lhs != rhs) return lhs < rhs;
+    return a.shard < b.shard || (a.shard == b.shard && a.index < b.index);
+}
+
+/**
+ * Reduces shards [first, last) to their best site (onlyShard >= 0 restricts to one shard)
+ */
+SiteLocation RegionRegistry::bestInRange(int first, int last, int onlyShard) const {
+    SiteLocation best;
+    for (int s = first; s < last; s++) {
+        if (onlyShard >= 0 && s != onlyShard) continue;
+        int index = shards[s]->sites.best();
+        if (index == -1) continue;
+
+        SiteLocation candidate(s, index);
+        if (morePreferred(*this, candidate, best)) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+/**
+ * Open site a policy prefers among shards [first, last); positions run
+ * across shards in registry order, so round-robin cycles through every site.
+ * The policy is not told the choice: a lookup may not end in a deployment
+ * (see noteDeployedTo).
+ */
+template<typename Policy>
+static SiteLocation scanShards(const RegionRegistry& registry, int first, int last, const Policy& policy) {
+    SiteLocation best;
+    const ReliefSite* bestSite = nullptr;
+    int bestPosition = -1;
+    int position = 0;
+    for (int s = 0; s < registry.shardCount(); s++) {
+        const CustomArray<ReliefSite>& sites = registry.shard(s).sites.all();
+        if (s < first || s >= last) {
+            position += sites.size();
+            continue;
+        }
+        for (int i = 0; i < sites.size(); i++, position++) {
+            if (sites[i].currentCount < sites[i].maxCapacity &&
+                (bestSite == nullptr || policy.prefer(sites[i], position, *bestSite, bestPosition))) {
+                bestSite = &sites[i];
+                bestPosition = position;
+                best = SiteLocation(s, i);
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * Most needed non-full site across all shards, or within one region
+ *
+ * Serial on purpose: each shard costs one heap-top comparison, a few
+ * nanoseconds, while starting and joining a thread costs ~13 us, so worker
+ * threads would make every deployment slower at any realistic shard count.
+ */
+SiteLocation RegionRegistry::bestSite(const std::string& regionFilter) const {
+    int first = 0;
+    int last = shards.size();
+    if (!regionFilter.empty()) {
+        first = shardIndex(regionFilter);
+        if (first == -1) return SiteLocation();
+        last = first + 1;
+    }
+
+    switch (policy) {
+        case POLICY_LOWEST_COUNT: {
+            LowestCountPolicy lowestCount;
+            return scanShards(*this, first, last, lowestCount);
+        }
+        case POLICY_MOST_FREE: {
+            MostFreeSlotsPolicy mostFree;
+            return scanShards(*this, first, last, mostFree);
+        }
+        case POLICY_WEIGHTED:
+            return scanShards(*this, first, last, policyState.weighted);
+        case POLICY_ROUND_ROBIN:
+            return scanShards(*this, first, last, policyState.roundRobin);
+        default:
+            return bestInRange(first, last, -1);
+    }
+}
+
+/**
+ * Moves the site policy's state past a deployment that was committed
+ */
+void RegionRegistry::noteDeployedTo(const SiteLocation& location) {
+    if (policy != POLICY_ROUND_ROBIN) return;
+    int position = location.index;
+    for (int s = 0; s < location.shard; s++) {
+        position += shards[s]->sites.size();
+    }
+    policyState.roundRobin.chose(position);
+}
+
+/**
+ * Nearest non-full site within radiusKm of a point
+ */
+SiteLocation RegionRegistry::nearestSite(double latitude, double longitude, double radiusKm) const {
+    auto better = [this](const SiteLocation& a, const SiteLocation& b) {
+        return morePreferred(*this, a, b);
+    };
+    return spatial.nearestOpen(latitude, longitude, radiusKm, better);
+}
+
+/**
+ * Distance in km from a point to a site
+ */
+double RegionRegistry::distanceKm(double latitude, double longitude, const SiteLocation& location) const {
+    const ReliefSite& target = site(location);
+    return spatial.distanceKm(latitude, longitude, target.latitude, target.longitude);
+}
+
+/**
+ * Looks a site up by name
+ */
+SiteLocation RegionRegistry::find(const std::string& siteName) const {
+    const SiteLocation* location = siteByName.find(siteName);
+    return location ? *location : SiteLocation();
+}
+
+/**
+ * Applies a count change to the local priority and spatial indexes
+ */
+void RegionRegistry::applyCount(const SiteLocation& location, int delta) {
+    RegionShard* shard = shards[location.shard];
+    shard->sites.adjustCount(location.index, delta);
+    version++;
+
+    const ReliefSite& changed = shard->sites.site(location.index);
+    if (changed.hasLocation) {
+        spatial.setOpen(location, changed.currentCount < changed.maxCapacity);
+    }
+}
+
+/**
+ * Changes a site's count and marks only its region for saving
+ */
+bool RegionRegistry::adjustCount(const SiteLocation& location, int delta) {
+    if (shared.attached()) {
+        // Claim places in the shared table first; the local count follows it
+        int slot = sharedOffset[location.shard] + location.index;
+        int claimed = 0;
+        for (; claimed < delta; claimed++) {
+            if (!shared.claim(slot)) break;
+        }
+        if (claimed < delta) {
+            for (int i = 0; i < claimed; i++) {
+                shared.release(slot);
+            }
+            syncShared();
+            return false;
+        }
+        int changes = claimed;
+        for (int i = delta; i < 0; i++) {
+            if (shared.release(slot)) changes++;
+        }
+
+        // Skip the full resync when nobody else changed anything since the last one
+        bool onlyOurs = shared.generation() - seenGeneration == (uint64_t)changes;
+        delta = shared.count(slot) - site(location).currentCount;
+        if (onlyOurs) {
+            seenGeneration += changes;
+        }
+    }
+
+    applyCount(location, delta);
+    shards[location.shard]->dirty = true;
+    return true;
+}
+
+/**
+ * Writes every region with unsaved changes to its own file
+ */
+void RegionRegistry::saveDirty() {
+    // Under the shared lock, so instances never interleave writes to one file
+    shared.lock();
+    syncShared();
+    for (int s = 0; s < shards.size(); s++) {
+        if (shards[s]->dirty) {
+            saveReliefSites(shards[s]->sites.all(), shards[s]->filename);
+            shards[s]->dirty = false;
+        }
+    }
+    shared.unlock();
+}
+
+/**
+ * Shares site counts with other instances through a table file
+ */
+bool RegionRegistry::shareCounts(const std::string& tableFile) {
+    CustomArray<uint64_t> keys;
+    CustomArray<ReliefSite> all;
+    sharedOffset.clear();
+    for (int s = 0; s < shards.size(); s++) {
+        sharedOffset.push_back(all.size());
+        const CustomArray<ReliefSite>& sites = shards[s]->sites.all();
+        for (int i = 0; i < sites.size(); i++) {
+            keys.push_back(SharedSiteTable::siteKey(shards[s]->region, sites[i]));
+            all.push_back(sites[i]);
+        }
+    }
+
+    bool created = false;
+    bool inUse = false;
+    if (!shared.attach(tableFile, keys, all, created, inUse)) {
+        if (inUse) {
+            std::cout << "Warning: The relief site files no longer match the site table other running instances "
+                      << "are using; restart them to share counts again.\n";
+        }
+        sharedOffset.clear();
+        return false;
+    }
+
+    // Another instance may already have deployed past what the files say
+    seenGeneration = shared.generation() - 1;
+    syncShared();
+    return true;
+}
+
+/**
+ * Pulls count changes made by other instances into the local indexes
+ */
+void RegionRegistry::syncShared() {
+    if (!shared.attached()) return;
+    uint64_t generation = shared.generation();
+    if (generation == seenGeneration) return;
+
+    // Read the generation first: a change during the scan triggers another sync
+    seenGeneration = generation;
+    for (int s = 0; s < shards.size(); s++) {
+        for (int i = 0; i < shards[s]->sites.size(); i++) {
+            int delta = shared.count(sharedOffset[s] + i) - shards[s]->sites.site(i).currentCount;
+            if (delta != 0) {
+                applyCount(SiteLocation(s, i), delta);
+            }
+        }
+    }
+}
+
+/**
+ * Index of a region's shard, or -1 if unknown
+ */
+int RegionRegistry::shardIndex(const std::string& region) const {
+    const int* index = shardByRegion.find(region);
+    return index ? *index : -1;
+}
+
+/**
+ * Total number of sites across all regions
+ */
+int RegionRegistry::totalSites() const {
+    int total = 0;
+    for (int s = 0; s < shards.size(); s++) {
+        total += shards[s]->sites.size();
+    }
+    return total;
+}
@@ -0,0 +1,219 @@
+#include "../include/RegistrationFollower.hpp"
+#include "../include/DeploymentIndex.hpp"
+#include "../include/QueueState.hpp"
+#include "../include/HistoryArchive.hpp"
+#include "../include/AsyncLogWriter.hpp"
+#include "../include/Prototypes.hpp"
+#include <fstream>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor - initializes an idle follower
+ */
+RegistrationFollower::RegistrationFollower()
+    : offset(0), deployedOffset(0), releasedOffset(0), inotifyFd(-1), following(false), deploymentsLoaded(false) {
+}
+
+/**
+ * Destructor - stops watching
+ */
+RegistrationFollower::~RegistrationFollower() {
+    stop();
+}
+
+/**
+ * Tracks the registration log from a byte offset without watching it
+ */
+void RegistrationFollower::track(const std::string& registrations, long long startOffset,
+                                 const std::string& deployed, const std::string& released) {
+    stop();
+    registrationFile = registrations;
+    deployedFile = deployed;
+    releasedFile = released;
+    offset = startOffset;
+    deployedOffset = 0;
+    releasedOffset = 0;
+    activeCounts.clear();
+    ownRecords.clear();
+    deploymentsLoaded = false;
+}
+
+/**
+ * Starts following the registration log from a byte offset
+ */
+bool RegistrationFollower::start(const std::string& registrations, long long startOffset,
+                                 const std::string& deployed, const std::string& released) {
+    track(registrations, startOffset, deployed, released);
+    catchUpDeployments();
+
+#ifdef __linux__
+    // Watch the directory so a log that is created or replaced is still seen
+    size_t slash = registrations.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : registrations.substr(0, slash);
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd == -1 ||
+        inotify_add_watch(inotifyFd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO) == -1) {
+        if (inotifyFd != -1) {
+            close(inotifyFd);
+            inotifyFd = -1;
+        }
+        return false;
+    }
+    following = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Stops watching the log
+ */
+void RegistrationFollower::stop() {
+#ifdef __linux__
+    if (inotifyFd != -1) {
+        close(inotifyFd);
+    }
+#endif
+    inotifyFd = -1;
+    following = false;
+}
+
+/**
+ * Notes a record this instance appended, so it is not queued twice
+ */
+void RegistrationFollower::expectOwnRecord(const Volunteer& volunteer) {
+    if (isTracking()) {
+        ownRecords[volunteerKey(volunteer)]++;
+    }
+}
+
+/**
+ * Applies deployments and releases appended since the last catch-up
+ */
+void RegistrationFollower::catchUpDeployments() {
+    CustomArray<std::string> lines;
+    Volunteer volunteer;
+    std::string site, extra;
+
+    // Archived deployments never change; only the text logs are followed
+    if (!deploymentsLoaded) {
+        HistoryArchive archive;
+        if (archive.open(archiveFileFor(deployedFile))) {
+            archive.forEachLine([&](const std::string& record) {
+                if (parseDeploymentRecord(record, volunteer, site, extra)) {
+                    activeCounts[volunteerKey(volunteer)]++;
+                }
+            });
+        }
+        deploymentsLoaded = true;
+    }
+
+    readAppendedLines(deployedFile, deployedOffset, lines);
+    for (int i = 0; i < lines.size(); i++) {
+        if (parseDeploymentRecord(lines[i], volunteer, site, extra)) {
+            activeCounts[volunteerKey(volunteer)]++;
+        }
+    }
+
+    // Volunteers returned to the queue are waiting again
+    readAppendedLines(releasedFile, releasedOffset, lines);
+    for (int i = 0; i < lines.size(); i++) {
+        if (parseDeploymentRecord(lines[i], volunteer, site, extra) && extra == "requeue") {
+            int* count = activeCounts.find(volunteerKey(volunteer));
+            if (count != nullptr && *count > 0) {
+                (*count)--;
+            }
+        }
+    }
+}
+
+/**
+ * Drains pending change notifications and ingests if the log changed
+ */
+int RegistrationFollower::poll(VolunteerQueue& queue) {
+    if (!following) {
+        return 0;
+    }
+
+    bool changed = false;
+#ifdef __linux__
+    size_t slash = registrationFile.rfind('/');
+    std::string name = slash == std::string::npos ? registrationFile : registrationFile.substr(slash + 1);
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) break;
+
+        for (char* p = buffer; p < buffer + length; ) {
+            inotify_event* event = (inotify_event*)p;
+            if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && name == event->name)) {
+                changed = true;
+            }
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+#endif
+    return changed ? ingest(queue) : 0;
+}
+
+/**
+ * Reads and enqueues every complete record appended since the last call
+ */
+int RegistrationFollower::ingest(VolunteerQueue& queue) {
+    // Own records still in the log writer are read back (and skipped) now,
+    // so the offset ends past them; the deployment catch-up needs them too
+    logWriter().flush();
+    CustomArray<std::string> lines;
+    readAppendedLines(registrationFile, offset, lines);
+    if (lines.empty()) {
+        return 0;
+    }
+
+    // Deployments made since the last ingestion decide who is already out
+    catchUpDeployments();
+
+    VolunteerQueue staged;
+    staged.copyLaneRulesFrom(queue);
+    int loadedCount = 0;
+    int skippedCount = 0;
+    for (int i = 0; i < lines.size(); i++) {
+        std::string line = trim(lines[i]);
+        Volunteer volunteer;
+        if (line.empty() || !parseVolunteerRecord(line, volunteer)) {
+            continue;
+        }
+
+        std::string key = volunteerKey(volunteer);
+        int* own = ownRecords.find(key);
+        if (own != nullptr) {
+            if (--(*own) == 0) {
+                ownRecords.erase(key);
+            }
+            continue;
+        }
+
+        const int* deployedCount = activeCounts.find(key);
+        if (deployedCount == nullptr || *deployedCount == 0) {
+            staged.enqueue(volunteer);
+            volunteerSearch().noteQueued(volunteer);
+            loadedCount++;
+        } else {
+            skippedCount++;
+            std::cout << "Skipping already deployed volunteer: " << volunteer.name << "\n";
+        }
+    }
+
+    queue.enqueueBulk(staged);
+    if (loadedCount > 0) {
+        std::cout << "Note: Ingested " << loadedCount << " new registration(s) from " << registrationFile << ".\n";
+    }
+    return loadedCount;
+}
@@ -0,0 +1,338 @@
+#include "../include/VolunteerQueue.hpp"
+#include "../include/Snapshot.hpp"
+#include "../include/VolunteerSpill.hpp"
+#include <stdexcept>
+#include <iostream>
+#include <utility>
+
+/**
+ * Constructor - initializes empty queue
+ */
+RingVolunteerQueue::RingVolunteerQueue()
+    : laneMask(0), count(0), nextSequence(0), version(0),
+      mode(FIFO_DISPATCH), agingThreshold(0), bypassCount(0),
+      memoryBudget(0), residentBytes(0), spill(nullptr) {}
+
+/**
+ * Destructor - frees the spill (the rings free themselves)
+ */
+RingVolunteerQueue::~RingVolunteerQueue() {
+    delete spill;
+}
+
+/**
+ * Index of the highest set bit (mask must be non-zero)
+ */
+static int highestLane(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(mask);
+#else
+    int lane = 0;
+    while (mask >>= 1) {
+        lane++;
+    }
+    return lane;
+#endif
+}
+
+/**
+ * Approximate heap footprint of one resident volunteer (its ring slot plus strings)
+ */
+static long long entryFootprint(const Volunteer& v, size_t slotSize) {
+    return (long long)slotSize + (long long)(v.name.capacity() + v.contact.capacity() + v.skill.capacity());
+}
+
+/**
+ * Lane holding the longest-waiting resident volunteer
+ */
+int RingVolunteerQueue::oldestLane() const {
+    int best = -1;
+    for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+        if ((laneMask & (1u << lane)) &&
+            (best < 0 || lanes[lane].front().sequence < lanes[best].front().sequence)) {
+            best = lane;
+        }
+    }
+    return best;
+}
+
+/**
+ * Lane the next dequeue takes from
+ */
+int RingVolunteerQueue::laneToDispatch() const {
+    if (mode == FIFO_DISPATCH) {
+        return oldestLane();
+    }
+
+    int candidate = highestLane(laneMask);
+    if (agingThreshold > 0 && bypassCount >= agingThreshold) {
+        return oldestLane();  // Longest-waiting volunteer has been skipped long enough
+    }
+    return candidate;
+}
+
+/**
+ * Adds a volunteer to the rear of the queue
+ */
+void RingVolunteerQueue::enqueue(const Volunteer& v) {
+    queuedPerSkill[v.skill]++;
+
+    // Once anyone is spilled, later arrivals must queue behind them
+    if (spill != nullptr && (!spill->empty() || (count > 0 && residentBytes >= memoryBudget / 2))) {
+        spill->push(v);
+        version++;
+        return;
+    }
+    pushResident(v, priorityOf(v));
+    version++;
+}
+
+/**
+ * Appends a volunteer to the rear of its lane ring
+ */
+void RingVolunteerQueue::pushResident(const Volunteer& v, int lane) {
+    CustomRing<Entry>& ring = lanes[lane];
+    ring.push_back(Entry(v, nextSequence++));
+    residentBytes += entryFootprint(ring[ring.size() - 1].data, sizeof(Entry));
+    laneMask |= 1u << lane;
+    count++;
+}
+
+/**
+ * Moves spilled volunteers into the resident window while it has room
+ */
+void RingVolunteerQueue::admitSpilled() {
+    Volunteer v;
+    while (spill != nullptr && (count == 0 || residentBytes < memoryBudget / 2) && spill->pop(v)) {
+        pushResident(v, priorityOf(v));
+    }
+}
+
+/**
+ * Moves every volunteer of batch to the rear of this queue
+ */
+void RingVolunteerQueue::enqueueBulk(RingVolunteerQueue& batch) {
+    if (&batch == this || batch.isEmpty()) {
+        return;
+    }
+
+    if (spill != nullptr || batch.spill != nullptr) {
+        // Spilled volunteers go through enqueue one by one in arrival order
+        while (batch.count > 0) {
+            int lane = batch.oldestLane();
+            enqueue(batch.lanes[lane].front().data);
+            batch.lanes[lane].pop_front();
+            batch.count--;
+            if (batch.lanes[lane].empty()) {
+                batch.laneMask &= ~(1u << lane);
+            }
+        }
+        Volunteer v;
+        while (batch.spill != nullptr && batch.spill->pop(v)) {
+            enqueue(v);
+        }
+    } else {
+        // Keep the batch's lanes and renumber its arrivals to follow ours
+        long long first = batch.lanes[batch.oldestLane()].front().sequence;
+        for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+            CustomRing<Entry>& from = batch.lanes[lane];
+            while (!from.empty()) {
+                from.front().sequence += nextSequence - first;
+                lanes[lane].push_back(std::move(from.front()));
+                from.pop_front();
+            }
+        }
+        nextSequence += batch.nextSequence - first;
+        laneMask |= batch.laneMask;
+        count += batch.count;
+        residentBytes += batch.residentBytes;
+        batch.queuedPerSkill.forEach([this](const std::string& skill, int queued) {
+            queuedPerSkill[skill] += queued;
+        });
+        version++;
+    }
+
+    batch.laneMask = 0;
+    batch.count = 0;
+    batch.residentBytes = 0;
+    batch.queuedPerSkill.clear();
+    batch.version++;
+}
+
+/**
+ * Uses the same skill/contact lane rules and memory budget as another queue
+ */
+void RingVolunteerQueue::copyLaneRulesFrom(const RingVolunteerQueue& other) {
+    QueueLaneRules::operator=(other);
+    setMemoryBudget(other.memoryBudget, other.spillDirectory);
+}
+
+/**
+ * Bounds the memory used by queued volunteers
+ */
+void RingVolunteerQueue::setMemoryBudget(long long bytes, const std::string& directory) {
+    memoryBudget = bytes > 0 ? bytes : 0;
+    spillDirectory = directory;
+
+    if (memoryBudget == 0) {
+        if (spill != nullptr) {
+            Volunteer v;
+            while (spill->pop(v)) {
+                pushResident(v, priorityOf(v));
+            }
+            delete spill;
+            spill = nullptr;
+            version++;
+        }
+        return;
+    }
+
+    if (spill == nullptr) {
+        // A quarter of the budget for the spill's head, tail and prefetched segments
+        long long typical = (long long)sizeof(Entry) + 3 * 32;
+        long long records = memoryBudget / 4 / 3 / typical;
+        spill = new VolunteerSpill(directory, records < 64 ? 64 : (int)(records > 1000000 ? 1000000 : records));
+    }
+    admitSpilled();
+}
+
+/**
+ * Number of volunteers currently spilled out of the resident window
+ */
+long long RingVolunteerQueue::spilledCount() const {
+    return spill != nullptr ? spill->size() : 0;
+}
+
+/**
+ * One part of the spilled volunteers, front part first
+ */
+bool RingVolunteerQueue::readSpilledPart(int part, CustomArray<Volunteer>& out) const {
+    return spill != nullptr && spill->readPart(part, out);
+}
+
+/**
+ * Takes a volunteer off the per-skill counts
+ */
+void RingVolunteerQueue::forgetQueued(const Volunteer& v) {
+    int* queued = queuedPerSkill.find(v.skill);
+    if (queued != nullptr && --(*queued) == 0) {
+        queuedPerSkill.erase(v.skill);
+    }
+}
+
+/**
+ * Accounts for a resident entry removeIf is dropping from its ring
+ */
+void RingVolunteerQueue::forgetResident(const Entry& entry) {
+    count--;
+    residentBytes -= entryFootprint(entry.data, sizeof(Entry));
+    forgetQueued(entry.data);
+}
+
+bool RingVolunteerQueue::popSpilled(Volunteer& v) {
+    return spill != nullptr && spill->pop(v);
+}
+
+void RingVolunteerQueue::pushSpilled(const Volunteer& v) {
+    spill->push(v);
+}
+
+/**
+ * Recomputes the lane bitmap after removeIf and refills the resident window
+ */
+void RingVolunteerQueue::finishRemoval(int removed) {
+    laneMask = 0;
+    for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+        if (!lanes[lane].empty()) {
+            laneMask |= 1u << lane;
+        }
+    }
+    if (removed > 0) {
+        version++;
+        admitSpilled();
+    }
+}
+
+/**
+ * Removes and returns the volunteer the dispatch mode serves next
+ */
+Volunteer RingVolunteerQueue::dequeue() {
+    if (isEmpty()) {
+        throw std::runtime_error("Cannot dequeue from empty queue");
+    }
+
+    int lane = laneToDispatch();
+    bypassCount = (mode == PRIORITY_DISPATCH && lane != oldestLane()) ? bypassCount + 1 : 0;
+
+    CustomRing<Entry>& ring = lanes[lane];
+    residentBytes -= entryFootprint(ring.front().data, sizeof(Entry));
+    Volunteer volunteer = std::move(ring.front().data);
+    ring.pop_front();
+    if (ring.empty()) {
+        laneMask &= ~(1u << lane);
+    }
+    count--;
+    version++;
+    forgetQueued(volunteer);
+
+    // The freed room goes to the oldest spilled volunteer
+    admitSpilled();
+
+    return volunteer;
+}
+
+/**
+ * Displays all volunteers in the queue from front to rear
+ */
+void RingVolunteerQueue::displayAll() const {
+    if (isEmpty()) {
+        std::cout << "No volunteers currently registered.\n";
+        return;
+    }
+
+    QueueView view;
+    view.capture(*this);
+    view.display();
+}
+
+/**
+ * Returns the number of volunteers in the queue
+ */
+int RingVolunteerQueue::size() const {
+    return count + (int)spilledCount();
+}
+
+/**
+ * Returns the volunteer the next dequeue will remove, without removing it
+ */
+const Volunteer& RingVolunteerQueue::front() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Cannot peek into empty queue");
+    }
+
+    return lanes[laneToDispatch()].front().data;
+}
+
+/**
+ * Chooses strict FIFO or priority-lane dispatch
+ */
+void RingVolunteerQueue::setDispatchMode(DispatchMode newMode) {
+    mode = newMode;
+    bypassCount = 0;
+    version++;
+}
+
+/**
+ * Enables aging after the given number of consecutive bypasses (0 disables)
+ */
+void RingVolunteerQueue::setAgingThreshold(int threshold) {
+    agingThreshold = threshold > 0 ? threshold : 0;
+}
+
+/**
+ * Number of queued volunteers with a skill
+ */
+int RingVolunteerQueue::countWithSkill(const std::string& skill) const {
+    const int* queued = queuedPerSkill.find(skill);
+    return queued != nullptr ? *queued : 0;
+}
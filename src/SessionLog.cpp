@@ -0,0 +1,430 @@
+#include "../include/SessionLog.hpp"
+#include "../include/Prototypes.hpp"
+#include "../include/AsyncLogWriter.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __unix__
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Pulls the next byte from the wrapped buffer and keeps a copy
+ */
+RecordingStreambuf::int_type RecordingStreambuf::underflow() {
+    int_type c = source->sbumpc();
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return c;
+    }
+    if (captured.empty()) {
+        firstByte = std::chrono::steady_clock::now();
+    }
+    current = traits_type::to_char_type(c);
+    captured += current;
+    setg(&current, &current, &current + 1);
+    return c;
+}
+
+/**
+ * Hands over the bytes consumed since the last call
+ */
+bool RecordingStreambuf::take(std::string& bytes, std::chrono::steady_clock::time_point& firstByteAt) {
+    if (captured.empty()) {
+        return false;
+    }
+    bytes.swap(captured);
+    captured.clear();
+    firstByteAt = firstByte;
+    return true;
+}
+
+/**
+ * Destructor - writes any pending action and stops recording
+ */
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+/**
+ * Starts copying std::cin input to a new session log
+ */
+bool SessionRecorder::start(const std::string& filename) {
+    stop();
+    log.open(filename, std::ios::trunc);
+    if (!log.is_open()) {
+        return false;
+    }
+    log << SESSION_LOG_HEADER << "\n";
+    log.flush();
+
+    started = std::chrono::steady_clock::now();
+    original = std::cin.rdbuf();
+    tap = new RecordingStreambuf(original);
+    std::cin.rdbuf(tap);
+    return true;
+}
+
+/**
+ * Writes the input consumed since the previous call as one record
+ */
+void SessionRecorder::finishAction() {
+    if (tap == nullptr) {
+        return;
+    }
+    std::string bytes;
+    std::chrono::steady_clock::time_point at;
+    if (!tap->take(bytes, at)) {
+        return;
+    }
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(at - started).count();
+    log << ms << "\t" << escapeSessionInput(bytes) << "\n";
+    log.flush();  // A crashed session still leaves every finished action in the log
+}
+
+/**
+ * Writes any pending action and restores std::cin
+ */
+void SessionRecorder::stop() {
+    if (tap == nullptr) {
+        return;
+    }
+    finishAction();
+    std::cin.rdbuf(original);
+    delete tap;
+    tap = nullptr;
+    log.close();
+}
+
+std::string escapeSessionInput(const std::string& input) {
+    std::string escaped;
+    escaped.reserve(input.size() + 8);
+    for (size_t i = 0; i < input.size(); i++) {
+        switch (input[i]) {
+            case '\\': escaped += "\\\\"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            default: escaped += input[i]; break;
+        }
+    }
+    return escaped;
+}
+
+std::string unescapeSessionInput(const std::string& escaped) {
+    std::string input;
+    input.reserve(escaped.size());
+    for (size_t i = 0; i < escaped.size(); i++) {
+        if (escaped[i] != '\\' || i + 1 == escaped.size()) {
+            input += escaped[i];
+            continue;
+        }
+        char code = escaped[++i];
+        input += code == 't' ? '\t' : code == 'n' ? '\n' : code == 'r' ? '\r' : code;
+    }
+    return input;
+}
+
+/**
+ * One recorded action
+ */
+struct SessionAction {
+    long long recordedMs;
+    std::string input;
+    int choice;           // Menu choice typed first, 0 if unreadable
+    double replayMs;      // Filled in by the replay
+
+    SessionAction() : recordedMs(0), choice(0), replayMs(0) {}
+};
+
+/**
+ * Reads a session log
+ * @return false if the file is missing or not a session log
+ */
+static bool loadSessionLog(const std::string& filename, CustomArray<SessionAction>& actions) {
+    std::ifstream file(filename);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line) || line != SESSION_LOG_HEADER) {
+        return false;
+    }
+
+    int lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+            std::cout << "Warning: Skipping malformed session record on line " << lineNumber << "\n";
+            continue;
+        }
+        SessionAction action;
+        action.recordedMs = std::atoll(line.substr(0, tab).c_str());
+        action.input = unescapeSessionInput(line.substr(tab + 1));
+        action.choice = std::atoi(action.input.c_str());
+        actions.push_back(action);
+    }
+    return true;
+}
+
+static const char* actionLabel(int choice) {
+    static const char* const labels[] = {
+        "Invalid", "Register", "Deploy", "View", "Release", "Plan Roster", "Locate", "Exit"
+    };
+    return choice >= 1 && choice <= 7 ? labels[choice] : labels[0];
+}
+
+/**
+ * Output buffer that discards everything
+ */
+class NullStreambuf : public std::streambuf {
+protected:
+    int_type overflow(int_type c) {
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char*, std::streamsize count) {
+        return count;
+    }
+};
+
+#ifdef __unix__
+/**
+ * Runtime files of a live instance that must not be copied into the scratch
+ * directory (sockets, shared tables, spill segments)
+ */
+static bool isRuntimeFile(const std::string& name) {
+    return name == "volunteer.sock" || name.find(".shm") != std::string::npos ||
+           name.compare(0, 12, "queue-spill-") == 0;
+}
+
+/**
+ * Copies a directory tree of regular files
+ */
+static bool copyTree(const std::string& from, const std::string& to) {
+    DIR* dir = opendir(from.c_str());
+    if (dir == nullptr) {
+        return false;
+    }
+    bool ok = mkdir(to.c_str(), 0700) == 0;
+    struct dirent* entry;
+    while (ok && (entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name == "." || name == ".." || isRuntimeFile(name)) continue;
+
+        std::string source = from + "/" + name;
+        std::string target = to + "/" + name;
+        struct stat info;
+        if (stat(source.c_str(), &info) != 0) continue;
+        if (S_ISDIR(info.st_mode)) {
+            ok = copyTree(source, target);
+        } else if (S_ISREG(info.st_mode)) {
+            std::ifstream in(source, std::ios::binary);
+            std::ofstream out(target, std::ios::binary | std::ios::trunc);
+            out << in.rdbuf();
+            out.close();
+            ok = !out.fail();
+        }
+    }
+    closedir(dir);
+    return ok;
+}
+
+/**
+ * Deletes a directory tree
+ */
+static void removeTree(const std::string& path) {
+    DIR* dir = opendir(path.c_str());
+    if (dir != nullptr) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") continue;
+            std::string child = path + "/" + name;
+            struct stat info;
+            if (lstat(child.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+                removeTree(child);
+            } else {
+                unlink(child.c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(path.c_str());
+}
+#endif
+
+/**
+ * Prints per-action latency statistics of a replay
+ */
+static void printReplayReport(const std::string& logFile, const CustomArray<SessionAction>& actions,
+                              int replayed, double startupMs, double totalMs) {
+    std::cout << "\n=== SESSION REPLAY ===\n";
+    std::cout << "Log: " << logFile << " | Actions replayed: " << replayed << "/" << actions.size() << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    if (replayed > 0) {
+        double recordedSpan = (actions[replayed - 1].recordedMs - actions[0].recordedMs) / 1000.0;
+        std::cout << "Recorded span: " << std::setprecision(1) << recordedSpan << "s"
+                  << " | Replay: " << std::setprecision(3) << totalMs << " ms"
+                  << " | Startup: " << startupMs << " ms\n\n";
+    }
+
+    std::cout << std::left << std::setw(14) << "Action"
+              << std::setw(8) << "Count"
+              << std::setw(12) << "Mean(ms)"
+              << std::setw(12) << "P50(ms)"
+              << std::setw(12) << "P95(ms)"
+              << std::setw(12) << "Max(ms)"
+              << std::setw(12) << "Total(ms)" << "\n";
+    std::cout << std::string(82, '-') << "\n";
+
+    for (int choice = 0; choice <= 7; choice++) {
+        CustomArray<double> latencies;
+        for (int i = 0; i < replayed; i++) {
+            int normalized = actions[i].choice >= 1 && actions[i].choice <= 7 ? actions[i].choice : 0;
+            if (normalized == choice) {
+                latencies.push_back(actions[i].replayMs);
+            }
+        }
+        if (latencies.empty()) continue;
+
+        std::sort(latencies.begin(), latencies.end());
+        double total = 0;
+        for (int i = 0; i < latencies.size(); i++) {
+            total += latencies[i];
+        }
+        int n = latencies.size();
+        std::cout << std::left << std::setw(14) << actionLabel(choice)
+                  << std::setw(8) << n
+                  << std::setw(12) << total / n
+                  << std::setw(12) << latencies[(n - 1) / 2]
+                  << std::setw(12) << latencies[(int)((n - 1) * 0.95)]
+                  << std::setw(12) << latencies[n - 1]
+                  << std::setw(12) << total << "\n";
+    }
+    std::cout << std::string(82, '-') << "\n";
+
+    // The slowest individual actions, to find what to look at first
+    CustomArray<int> order;
+    for (int i = 0; i < replayed; i++) {
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&actions](int a, int b) {
+        return actions[a].replayMs > actions[b].replayMs;
+    });
+    int shown = std::min(order.size(), 5);
+    if (shown > 0) {
+        std::cout << "\nSlowest actions:\n";
+        for (int i = 0; i < shown; i++) {
+            const SessionAction& action = actions[order[i]];
+            std::cout << "  #" << (order[i] + 1) << " " << actionLabel(action.choice)
+                      << " at " << std::setprecision(1) << action.recordedMs / 1000.0 << "s: "
+                      << std::setprecision(3) << action.replayMs << " ms\n";
+        }
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+/**
+ * Prints command-line help for replay mode
+ */
+static void printReplayUsage() {
+    std::cout << "Usage: volunteer_system --replay-session LOG [options]\n"
+              << "  --data DIR   Data directory to copy for the replay (default ../data)\n"
+              << "  --keep       Keep the scratch copy and print its location\n";
+}
+
+/**
+ * Entry point for "--replay-session" mode
+ */
+int runSessionReplayMode(int argc, char* argv[]) {
+    if (argc < 3 || std::string(argv[2]) == "--help") {
+        printReplayUsage();
+        return argc < 3 ? 1 : 0;
+    }
+    std::string logFile = argv[2];
+    std::string dataDir = "../data";
+    bool keep = false;
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--data" && i + 1 < argc) {
+            dataDir = argv[++i];
+        } else if (option == "--keep") {
+            keep = true;
+        } else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printReplayUsage();
+            return 1;
+        }
+    }
+
+    CustomArray<SessionAction> actions;
+    if (!loadSessionLog(logFile, actions)) {
+        std::cout << "Error: '" << logFile << "' is not a readable session log.\n";
+        return 1;
+    }
+
+#ifdef __unix__
+    // Scratch layout mirrors the usual one, so the "../data/..." paths resolve into the copy
+    char scratchTemplate[] = "/tmp/vs-replay-XXXXXX";
+    if (mkdtemp(scratchTemplate) == nullptr) {
+        std::cout << "Error: Could not create a scratch directory: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::string scratch = scratchTemplate;
+    std::string buildDir = scratch + "/build";
+    if (!copyTree(dataDir, scratch + "/data") || mkdir(buildDir.c_str(), 0700) != 0 ||
+        chdir(buildDir.c_str()) != 0) {
+        std::cout << "Error: Could not copy data directory '" << dataDir << "' for the replay.\n";
+        removeTree(scratch);
+        return 1;
+    }
+
+    // Everything the menus print is discarded; only the report is shown
+    NullStreambuf discard;
+    std::streambuf* console = std::cout.rdbuf(&discard);
+    std::streambuf* keyboard = std::cin.rdbuf();
+
+    auto started = std::chrono::steady_clock::now();
+    VolunteerQueue queue;
+    loadDispatchSettings(queue, "../data/dispatch.txt");
+    initializeQueue(queue);
+    auto ready = std::chrono::steady_clock::now();
+    double startupMs = std::chrono::duration<double, std::milli>(ready - started).count();
+
+    int replayed = 0;
+    bool running = true;
+    while (running && replayed < actions.size()) {
+        SessionAction& action = actions[replayed++];
+        std::stringbuf input(action.input, std::ios::in);
+        std::cin.rdbuf(&input);
+        std::cin.clear();
+
+        auto begin = std::chrono::steady_clock::now();
+        running = runMenuIteration(queue);
+        action.replayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    logWriter().flush();
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ready).count();
+
+    std::cin.rdbuf(keyboard);
+    std::cin.clear();
+    std::cout.rdbuf(console);
+
+    printReplayReport(logFile, actions, replayed, startupMs, totalMs);
+    if (keep) {
+        std::cout << "\nScratch data kept in " << scratch << "/data\n";
+    } else {
+        removeTree(scratch);
+    }
+    return 0;
+#else
+    (void)keep;
+    std::cout << "Error: Session replay needs a Unix-like system.\n";
+    return 1;
+#endif
+}
@@ -0,0 +1,231 @@
+#include "../include/SharedSiteTable.hpp"
+#include <cstdio>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor - initializes a detached table
+ */
+SharedSiteTable::SharedSiteTable() : lockFd(-1), tableFd(-1), header(nullptr), entries(nullptr), mappedBytes(0) {
+}
+
+/**
+ * Destructor - unmaps the table
+ */
+SharedSiteTable::~SharedSiteTable() {
+    detach();
+}
+
+/**
+ * Identity of a site in the table (FNV-1a over region and name)
+ */
+uint64_t SharedSiteTable::siteKey(const std::string& region, const ReliefSite& site) {
+    uint64_t hash = 1469598103934665603ULL;
+    std::string text = region + "/" + site.name;
+    for (size_t i = 0; i < text.size(); i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#ifdef __linux__
+
+/**
+ * Writes a fresh table next to the old one and swaps it in
+ */
+static bool writeTable(const std::string& path, const CustomArray<uint64_t>& keys, const CustomArray<ReliefSite>& sites) {
+    std::string temp = path + ".tmp";
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    SharedSiteTable::Header header;
+    header.magic = SharedSiteTable::MAGIC;
+    header.siteCount = (uint32_t)sites.size();
+    header.generation = 0;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int i = 0; ok && i < sites.size(); i++) {
+        SharedSiteTable::Entry entry;
+        entry.key = keys[i];
+        entry.maxCapacity = sites[i].maxCapacity;
+        entry.currentCount = sites[i].currentCount;
+        ok = std::fwrite(&entry, sizeof(entry), 1, file) == 1;
+    }
+    ok = std::fclose(file) == 0 && ok;
+    return ok && std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Maps the table file, (re)building it if needed and nobody else holds it
+ */
+bool SharedSiteTable::attach(const std::string& path, const CustomArray<uint64_t>& keys,
+                             const CustomArray<ReliefSite>& sites, bool& created, bool& inUse) {
+    detach();
+    created = false;
+    inUse = false;
+
+    lockFd = open((path + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (lockFd == -1) {
+        return false;
+    }
+    lock();
+
+    size_t expected = sizeof(Header) + (size_t)sites.size() * sizeof(Entry);
+    for (int attempt = 0; attempt < 2 && header == nullptr; attempt++) {
+        int fd = open(path.c_str(), O_RDWR);
+        struct stat info;
+        if (fd != -1 && fstat(fd, &info) == 0 && (size_t)info.st_size == expected) {
+            void* mapped = mmap(nullptr, expected, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                header = (Header*)mapped;
+                entries = (Entry*)((char*)mapped + sizeof(Header));
+                mappedBytes = expected;
+            }
+        }
+
+        // The table must describe exactly the sites this instance loaded
+        bool matches = header != nullptr && header->magic == MAGIC && (int)header->siteCount == sites.size();
+        for (int i = 0; matches && i < sites.size(); i++) {
+            matches = entries[i].key == keys[i] && entries[i].maxCapacity == sites[i].maxCapacity;
+        }
+        if (matches) {
+            // Held for as long as the table is mapped, so nobody replaces it under us
+            while (flock(fd, LOCK_SH) == -1 && errno == EINTR) {}
+            tableFd = fd;
+            break;
+        }
+
+        if (header != nullptr) {
+            munmap(header, mappedBytes);
+            header = nullptr;
+            entries = nullptr;
+        }
+        // Instances attached to the current table would keep counting on it
+        // after a replacement, so it is only rebuilt once none are left
+        if (fd != -1 && flock(fd, LOCK_EX | LOCK_NB) == -1) {
+            inUse = true;
+        }
+        if (fd != -1) {
+            close(fd);
+        }
+        if (inUse || attempt > 0 || !writeTable(path, keys, sites)) {
+            break;
+        }
+        created = true;
+    }
+
+    unlock();
+    if (header == nullptr) {
+        close(lockFd);
+        lockFd = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Unmaps the table and closes the lock file
+ */
+void SharedSiteTable::detach() {
+    if (header != nullptr) {
+        munmap(header, mappedBytes);
+        header = nullptr;
+        entries = nullptr;
+        mappedBytes = 0;
+    }
+    if (tableFd != -1) {
+        close(tableFd);  // Drops the shared flock
+        tableFd = -1;
+    }
+    if (lockFd != -1) {
+        close(lockFd);
+        lockFd = -1;
+    }
+}
+
+void SharedSiteTable::lock() {
+    if (lockFd != -1) {
+        while (flock(lockFd, LOCK_EX) == -1 && errno == EINTR) {}
+    }
+}
+
+void SharedSiteTable::unlock() {
+    if (lockFd != -1) {
+        flock(lockFd, LOCK_UN);
+    }
+}
+
+#else
+
+bool SharedSiteTable::attach(const std::string&, const CustomArray<uint64_t>&,
+                             const CustomArray<ReliefSite>&, bool& created, bool& inUse) {
+    created = false;
+    inUse = false;
+    return false;
+}
+
+void SharedSiteTable::detach() {
+}
+
+void SharedSiteTable::lock() {
+}
+
+void SharedSiteTable::unlock() {
+}
+
+#endif
+
+/**
+ * Change counter of the shared table
+ */
+uint64_t SharedSiteTable::generation() const {
+    return __atomic_load_n(&header->generation, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Current count of one site
+ */
+int SharedSiteTable::count(int slot) const {
+    return __atomic_load_n(&entries[slot].currentCount, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Takes one place at a site unless it is full
+ */
+bool SharedSiteTable::claim(int slot) {
+    int32_t* counter = &entries[slot].currentCount;
+    int32_t current = __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+    do {
+        if (current >= entries[slot].maxCapacity) {
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(counter, &current, current + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    __atomic_fetch_add(&header->generation, 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * Frees one place at a site
+ */
+bool SharedSiteTable::release(int slot) {
+    int32_t* counter = &entries[slot].currentCount;
+    int32_t current = __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+    do {
+        if (current <= 0) {
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(counter, &current, current - 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    __atomic_fetch_add(&header->generation, 1, __ATOMIC_RELEASE);
+    return true;
+}
@@ -0,0 +1,360 @@
+#include "../include/ShiftScheduler.hpp"
+#include "../include/Prototypes.hpp"
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <climits>
+
+static const char* DAY_NAMES[7] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+
+/**
+ * Day index (Mon = 0) from "Mon", "monday", ...; -1 if unknown
+ */
+static int parseDay(const std::string& text) {
+    if (text.size() < 3) return -1;
+    for (int d = 0; d < 7; d++) {
+        bool match = true;
+        for (int i = 0; i < 3; i++) {
+            if (std::tolower((unsigned char)text[i]) != std::tolower((unsigned char)DAY_NAMES[d][i])) {
+                match = false;
+                break;
+            }
+        }
+        if (match) return d;
+    }
+    return -1;
+}
+
+/**
+ * Minutes since midnight from "HH:MM" (00:00 to 24:00)
+ */
+static bool parseClock(const std::string& text, int& minutes) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos || colon == 0 || colon > 2 || text.size() != colon + 3) return false;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i != colon && !std::isdigit((unsigned char)text[i])) return false;
+    }
+
+    int hours = std::stoi(text.substr(0, colon));
+    int mins = std::stoi(text.substr(colon + 1));
+    if (mins > 59 || hours > 24 || (hours == 24 && mins != 0)) return false;
+    minutes = hours * 60 + mins;
+    return true;
+}
+
+static std::string formatClock(int minutes) {
+    std::ostringstream out;
+    out << (minutes / 60 < 10 ? "0" : "") << minutes / 60 << ":" << (minutes % 60 < 10 ? "0" : "") << minutes % 60;
+    return out.str();
+}
+
+/**
+ * Parses "Mon 08:00-16:00" or "Mon 08:00-Tue 16:00"
+ */
+bool parseTimeWindow(const std::string& text, TimeWindow& window) {
+    std::stringstream ss(trim(text));
+    std::string dayText, range;
+    if (!(ss >> dayText >> range)) return false;
+
+    std::string rest;
+    size_t dash = range.find('-');
+    if (dash == std::string::npos) return false;
+    std::string startText = range.substr(0, dash);
+    std::string endText = range.substr(dash + 1);
+
+    // "Mon 08:00- Tue 16:00" or "Mon 08:00-Tue 16:00": the end has its own day
+    int endDay = -1;
+    if (endText.empty() || !std::isdigit((unsigned char)endText[0])) {
+        std::string clock;
+        if (!(ss >> clock)) return false;
+        endDay = parseDay(endText);
+        endText = clock;
+        if (endDay == -1) return false;
+    }
+    if (ss >> rest) return false;
+
+    int day = parseDay(dayText);
+    int startClock, endClock;
+    if (day == -1 || !parseClock(startText, startClock) || !parseClock(endText, endClock) || startClock == 24 * 60) {
+        return false;
+    }
+
+    window.start = day * MINUTES_PER_DAY + startClock;
+    if (endDay == -1) {
+        // Ends at or before the start time: runs past midnight
+        window.end = day * MINUTES_PER_DAY + endClock;
+        if (endClock <= startClock) window.end += MINUTES_PER_DAY;
+    } else {
+        window.end = endDay * MINUTES_PER_DAY + endClock;
+        if (window.end <= window.start) window.end += MINUTES_PER_WEEK;
+    }
+    return true;
+}
+
+/**
+ * Formats a window as "Mon 08:00-16:00" (or "Mon 08:00-Wed 10:00" past a day)
+ */
+std::string formatTimeWindow(const TimeWindow& window) {
+    int startDay = (window.start / MINUTES_PER_DAY) % 7;
+    int startClock = window.start % MINUTES_PER_DAY;
+    std::string result = std::string(DAY_NAMES[startDay]) + " " + formatClock(startClock) + "-";
+
+    int dayStart = window.start - startClock;
+    if (window.end <= dayStart + MINUTES_PER_DAY) {
+        return result + formatClock(window.end - dayStart);
+    }
+    if (window.length() < MINUTES_PER_DAY) {
+        return result + formatClock(window.end % MINUTES_PER_DAY);
+    }
+    return result + DAY_NAMES[(window.end / MINUTES_PER_DAY) % 7] + " " + formatClock(window.end % MINUTES_PER_DAY);
+}
+
+/**
+ * Parses a comma-separated list of windows
+ */
+bool parseTimeWindowList(const std::string& text, CustomArray<TimeWindow>& windows) {
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        part = trim(part);
+        if (part.empty()) continue;
+
+        TimeWindow window;
+        if (!parseTimeWindow(part, window)) return false;
+        windows.push_back(window);
+    }
+    return true;
+}
+
+/**
+ * Adds a volunteer; overlapping or touching windows are merged
+ */
+int ShiftScheduler::addVolunteer(const Volunteer& volunteer, const CustomArray<TimeWindow>& windows) {
+    Candidate candidate;
+    candidate.volunteer = volunteer;
+
+    CustomArray<TimeWindow> sorted(windows);
+    std::sort(sorted.begin(), sorted.end(), [](const TimeWindow& a, const TimeWindow& b) {
+        return a.start < b.start;
+    });
+    for (int i = 0; i < sorted.size(); i++) {
+        if (sorted[i].length() <= 0) continue;
+        if (!candidate.windows.empty() && sorted[i].start <= candidate.windows.back().end) {
+            if (sorted[i].end > candidate.windows.back().end) {
+                candidate.windows.back().end = sorted[i].end;
+            }
+        } else {
+            candidate.windows.push_back(sorted[i]);
+        }
+    }
+
+    int index = volunteers.size();
+    volunteers.push_back(candidate);
+    byContact.insert(volunteer.contact, index);
+    return index;
+}
+
+/**
+ * Adds a shift
+ */
+int ShiftScheduler::addShift(const ShiftSlot& shift) {
+    shifts.push_back(shift);
+    return shifts.size() - 1;
+}
+
+/**
+ * Indexes everything added so far
+ */
+void ShiftScheduler::build() {
+    availability.clear();
+    for (int v = 0; v < volunteers.size(); v++) {
+        const CustomArray<TimeWindow>& windows = volunteers[v].windows;
+        for (int w = 0; w < windows.size(); w++) {
+            availability.insert(windows[w], v);
+        }
+    }
+    availability.build();
+
+    shiftTree.clear();
+    for (int s = 0; s < shifts.size(); s++) {
+        shiftTree.insert(shifts[s].window, s);
+    }
+    shiftTree.build();
+}
+
+/**
+ * Unordered volunteers covering a span (merged windows never repeat a volunteer)
+ */
+void ShiftScheduler::collectAvailable(const TimeWindow& window, CustomArray<int>& result) const {
+    result.clear();
+    availability.forEachContaining(window, [&result](const TimeWindow&, int volunteer) {
+        result.push_back(volunteer);
+    });
+}
+
+/**
+ * Volunteers whose availability covers a time span, in registration order
+ */
+void ShiftScheduler::availableFor(const TimeWindow& window, CustomArray<int>& result) const {
+    collectAvailable(window, result);
+    std::sort(result.begin(), result.end());
+}
+
+/**
+ * Shifts that fit entirely inside one of a volunteer's windows, by start time
+ */
+void ShiftScheduler::shiftsFor(int volunteerIndex, CustomArray<int>& result) const {
+    result.clear();
+    const CustomArray<TimeWindow>& windows = volunteers[volunteerIndex].windows;
+    for (int w = 0; w < windows.size(); w++) {
+        shiftTree.forEachWithin(windows[w], [&result](const TimeWindow&, int shift) {
+            result.push_back(shift);
+        });
+    }
+
+    const CustomArray<ShiftSlot>& all = shifts;
+    std::sort(result.begin(), result.end(), [&all](int a, int b) {
+        return all[a].window.start < all[b].window.start ||
+               (all[a].window.start == all[b].window.start && a < b);
+    });
+}
+
+/**
+ * Fills every shift in start order, spreading hours across volunteers
+ */
+int ShiftScheduler::buildRoster(CustomArray<RosterAssignment>& roster, int maxMinutesPerVolunteer) const {
+    roster.clear();
+
+    CustomArray<int> order;
+    order.reserve(shifts.size());
+    for (int s = 0; s < shifts.size(); s++) {
+        order.push_back(s);
+    }
+    const CustomArray<ShiftSlot>& all = shifts;
+    std::sort(order.begin(), order.end(), [&all](int a, int b) {
+        return all[a].window.start < all[b].window.start ||
+               (all[a].window.start == all[b].window.start && a < b);
+    });
+
+    // Shifts are visited by start time, so a volunteer is free for the next
+    // shift exactly when it starts at or after the end of everything they hold
+    CustomArray<int> busyUntil;
+    CustomArray<int> minutes;
+    busyUntil.reserve(volunteers.size());
+    minutes.reserve(volunteers.size());
+    for (int v = 0; v < volunteers.size(); v++) {
+        busyUntil.push_back(INT_MIN);
+        minutes.push_back(0);
+    }
+
+    CustomArray<int> candidates;
+    int filled = 0;
+    for (int i = 0; i < order.size(); i++) {
+        const ShiftSlot& shift = shifts[order[i]];
+        if (shift.slots <= 0) continue;
+
+        collectAvailable(shift.window, candidates);
+        int eligible = 0;
+        for (int c = 0; c < candidates.size(); c++) {
+            int v = candidates[c];
+            if (busyUntil[v] <= shift.window.start && minutes[v] + shift.window.length() <= maxMinutesPerVolunteer) {
+                candidates[eligible++] = v;
+            }
+        }
+
+        int take = eligible < shift.slots ? eligible : shift.slots;
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.begin() + eligible,
+                          [&minutes](int a, int b) {
+                              return minutes[a] < minutes[b] || (minutes[a] == minutes[b] && a < b);
+                          });
+
+        for (int c = 0; c < take; c++) {
+            int v = candidates[c];
+            busyUntil[v] = shift.window.end;
+            minutes[v] += shift.window.length();
+            roster.push_back(RosterAssignment(order[i], v));
+        }
+        filled += take;
+    }
+    return filled;
+}
+
+/**
+ * Total open positions across all shifts
+ */
+int ShiftScheduler::totalSlots() const {
+    int total = 0;
+    for (int s = 0; s < shifts.size(); s++) {
+        total += shifts[s].slots > 0 ? shifts[s].slots : 0;
+    }
+    return total;
+}
+
+/**
+ * Reads weekly availability, one "Contact,window,window,..." line per volunteer
+ */
+void loadAvailability(CustomHashMap<std::string, CustomArray<TimeWindow> >& availability, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t comma = line.find(',');
+        std::string contact = trim(line.substr(0, comma));
+        CustomArray<TimeWindow> windows;
+        if (comma == std::string::npos || contact.empty() ||
+            !parseTimeWindowList(line.substr(comma + 1), windows)) {
+            std::cout << "Warning: Line " << lineNum << " in " << filename
+                      << " has invalid format (expected Contact,Mon 08:00-16:00,...)\n";
+            continue;
+        }
+        availability[contact] = windows;
+    }
+}
+
+/**
+ * Reads shifts, one "SiteName Day HH:MM-HH:MM Slots" line per shift
+ */
+void loadShifts(CustomArray<ShiftSlot>& shifts, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        // Site name first, slot count last, window in between
+        size_t firstSpace = line.find(' ');
+        size_t lastSpace = line.rfind(' ');
+        TimeWindow window;
+        int slots = 0;
+        bool valid = firstSpace != std::string::npos && lastSpace > firstSpace &&
+                     parseTimeWindow(line.substr(firstSpace + 1, lastSpace - firstSpace - 1), window);
+        if (valid) {
+            try {
+                slots = std::stoi(line.substr(lastSpace + 1));
+            } catch (const std::exception&) {
+                valid = false;
+            }
+        }
+
+        if (!valid || slots <= 0) {
+            std::cout << "Warning: Line " << lineNum << " in " << filename
+                      << " has invalid format (expected SiteName Mon 08:00-16:00 Slots)\n";
+            continue;
+        }
+        shifts.push_back(ShiftSlot(line.substr(0, firstSpace), window, slots));
+    }
+}
@@ -0,0 +1,484 @@
+#include "../include/Simulator.hpp"
+#include "../include/SiteAlgorithm.hpp"
+#include "../include/Prototypes.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Pending shift end at a site
+ */
+struct Departure {
+    double time;
+    int siteIndex;
+
+    Departure(double t = 0, int site = 0) : time(t), siteIndex(site) {}
+};
+
+/**
+ * Binary min-heap helpers over a CustomArray of departures (earliest first)
+ */
+static void pushDeparture(CustomArray<Departure>& heap, const Departure& d) {
+    heap.push_back(d);
+    int child = heap.size() - 1;
+    while (child > 0) {
+        int parent = (child - 1) / 2;
+        if (heap[parent].time <= heap[child].time) break;
+        Departure temp = heap[parent];
+        heap[parent] = heap[child];
+        heap[child] = temp;
+        child = parent;
+    }
+}
+
+static Departure popDeparture(CustomArray<Departure>& heap) {
+    Departure top = heap[0];
+    heap[0] = heap.back();
+    heap.pop_back();
+
+    int parent = 0;
+    int n = heap.size();
+    for (;;) {
+        int smallest = parent;
+        int left = 2 * parent + 1;
+        int right = left + 1;
+        if (left < n && heap[left].time < heap[smallest].time) smallest = left;
+        if (right < n && heap[right].time < heap[smallest].time) smallest = right;
+        if (smallest == parent) break;
+        Departure temp = heap[parent];
+        heap[parent] = heap[smallest];
+        heap[smallest] = temp;
+        parent = smallest;
+    }
+    return top;
+}
+
+/**
+ * Generates arrival times for the configured pattern
+ */
+class ArrivalStream {
+private:
+    const SimulationConfig& config;
+    std::mt19937& rng;
+    bool inBurst;
+    double stateEnd;
+    const CustomArray<double>& replayTimes;
+    int replayIndex;
+
+    double exponential(double mean) {
+        std::exponential_distribution<double> dist(1.0 / mean);
+        return dist(rng);
+    }
+
+public:
+    ArrivalStream(const SimulationConfig& c, std::mt19937& r, const CustomArray<double>& replay)
+        : config(c), rng(r), inBurst(false), stateEnd(0), replayTimes(replay), replayIndex(0) {
+        if (config.pattern == ARRIVAL_BURSTY) {
+            stateEnd = exponential(normalLength());
+        }
+    }
+
+    double normalLength() const {
+        return config.meanBurstLength * (1.0 - config.burstFraction) / config.burstFraction;
+    }
+
+    /**
+     * Returns the first arrival after time t (or a time past the end when exhausted)
+     */
+    double next(double t) {
+        if (config.pattern == ARRIVAL_REPLAY) {
+            return replayIndex < replayTimes.size() ? replayTimes[replayIndex++] : config.duration + 1.0;
+        }
+
+        if (config.pattern == ARRIVAL_POISSON) {
+            return t + exponential(1.0 / config.arrivalRate);
+        }
+
+        // Bursty: exponential gaps are memoryless, so redraw whenever the state flips
+        for (;;) {
+            double rate = inBurst ? config.arrivalRate * config.burstFactor : config.arrivalRate;
+            double candidate = t + exponential(1.0 / rate);
+            if (candidate <= stateEnd) {
+                return candidate;
+            }
+            t = stateEnd;
+            inBurst = !inBurst;
+            stateEnd = t + exponential(inBurst ? config.meanBurstLength : normalLength());
+        }
+    }
+};
+
+/**
+ * Reads replay arrival times. Lines starting with a number are taken as
+ * arrival times in hours; any other record (e.g. a volunteers.txt line) is
+ * spaced evenly at the configured arrival rate.
+ */
+static CustomArray<double> loadReplayTimes(const SimulationConfig& config) {
+    CustomArray<double> times;
+    std::ifstream file(config.replayFile);
+    if (!file.is_open()) {
+        std::cout << "Warning: Could not open replay file '" << config.replayFile << "'\n";
+        return times;
+    }
+
+    std::string line;
+    double lastTime = 0;
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty()) continue;
+
+        char* end = nullptr;
+        double value = std::strtod(line.c_str(), &end);
+        if (end != line.c_str() && value >= lastTime) {
+            lastTime = value;
+        } else {
+            lastTime += 1.0 / config.arrivalRate;
+        }
+        times.push_back(lastTime);
+    }
+    return times;
+}
+
+/**
+ * Event loop of runSimulation, instantiated once per site-selection policy
+ * so the dispatch scan inlines the policy's comparison
+ */
+template<typename Policy>
+static SimulationResult simulateWith(const CustomLinkedList<ReliefSite>& sites, const SimulationConfig& config,
+                                     Policy& policy) {
+    SimulationResult result;
+    std::mt19937 rng(config.seed);
+    std::exponential_distribution<double> shiftLength(1.0 / config.meanShiftLength);
+
+    CustomArray<double> replayTimes;
+    if (config.pattern == ARRIVAL_REPLAY) {
+        replayTimes = loadReplayTimes(config);
+    }
+
+    // Working copy of the site layout with contiguous storage
+    CustomArray<ReliefSite> table;
+    for (auto it = sites.begin(); it != sites.end(); ++it) {
+        table.push_back(*it);
+    }
+    int siteCount = table.size();
+
+    CustomArray<double> occupiedArea;  // Integral of currentCount over time, per site
+    CustomArray<double> lastChange;
+    CustomArray<Departure> departures;
+    int totalCapacity = 0;
+    int freeSlots = 0;
+    int occupied = 0;
+
+    for (int i = 0; i < siteCount; i++) {
+        occupiedArea.push_back(0);
+        lastChange.push_back(0);
+        totalCapacity += table[i].maxCapacity;
+        freeSlots += table[i].currentCount < table[i].maxCapacity ? table[i].maxCapacity - table[i].currentCount : 0;
+        occupied += table[i].currentCount;
+
+        // Volunteers already on site finish their shifts like everyone else
+        for (int v = 0; v < table[i].currentCount; v++) {
+            pushDeparture(departures, Departure(shiftLength(rng), i));
+        }
+    }
+
+    VolunteerQueue queue;
+    const Volunteer synthetic("Simulated", "sim", "General");
+    CustomArray<double> arrivalTimes;  // Parallel FIFO of enqueue times
+    int arrivalHead = 0;
+    int queueDepth = 0;
+
+    ArrivalStream arrivals(config, rng, replayTimes);
+    double nextArrival = arrivals.next(0);
+
+    SimulationSample current;
+    double intervalStart = 0;
+    double intervalArea = 0;   // Integral of total occupancy over the interval
+    double intervalWait = 0;
+    double lastEvent = 0;
+    double totalWait = 0;
+    double nextSample = config.reportInterval;
+
+    auto started = std::chrono::steady_clock::now();
+
+    for (;;) {
+        double nextDeparture = departures.empty() ? config.duration + 1.0 : departures[0].time;
+        bool isArrival = nextArrival <= nextDeparture;
+        double t = isArrival ? nextArrival : nextDeparture;
+        if (t > config.duration) {
+            t = config.duration;
+        }
+
+        // Close every report interval that ends before this event
+        while (nextSample <= t) {
+            intervalArea += (nextSample - lastEvent) * occupied;
+            lastEvent = nextSample;
+            current.time = nextSample;
+            current.queueDepth = queueDepth;
+            current.meanWait = current.deployed > 0 ? intervalWait / current.deployed : 0;
+            current.utilization = totalCapacity > 0
+                ? intervalArea / ((nextSample - intervalStart) * totalCapacity) : 0;
+            result.samples.push_back(current);
+
+            current = SimulationSample();
+            current.maxQueueDepth = queueDepth;
+            intervalStart = nextSample;
+            intervalArea = 0;
+            intervalWait = 0;
+            nextSample += config.reportInterval;
+        }
+
+        intervalArea += (t - lastEvent) * occupied;
+        lastEvent = t;
+        if (t >= config.duration) {
+            break;
+        }
+
+        if (isArrival) {
+            queue.enqueue(synthetic);
+            arrivalTimes.push_back(t);
+            queueDepth++;
+            result.arrivals++;
+            nextArrival = arrivals.next(t);
+        } else {
+            Departure d = popDeparture(departures);
+            ReliefSite& site = table[d.siteIndex];
+            occupiedArea[d.siteIndex] += (t - lastChange[d.siteIndex]) * site.currentCount;
+            lastChange[d.siteIndex] = t;
+            if (site.currentCount <= site.maxCapacity) {
+                freeSlots++;
+            }
+            site.currentCount--;
+            occupied--;
+            result.departures++;
+        }
+        result.events++;
+
+        // Dispatch FIFO while any site has room
+        while (queueDepth > 0 && freeSlots > 0) {
+            int best = selectSite(table, policy);
+            if (best == -1) break;
+
+            queue.dequeue();
+            double wait = t - arrivalTimes[arrivalHead++];
+            queueDepth--;
+
+            ReliefSite& site = table[best];
+            occupiedArea[best] += (t - lastChange[best]) * site.currentCount;
+            lastChange[best] = t;
+            site.currentCount++;
+            occupied++;
+            freeSlots--;
+            pushDeparture(departures, Departure(t + shiftLength(rng), best));
+
+            totalWait += wait;
+            intervalWait += wait;
+            if (wait > result.maxWait) result.maxWait = wait;
+            current.deployed++;
+            result.deployments++;
+        }
+
+        if (queueDepth > current.maxQueueDepth) current.maxQueueDepth = queueDepth;
+        if (queueDepth > result.maxQueueDepth) result.maxQueueDepth = queueDepth;
+
+        // Drop consumed arrival times once they make up half the buffer
+        if (arrivalHead > 4096 && arrivalHead * 2 > arrivalTimes.size()) {
+            CustomArray<double> remaining;
+            remaining.reserve(arrivalTimes.size() - arrivalHead);
+            for (int i = arrivalHead; i < arrivalTimes.size(); i++) {
+                remaining.push_back(arrivalTimes[i]);
+            }
+            arrivalTimes = remaining;
+            arrivalHead = 0;
+        }
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.meanWait = result.deployments > 0 ? totalWait / result.deployments : 0;
+
+    for (int i = 0; i < siteCount; i++) {
+        occupiedArea[i] += (config.duration - lastChange[i]) * table[i].currentCount;
+        double capacityTime = (double)table[i].maxCapacity * config.duration;
+        result.siteUtilization.push_back(capacityTime > 0 ? occupiedArea[i] / capacityTime : 0);
+    }
+
+    return result;
+}
+
+/**
+ * Runs a discrete-event simulation of arrivals, deployments and shift ends
+ */
+SimulationResult runSimulation(const CustomLinkedList<ReliefSite>& sites, const SimulationConfig& config) {
+    SiteSelectionState state;
+    switch (config.policy) {
+        case POLICY_LOWEST_COUNT: {
+            LowestCountPolicy policy;
+            return simulateWith(sites, config, policy);
+        }
+        case POLICY_MOST_FREE: {
+            MostFreeSlotsPolicy policy;
+            return simulateWith(sites, config, policy);
+        }
+        case POLICY_WEIGHTED:
+            return simulateWith(sites, config, state.weighted);
+        case POLICY_ROUND_ROBIN:
+            return simulateWith(sites, config, state.roundRobin);
+        default: {
+            LowestRatioPolicy policy;
+            return simulateWith(sites, config, policy);
+        }
+    }
+}
+
+/**
+ * Prints the time series, per-site utilization and throughput of a run
+ */
+void printSimulationReport(const CustomLinkedList<ReliefSite>& sites, const SimulationConfig& config,
+                           const SimulationResult& result) {
+    const char* patternNames[] = { "Poisson", "Bursty", "Replay" };
+
+    std::cout << "\n=== WHAT-IF DEPLOYMENT SIMULATION ===\n";
+    std::cout << "Arrival pattern: " << patternNames[config.pattern]
+              << " | Mean rate: " << config.arrivalRate << "/h"
+              << " | Mean shift: " << config.meanShiftLength << "h"
+              << " | Duration: " << config.duration << "h"
+              << " | Site policy: " << sitePolicyName(config.policy) << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "Time(h)"
+              << std::setw(10) << "Queue"
+              << std::setw(10) << "Peak"
+              << std::setw(14) << "Mean Wait(h)"
+              << std::setw(14) << "Utilization"
+              << std::setw(10) << "Deployed" << "\n";
+    std::cout << std::string(68, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const SimulationSample* s = result.samples.begin(); s != result.samples.end(); ++s) {
+        std::cout << std::left << std::setw(10) << s->time
+                  << std::setw(10) << s->queueDepth
+                  << std::setw(10) << s->maxQueueDepth
+                  << std::setw(14) << s->meanWait
+                  << std::setw(14) << (std::to_string((int)(s->utilization * 100)) + "%")
+                  << std::setw(10) << s->deployed << "\n";
+    }
+    std::cout << std::string(68, '-') << "\n\n";
+
+    std::cout << "=== SITE UTILIZATION ===\n";
+    std::cout << std::left << std::setw(20) << "Site Name"
+              << std::setw(12) << "Capacity"
+              << std::setw(12) << "Avg Filled" << "\n";
+    std::cout << std::string(44, '-') << "\n";
+    int index = 0;
+    for (auto it = sites.begin(); it != sites.end(); ++it, ++index) {
+        std::cout << std::left << std::setw(20) << it->name
+                  << std::setw(12) << it->maxCapacity
+                  << std::setw(12) << (std::to_string((int)(result.siteUtilization[index] * 100)) + "%") << "\n";
+    }
+    std::cout << std::string(44, '-') << "\n\n";
+
+    std::cout << "=== SUMMARY ===\n";
+    std::cout << "Arrivals: " << result.arrivals << " | Deployments: " << result.deployments
+              << " | Shift ends: " << result.departures << "\n";
+    std::cout << "Mean wait: " << result.meanWait << "h | Max wait: " << result.maxWait
+              << "h | Peak queue depth: " << result.maxQueueDepth << "\n";
+    double rate = result.wallSeconds > 0 ? result.events / result.wallSeconds : 0;
+    std::cout << "Events processed: " << result.events << " in " << std::setprecision(3)
+              << result.wallSeconds << "s (" << std::setprecision(0) << rate << " events/s)\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+/**
+ * Prints command-line help for simulation mode
+ */
+static void printSimulationUsage() {
+    std::cout << "Usage: volunteer_system --simulate [options]\n"
+              << "  --pattern poisson|bursty|replay   Arrival stream (default poisson)\n"
+              << "  --rate N          Mean arrivals per hour (default 10)\n"
+              << "  --burst-factor N  Surge rate multiplier for bursty (default 5)\n"
+              << "  --burst-share N   Fraction of time in surges for bursty (default 0.1)\n"
+              << "  --burst-length N  Mean surge length in hours (default 4)\n"
+              << "  --shift N         Mean shift length in hours (default 8)\n"
+              << "  --hours N         Simulated duration in hours (default 168)\n"
+              << "  --interval N      Report interval in hours (default 12)\n"
+              << "  --seed N          Random seed (default 42)\n"
+              << "  --policy NAME     Site selection: lowest-ratio, lowest-count, most-free,\n"
+              << "                    weighted or round-robin (default lowest-ratio)\n"
+              << "  --replay FILE     Arrival log for the replay pattern\n"
+              << "  --sites FILE      Site layout (default ../data/relief_sites.txt)\n";
+}
+
+/**
+ * Entry point for "--simulate" mode; parses options and prints the report
+ */
+int runSimulationMode(int argc, char* argv[]) {
+    SimulationConfig config;
+    std::string sitesFile = "../data/relief_sites.txt";
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--help") {
+            printSimulationUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Error: Missing value for option '" << option << "'\n";
+            printSimulationUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (option == "--pattern") {
+            if (value == "poisson") config.pattern = ARRIVAL_POISSON;
+            else if (value == "bursty") config.pattern = ARRIVAL_BURSTY;
+            else if (value == "replay") config.pattern = ARRIVAL_REPLAY;
+            else {
+                std::cout << "Error: Unknown arrival pattern '" << value << "'\n";
+                return 1;
+            }
+        } else if (option == "--rate") config.arrivalRate = std::atof(value.c_str());
+        else if (option == "--burst-factor") config.burstFactor = std::atof(value.c_str());
+        else if (option == "--burst-share") config.burstFraction = std::atof(value.c_str());
+        else if (option == "--burst-length") config.meanBurstLength = std::atof(value.c_str());
+        else if (option == "--shift") config.meanShiftLength = std::atof(value.c_str());
+        else if (option == "--hours") config.duration = std::atof(value.c_str());
+        else if (option == "--interval") config.reportInterval = std::atof(value.c_str());
+        else if (option == "--seed") config.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        else if (option == "--replay") config.replayFile = value;
+        else if (option == "--sites") sitesFile = value;
+        else if (option == "--policy") {
+            if (!parseSitePolicy(value, config.policy)) {
+                std::cout << "Error: Unknown site policy '" << value << "'\n";
+                return 1;
+            }
+        }
+        else {
+            std::cout << "Error: Unknown option '" << option << "'\n";
+            printSimulationUsage();
+            return 1;
+        }
+    }
+
+    if (config.arrivalRate <= 0 || config.meanShiftLength <= 0 || config.duration <= 0 ||
+        config.reportInterval <= 0 || config.burstFactor <= 0 || config.meanBurstLength <= 0 ||
+        config.burstFraction <= 0 || config.burstFraction >= 1) {
+        std::cout << "Error: Rates, durations and intervals must be positive (burst share between 0 and 1).\n";
+        return 1;
+    }
+    if (config.pattern == ARRIVAL_REPLAY && config.replayFile.empty()) {
+        std::cout << "Error: The replay pattern requires --replay FILE.\n";
+        return 1;
+    }
+
+    CustomLinkedList<ReliefSite> sites = loadReliefSites(sitesFile);
+    if (sites.empty()) {
+        std::cout << "Error: Could not load relief sites data.\n";
+        return 1;
+    }
+
+    SimulationResult result = runSimulation(sites, config);
+    printSimulationReport(sites, config, result);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "../include/Snapshot.hpp"
+#include "../include/RegionRegistry.hpp"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+
+/**
+ * Prints the volunteer table
+ */
+void QueueView::display() const {
+    if (volunteers.empty()) {
+        std::cout << "No volunteers currently registered.\n";
+        return;
+    }
+
+    bool priority = mode == VolunteerQueue::PRIORITY_DISPATCH;
+    int width = priority ? 76 : 70;
+
+    // Priority order lists the highest lane first, FIFO within each lane
+    // (aging may pull the oldest volunteer forward at dispatch time)
+    std::cout << "\n=== REGISTERED VOLUNTEERS (" << (priority ? "Priority" : "FIFO") << " Order) ===\n";
+    std::cout << std::left << std::setw(5) << "Pos";
+    if (priority) {
+        std::cout << std::setw(6) << "Lane";
+    }
+    std::cout << std::setw(20) << "Name"
+              << std::setw(25) << "Contact"
+              << std::setw(20) << "Skill" << "\n";
+    std::cout << std::string(width, '-') << "\n";
+
+    for (int i = 0; i < volunteers.size(); i++) {
+        std::cout << std::left << std::setw(5) << std::to_string(i + 1);
+        if (priority) {
+            std::cout << std::setw(6) << lanes[i];
+        }
+        std::cout << std::setw(20) << volunteers[i].name
+                  << std::setw(25) << volunteers[i].contact
+                  << std::setw(20) << volunteers[i].skill << "\n";
+    }
+
+    std::cout << std::string(width, '-') << "\n";
+    std::cout << "Total volunteers in queue: " << volunteers.size() << "\n";
+}
+
+/**
+ * Copies every shard's sites
+ */
+void SiteView::capture(const RegionRegistry& registry) {
+    version = registry.getVersion();
+    sites.clear();
+    regions.clear();
+    sites.reserve(registry.totalSites());
+    regions.reserve(registry.totalSites());
+
+    for (int s = 0; s < registry.shardCount(); s++) {
+        const RegionShard& shard = registry.shard(s);
+        const CustomArray<ReliefSite>& shardSites = shard.sites.all();
+        for (int i = 0; i < shardSites.size(); i++) {
+            sites.push_back(shardSites[i]);
+            regions.push_back(shard.region);
+        }
+    }
+}
+
+SnapshotStore::SnapshotStore()
+    : queueSnapshot(std::make_shared<QueueView>()), siteSnapshot(std::make_shared<SiteView>()) {
+}
+
+/**
+ * Publishes a new queue view if the queue changed
+ */
+bool SnapshotStore::publishQueue(const VolunteerQueue& queue) {
+    // Only the owner thread publishes, so this read cannot race with a swap
+    if (queueSnapshot->version == queue.getVersion()) {
+        return false;
+    }
+
+    std::shared_ptr<QueueView> view = std::make_shared<QueueView>();
+    view->capture(queue);
+    std::atomic_store(&queueSnapshot, std::shared_ptr<const QueueView>(view));
+    return true;
+}
+
+/**
+ * Publishes a new site view if any site count changed
+ */
+bool SnapshotStore::publishSites(const RegionRegistry& registry) {
+    if (siteSnapshot->version == registry.getVersion()) {
+        return false;
+    }
+
+    std::shared_ptr<SiteView> view = std::make_shared<SiteView>();
+    view->capture(registry);
+    std::atomic_store(&siteSnapshot, std::shared_ptr<const SiteView>(view));
+    return true;
+}
+
+/**
+ * Latest published queue view
+ */
+std::shared_ptr<const QueueView> SnapshotStore::queueView() const {
+    return std::atomic_load(&queueSnapshot);
+}
+
+/**
+ * Latest published site view
+ */
+std::shared_ptr<const SiteView> SnapshotStore::siteView() const {
+    return std::atomic_load(&siteSnapshot);
+}
@@ -0,0 +1,109 @@
+#include "../include/SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr double SiteSpatialIndex::KM_PER_DEGREE_LAT;
+
+/**
+ * Rebuilds the tree (balanced, median splits) from the given sites
+ */
+void SiteSpatialIndex::build(const CustomArray<Entry>& entries) {
+    nodes.clear();
+    nodeOf.clear();
+    root = -1;
+    if (entries.empty()) return;
+
+    // Project around the mean latitude so east-west distances are not stretched
+    double latitudeSum = 0;
+    for (int i = 0; i < entries.size(); i++) {
+        latitudeSum += entries[i].latitude;
+    }
+    double meanLatitude = latitudeSum / entries.size();
+    kmPerDegreeLon = 111.32 * std::cos(meanLatitude * 3.14159265358979323846 / 180.0);
+    if (kmPerDegreeLon < 1.0) kmPerDegreeLon = 1.0;  // Avoid collapsing at the poles
+
+    nodes.reserve(entries.size());
+    for (int i = 0; i < entries.size(); i++) {
+        KdNode node;
+        node.x = entries[i].longitude * kmPerDegreeLon;
+        node.y = entries[i].latitude * KM_PER_DEGREE_LAT;
+        node.location = entries[i].location;
+        node.open = entries[i].open;
+        nodes.push_back(node);
+    }
+
+    // Build over an index permutation, then lay the nodes out as they were chosen
+    CustomArray<int> order;
+    order.reserve(nodes.size());
+    for (int i = 0; i < nodes.size(); i++) {
+        order.push_back(i);
+    }
+    root = build(order.begin(), order.size(), 0, -1);
+
+    for (int i = 0; i < nodes.size(); i++) {
+        nodeOf.insert(key(nodes[i].location), i);
+    }
+}
+
+/**
+ * Recursively splits order[0, count) on the median; returns the subtree root
+ */
+int SiteSpatialIndex::build(int* order, int count, int depth, int parent) {
+    if (count <= 0) return -1;
+
+    int axis = depth % 2;
+    int middle = count / 2;
+    CustomArray<KdNode>& all = nodes;
+    std::nth_element(order, order + middle, order + count, [&all, axis](int a, int b) {
+        return axis == 0 ? all[a].x < all[b].x : all[a].y < all[b].y;
+    });
+
+    int index = order[middle];
+    KdNode& node = nodes[index];
+    node.axis = axis;
+    node.parent = parent;
+    node.left = build(order, middle, depth + 1, index);
+    node.right = build(order + middle + 1, count - middle - 1, depth + 1, index);
+
+    // Bounding box and open count from the children
+    node.minX = node.maxX = node.x;
+    node.minY = node.maxY = node.y;
+    node.openCount = node.open ? 1 : 0;
+    int children[2] = { node.left, node.right };
+    for (int c = 0; c < 2; c++) {
+        if (children[c] == -1) continue;
+        const KdNode& child = nodes[children[c]];
+        node.minX = std::min(node.minX, child.minX);
+        node.maxX = std::max(node.maxX, child.maxX);
+        node.minY = std::min(node.minY, child.minY);
+        node.maxY = std::max(node.maxY, child.maxY);
+        node.openCount += child.openCount;
+    }
+    return index;
+}
+
+/**
+ * Marks a site as having room or being full, updating subtree counts
+ */
+void SiteSpatialIndex::setOpen(const SiteLocation& location, bool open) {
+    const int* found = nodeOf.find(key(location));
+    if (found == nullptr) return;  // Site has no coordinates
+
+    KdNode& node = nodes[*found];
+    if (node.open == open) return;
+    node.open = open;
+
+    int delta = open ? 1 : -1;
+    for (int index = *found; index != -1; index = nodes[index].parent) {
+        nodes[index].openCount += delta;
+    }
+}
+
+/**
+ * Approximate distance in km between two coordinates in this index's projection
+ */
+double SiteSpatialIndex::distanceKm(double lat1, double lon1, double lat2, double lon2) const {
+    double dx = (lon1 - lon2) * kmPerDegreeLon;
+    double dy = (lat1 - lat2) * KM_PER_DEGREE_LAT;
+    return std::sqrt(dx * dx + dy * dy);
+}
@@ -0,0 +1,167 @@
+#include "../include/StartupLoader.hpp"
+#include "../include/SpscQueue.hpp"
+#include "../include/DeploymentIndex.hpp"
+#include "../include/Prototypes.hpp"
+#include "../include/AllocationProfiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+static const int BATCH_RECORDS = 512;         // Records handed between stages at a time
+static const unsigned STAGE_QUEUE_BATCHES = 16;
+static const size_t READ_CHUNK_BYTES = 256 * 1024;
+
+/**
+ * Records moving down the pipeline; each stage fills in its part and passes
+ * the batch on (ownership goes with it)
+ */
+struct RecordBatch {
+    CustomArray<std::string> lines;     // Reader: raw log lines
+    CustomArray<Volunteer> volunteers;  // Parser: valid records, in line order
+    CustomArray<char> deployed;         // Filter: 1 if volunteers[i] is already deployed
+};
+
+typedef SpscQueue<RecordBatch*> BatchQueue;
+
+/**
+ * Reader stage: archived lines, then the text log from startOffset read in
+ * large chunks and split into lines
+ */
+static void readStage(HistoryArchive* archive, const std::string& filename, long long startOffset,
+                      BatchQueue& out, RegistrationLoadResult& result) {
+    AllocationScope scope(AllocationProfiler::LOAD);
+    RecordBatch* batch = new RecordBatch;
+    auto emit = [&](std::string line) {
+        batch->lines.push_back(std::move(line));
+        if (batch->lines.size() >= BATCH_RECORDS) {
+            out.push(batch);
+            batch = new RecordBatch;
+        }
+    };
+
+    if (archive != nullptr && !archive->forEachLine(emit)) {
+        result.archiveCorrupt = true;
+    }
+
+    long long offset = startOffset;
+    std::ifstream file(filename, std::ios::binary);
+    if (file.is_open()) {
+        if (startOffset > 0) {
+            file.seekg(startOffset);
+        }
+        std::string chunk(READ_CHUNK_BYTES, '\0');
+        std::string partial;  // Line continuing into the next chunk
+        while (file.read(&chunk[0], chunk.size()) || file.gcount() > 0) {
+            size_t length = (size_t)file.gcount();
+            offset += (long long)length;
+            size_t start = 0;
+            const char* newline;
+            while ((newline = (const char*)std::memchr(chunk.data() + start, '\n', length - start)) != nullptr) {
+                size_t end = newline - chunk.data();
+                if (partial.empty()) {
+                    emit(chunk.substr(start, end - start));
+                } else {
+                    partial.append(chunk, start, end - start);
+                    emit(std::move(partial));
+                    partial.clear();
+                }
+                start = end + 1;
+            }
+            partial.append(chunk, start, length - start);
+        }
+        if (!partial.empty()) {
+            emit(std::move(partial));
+        }
+    }
+    result.offset = offset;
+
+    if (batch->lines.empty()) {
+        delete batch;
+    } else {
+        out.push(batch);
+    }
+    out.close();
+}
+
+/**
+ * Parser stage: trims each line and keeps the valid records
+ * (format: name,contact,skill[,latitude,longitude])
+ */
+static void parseStage(BatchQueue& in, BatchQueue& out) {
+    AllocationScope scope(AllocationProfiler::LOAD);
+    RecordBatch* batch;
+    while (in.pop(batch)) {
+        for (int i = 0; i < batch->lines.size(); i++) {
+            std::string line = trim(batch->lines[i]);
+            Volunteer volunteer;
+            if (!line.empty() && parseVolunteerRecord(line, volunteer)) {
+                batch->volunteers.push_back(std::move(volunteer));
+            }
+        }
+        batch->lines.clear();
+        out.push(batch);
+    }
+    out.close();
+}
+
+/**
+ * Deployed filter stage: marks volunteers with an active deployment
+ */
+static void filterStage(const std::string& deployedFile, const std::string& releasedFile,
+                        BatchQueue& in, BatchQueue& out) {
+    AllocationScope scope(AllocationProfiler::LOAD);
+    
+    // Counted once up front; the reader and parser run ahead meanwhile
+    CustomHashMap<std::string, int> activeCounts;
+    loadActiveDeploymentCounts(activeCounts, deployedFile, releasedFile);
+
+    RecordBatch* batch;
+    while (in.pop(batch)) {
+        for (int i = 0; i < batch->volunteers.size(); i++) {
+            const int* deployedCount = activeCounts.find(volunteerKey(batch->volunteers[i]));
+            batch->deployed.push_back(deployedCount != nullptr && *deployedCount > 0 ? 1 : 0);
+        }
+        out.push(batch);
+    }
+    out.close();
+}
+
+/**
+ * Loads the registration history into a queue through the staged pipeline
+ */
+RegistrationLoadResult loadRegistrationsPipelined(VolunteerQueue& queue, HistoryArchive* archive,
+                                                  const std::string& registrationFile, long long startOffset,
+                                                  const std::string& deployedFile, const std::string& releasedFile) {
+    RegistrationLoadResult result;
+    BatchQueue lines(STAGE_QUEUE_BATCHES);
+    BatchQueue parsed(STAGE_QUEUE_BATCHES);
+    BatchQueue filtered(STAGE_QUEUE_BATCHES);
+
+    std::thread reader(readStage, archive, std::cref(registrationFile), startOffset,
+                       std::ref(lines), std::ref(result));
+    std::thread parser(parseStage, std::ref(lines), std::ref(parsed));
+    std::thread filter(filterStage, std::cref(deployedFile), std::cref(releasedFile),
+                       std::ref(parsed), std::ref(filtered));
+
+    // Enqueue stage: batches arrive in log order, so the queue keeps file order
+    RecordBatch* batch;
+    while (filtered.pop(batch)) {
+        for (int i = 0; i < batch->volunteers.size(); i++) {
+            if (batch->deployed[i]) {
+                result.skipped++;
+                std::cout << "Skipping already deployed volunteer: " << batch->volunteers[i].name << "\n";
+            } else {
+                queue.enqueue(batch->volunteers[i]);
+                result.loaded++;
+            }
+        }
+        delete batch;
+    }
+
+    reader.join();
+    parser.join();
+    filter.join();
+    return result;
+}
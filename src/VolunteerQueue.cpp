@@ -1,4 +1,6 @@
 #include "../include/VolunteerQueue.hpp"
+#include "../include/Snapshot.hpp"
+#include "../include/VolunteerSpill.hpp"
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
@@ -7,118 +9,447 @@
 /**
  * Constructor - initializes empty queue
  */
-VolunteerQueue::VolunteerQueue() : head(nullptr), tail(nullptr) {
+LinkedVolunteerQueue::LinkedVolunteerQueue()
+    : head(nullptr), tail(nullptr), laneMask(0), count(0), version(0),
+      mode(FIFO_DISPATCH), agingThreshold(0), bypassCount(0),
+      memoryBudget(0), residentBytes(0), spill(nullptr) {
+    for (int i = 0; i < PRIORITY_LEVELS; i++) {
+        laneHead[i] = laneTail[i] = nullptr;
+    }
+}
+
+/**
+ * Index of the highest set bit (mask must be non-zero)
+ */
+static int highestLane(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(mask);
+#else
+    int lane = 0;
+    while (mask >>= 1) {
+        lane++;
+    }
+    return lane;
+#endif
+}
+
+/**
+ * Approximate heap footprint of one resident volunteer
+ */
+static long long nodeFootprint(const Volunteer& v) {
+    return (long long)sizeof(Node) + (long long)(v.name.capacity() + v.contact.capacity() + v.skill.capacity());
 }
 
 /**
  * Destructor - cleans up all allocated memory
  */
-VolunteerQueue::~VolunteerQueue() {
-    // Dequeue all remaining volunteers to free memory
-    while (!isEmpty()) {
-        try {
-            dequeue();
-        } catch (const std::runtime_error&) {
-            // Should not happen since we check isEmpty(), but just in case
-            break;
-        }
+LinkedVolunteerQueue::~LinkedVolunteerQueue() {
+    // Free the nodes directly; dequeuing would read every spilled segment back
+    while (head != nullptr) {
+        Node* next = head->next;
+        delete head;
+        head = next;
     }
+    delete spill;
 }
 
 /**
  * Adds a volunteer to the rear of the queue
  */
-void VolunteerQueue::enqueue(const Volunteer& v) {
-    Node* newNode = new Node(v);
+void LinkedVolunteerQueue::enqueue(const Volunteer& v) {
+    queuedPerSkill[v.skill]++;
+    
+    // Once anyone is spilled, later arrivals must queue behind them
+    if (spill != nullptr && (!spill->empty() || (head != nullptr && residentBytes >= memoryBudget / 2))) {
+        spill->push(v);
+        version++;
+        return;
+    }
+    linkNode(v, priorityOf(v));
+    version++;
+}
+
+/**
+ * Links a volunteer in as a resident node at the rear
+ */
+void LinkedVolunteerQueue::linkNode(const Volunteer& v, int lane) {
+    Node* newNode = new Node(v, lane);
+    residentBytes += nodeFootprint(newNode->data);
     
     if (isEmpty()) {
         // First node in the queue
         head = tail = newNode;
     } else {
         // Add to the rear
+        newNode->prev = tail;
         tail->next = newNode;
         tail = newNode;
     }
+    
+    // Add to the rear of its lane
+    if (laneTail[lane] == nullptr) {
+        laneHead[lane] = laneTail[lane] = newNode;
+        laneMask |= 1u << lane;
+    } else {
+        laneTail[lane]->laneNext = newNode;
+        laneTail[lane] = newNode;
+    }
+    count++;
+}
+
+/**
+ * Moves spilled volunteers into the resident window while it has room
+ */
+void LinkedVolunteerQueue::admitSpilled() {
+    Volunteer v;
+    while (spill != nullptr && (head == nullptr || residentBytes < memoryBudget / 2) && spill->pop(v)) {
+        linkNode(v, priorityOf(v));
+    }
+}
+
+/**
+ * Moves every volunteer of batch to the rear of this queue by relinking
+ */
+void LinkedVolunteerQueue::enqueueBulk(LinkedVolunteerQueue& batch) {
+    if (&batch == this || batch.isEmpty()) {
+        return;
+    }
+    
+    if (spill != nullptr || batch.spill != nullptr) {
+        // Spilled volunteers cannot be relinked; move them one by one in arrival order
+        while (batch.head != nullptr) {
+            Node* node = batch.head;
+            batch.head = node->next;
+            enqueue(node->data);
+            delete node;
+        }
+        Volunteer v;
+        while (batch.spill != nullptr && batch.spill->pop(v)) {
+            enqueue(v);
+        }
+        for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+            batch.laneHead[lane] = batch.laneTail[lane] = nullptr;
+        }
+        batch.tail = nullptr;
+        batch.laneMask = 0;
+        batch.count = 0;
+        batch.residentBytes = 0;
+        batch.queuedPerSkill.clear();
+        batch.version++;
+        return;
+    }
+    
+    // Arrival order: hang the batch chain off the current tail
+    if (isEmpty()) {
+        head = batch.head;
+    } else {
+        tail->next = batch.head;
+        batch.head->prev = tail;
+    }
+    tail = batch.tail;
+    
+    // Each lane chain is appended to the matching lane
+    for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+        if (batch.laneHead[lane] == nullptr) continue;
+        if (laneTail[lane] == nullptr) {
+            laneHead[lane] = batch.laneHead[lane];
+        } else {
+            laneTail[lane]->laneNext = batch.laneHead[lane];
+        }
+        laneTail[lane] = batch.laneTail[lane];
+        batch.laneHead[lane] = batch.laneTail[lane] = nullptr;
+    }
+    laneMask |= batch.laneMask;
+    count += batch.count;
+    batch.queuedPerSkill.forEach([this](const std::string& skill, int queued) {
+        queuedPerSkill[skill] += queued;
+    });
+    batch.queuedPerSkill.clear();
+    residentBytes += batch.residentBytes;
+    version++;
+    batch.version++;
+    
+    batch.head = batch.tail = nullptr;
+    batch.laneMask = 0;
+    batch.count = 0;
+    batch.residentBytes = 0;
+}
+
+/**
+ * Uses the same skill/contact lane rules and memory budget as another queue
+ */
+void LinkedVolunteerQueue::copyLaneRulesFrom(const LinkedVolunteerQueue& other) {
+    QueueLaneRules::operator=(other);
+    setMemoryBudget(other.memoryBudget, other.spillDirectory);
+}
+
+/**
+ * Bounds the memory used by queued volunteers
+ */
+void LinkedVolunteerQueue::setMemoryBudget(long long bytes, const std::string& directory) {
+    memoryBudget = bytes > 0 ? bytes : 0;
+    spillDirectory = directory;
+    
+    if (memoryBudget == 0) {
+        if (spill != nullptr) {
+            Volunteer v;
+            while (spill->pop(v)) {
+                linkNode(v, priorityOf(v));
+            }
+            delete spill;
+            spill = nullptr;
+            version++;
+        }
+        return;
+    }
+    
+    if (spill == nullptr) {
+        // A quarter of the budget for the spill's head, tail and prefetched segments
+        long long typical = (long long)sizeof(Node) + 3 * 32;
+        long long records = memoryBudget / 4 / 3 / typical;
+        spill = new VolunteerSpill(directory, records < 64 ? 64 : (int)(records > 1000000 ? 1000000 : records));
+    }
+    admitSpilled();
+}
+
+/**
+ * Number of volunteers currently spilled out of the resident window
+ */
+long long LinkedVolunteerQueue::spilledCount() const {
+    return spill != nullptr ? spill->size() : 0;
+}
+
+/**
+ * One part of the spilled volunteers, front part first
+ */
+bool LinkedVolunteerQueue::readSpilledPart(int part, CustomArray<Volunteer>& out) const {
+    return spill != nullptr && spill->readPart(part, out);
+}
+
+/**
+ * Takes a volunteer off the per-skill counts
+ */
+void LinkedVolunteerQueue::forgetQueued(const Volunteer& v) {
+    int* queued = queuedPerSkill.find(v.skill);
+    if (queued != nullptr && --(*queued) == 0) {
+        queuedPerSkill.erase(v.skill);
+    }
+}
+
+/**
+ * Unlinks a node from arrival order and frees it (removeIf relinks the lanes)
+ */
+void LinkedVolunteerQueue::unlinkForRemoval(Node* node) {
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
+    }
+    count--;
+    residentBytes -= nodeFootprint(node->data);
+    forgetQueued(node->data);
+    delete node;
+}
+
+bool LinkedVolunteerQueue::popSpilled(Volunteer& v) {
+    return spill != nullptr && spill->pop(v);
+}
+
+void LinkedVolunteerQueue::pushSpilled(const Volunteer& v) {
+    spill->push(v);
+}
+
+/**
+ * Closes the lanes relinked by removeIf and refills the resident window
+ */
+void LinkedVolunteerQueue::finishRemoval(Node* const* laneLast, int removed) {
+    laneMask = 0;
+    for (int lane = 0; lane < PRIORITY_LEVELS; lane++) {
+        laneTail[lane] = laneLast[lane];
+        if (laneLast[lane] != nullptr) {
+            laneLast[lane]->laneNext = nullptr;
+            laneMask |= 1u << lane;
+        }
+    }
+    if (removed > 0) {
+        version++;
+        admitSpilled();
+    }
+}
+
+/**
+ * Node the next dequeue will remove
+ */
+Node* LinkedVolunteerQueue::nextToDispatch() const {
+    if (mode == FIFO_DISPATCH) {
+        return head;
+    }
+    
+    Node* candidate = laneHead[highestLane(laneMask)];
+    if (candidate != head && agingThreshold > 0 && bypassCount >= agingThreshold) {
+        return head;  // Longest-waiting volunteer has been skipped long enough
+    }
+    return candidate;
 }
 
 /**
  * Removes and returns the volunteer at the front of the queue
  */
-Volunteer VolunteerQueue::dequeue() {
+Volunteer LinkedVolunteerQueue::dequeue() {
     if (isEmpty()) {
         throw std::runtime_error("Cannot dequeue from empty queue");
     }
     
+    Node* nodeToDelete = nextToDispatch();
+    bypassCount = (mode == PRIORITY_DISPATCH && nodeToDelete != head) ? bypassCount + 1 : 0;
+    
     // Store the data to return
-    Volunteer volunteer = head->data;
+    Volunteer volunteer = nodeToDelete->data;
     
-    // Update head pointer
-    Node* nodeToDelete = head;
-    head = head->next;
+    // Unlink from arrival order
+    if (nodeToDelete->prev != nullptr) {
+        nodeToDelete->prev->next = nodeToDelete->next;
+    } else {
+        head = nodeToDelete->next;
+    }
+    if (nodeToDelete->next != nullptr) {
+        nodeToDelete->next->prev = nodeToDelete->prev;
+    } else {
+        tail = nodeToDelete->prev;
+    }
     
-    // If queue becomes empty, update tail as well
-    if (head == nullptr) {
-        tail = nullptr;
+    // The dispatched volunteer is always the oldest in its lane
+    int lane = nodeToDelete->lane;
+    laneHead[lane] = nodeToDelete->laneNext;
+    if (laneHead[lane] == nullptr) {
+        laneTail[lane] = nullptr;
+        laneMask &= ~(1u << lane);
     }
+    count--;
+    version++;
+    residentBytes -= nodeFootprint(nodeToDelete->data);
+    forgetQueued(volunteer);
     
     // Free memory
     delete nodeToDelete;
     
+    // The freed room goes to the oldest spilled volunteer
+    admitSpilled();
+    
     return volunteer;
 }
 
 /**
  * Checks if the queue is empty
  */
-bool VolunteerQueue::isEmpty() const {
+bool LinkedVolunteerQueue::isEmpty() const {
     return head == nullptr;
 }
 
 /**
  * Displays all volunteers in the queue from front to rear
  */
-void VolunteerQueue::displayAll() const {
+void LinkedVolunteerQueue::displayAll() const {
     if (isEmpty()) {
         std::cout << "No volunteers currently registered.\n";
         return;
     }
     
-    std::cout << "\n=== REGISTERED VOLUNTEERS (FIFO Order) ===\n";
-    std::cout << std::left << std::setw(5) << "Pos" 
-              << std::setw(20) << "Name" 
-              << std::setw(25) << "Contact" 
-              << std::setw(20) << "Skill" << "\n";
-    std::cout << std::string(70, '-') << "\n";
-    
-    Node* current = head;
-    int position = 1;
-    
-    while (current != nullptr) {
-        std::string posStr = std::to_string(position);
-        
-        std::cout << std::left << std::setw(5) << posStr
-                  << std::setw(20) << current->data.name
-                  << std::setw(25) << current->data.contact
-                  << std::setw(20) << current->data.skill << "\n";
-        current = current->next;
-        position++;
-    }
-    
-    std::cout << std::string(70, '-') << "\n";
-    std::cout << "Total volunteers in queue: " << size() << "\n";
+    QueueView view;
+    view.capture(*this);
+    view.display();
 }
 
 /**
  * Returns the number of volunteers in the queue
  */
-int VolunteerQueue::size() const {
-    int count = 0;
-    Node* current = head;
-    
-    while (current != nullptr) {
-        count++;
-        current = current->next;
+int LinkedVolunteerQueue::size() const {
+    return count + (int)spilledCount();
+}
+
+/**
+ * Returns the volunteer the next dequeue will remove, without removing it
+ */
+const Volunteer& LinkedVolunteerQueue::front() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Cannot peek into empty queue");
     }
     
-    return count;
+    return nextToDispatch()->data;
+}
+
+/**
+ * Chooses strict FIFO or priority-lane dispatch
+ */
+void LinkedVolunteerQueue::setDispatchMode(DispatchMode newMode) {
+    mode = newMode;
+    bypassCount = 0;
+    version++;
+}
+
+/**
+ * Enables aging after the given number of consecutive bypasses (0 disables)
+ */
+void LinkedVolunteerQueue::setAgingThreshold(int threshold) {
+    agingThreshold = threshold > 0 ? threshold : 0;
+}
+
+/**
+ * Lane rule for a skill, used for volunteers enqueued afterwards
+ */
+void QueueLaneRules::setSkillPriority(const std::string& skill, int level) {
+    if (level < 0 || level >= PRIORITY_LEVELS) {
+        throw std::out_of_range("Priority level out of range");
+    }
+    skillPriority.insert(skill, level);
+}
+
+/**
+ * Lane rule for one contact (e.g. pre-vetted volunteers)
+ */
+void QueueLaneRules::setContactPriority(const std::string& contact, int level) {
+    if (level < 0 || level >= PRIORITY_LEVELS) {
+        throw std::out_of_range("Priority level out of range");
+    }
+    contactPriority.insert(contact, level);
+}
+
+/**
+ * Lane a volunteer would be placed in: the higher of their skill and contact rules
+ */
+int QueueLaneRules::priorityOf(const Volunteer& v) const {
+    int lane = 0;
+    if (!skillPriority.empty()) {
+        const int* level = skillPriority.find(v.skill);
+        if (level != nullptr && *level > lane) lane = *level;
+    }
+    if (!contactPriority.empty()) {
+        const int* level = contactPriority.find(v.contact);
+        if (level != nullptr && *level > lane) lane = *level;
+    }
+    return lane;
+}
+
+/**
+ * Number of volunteers waiting in one lane
+ */
+int LinkedVolunteerQueue::laneSize(int lane) const {
+    int total = 0;
+    for (Node* current = laneHead[lane]; current != nullptr; current = current->laneNext) {
+        total++;
+    }
+    return total;
+}
+
+/**
+ * Number of queued volunteers with a skill
+ */
+int LinkedVolunteerQueue::countWithSkill(const std::string& skill) const {
+    const int* queued = queuedPerSkill.find(skill);
+    return queued != nullptr ? *queued : 0;
 }
@@ -0,0 +1,594 @@
+#include "../include/VolunteerSearch.hpp"
+#include "../include/HistoryArchive.hpp"
+#include "../include/Prototypes.hpp"
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+
+static const int SORT_BATCH_TOKENS = 256;  // New tokens kept unsorted before a merge
+static const int MAX_QUERY_TOKENS = 6;
+static const int MAX_FUZZY_TOKEN = 64;     // Longer tokens only match exactly or by prefix
+static const int MAX_TOKEN_COST = 3;       // Two edits away
+static const int COST_SLACK = 1;           // How much worse than the best match a result may be
+static const int NO_MATCH = 1 << 20;
+static const unsigned char UNMATCHED_TOKEN = 255;
+
+// ASCII letter for each code point U+00C0..U+017F (Latin-1 and Latin Extended-A);
+// ' ' for the multiplication and division signs
+static const char LATIN_FOLD[] =
+    "aaaaaaaceeeeiiiidnooooo ouuuuytsaaaaaaaceeeeiiiidnooooo ouuuuyty"
+    "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiiiiijjkkkllllllllllnnnnnnnnnoooooooorrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+
+/**
+ * Splits a name into normalized tokens
+ */
+void tokenizeName(const std::string& name, CustomArray<std::string>& tokens) {
+    tokens.clear();
+    std::string token;
+    auto finish = [&]() {
+        if (!token.empty()) {
+            tokens.push_back(token);
+            token.clear();
+        }
+    };
+
+    for (size_t i = 0; i < name.size(); i++) {
+        unsigned char c = (unsigned char)name[i];
+        if (c < 0x80) {
+            if (c >= 'A' && c <= 'Z') {
+                token += (char)(c - 'A' + 'a');
+            } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                token += (char)c;
+            } else if (c != '\'' && c != '`') {
+                finish();
+            }
+            continue;
+        }
+
+        // Multi-byte UTF-8: fold Latin letters, skip the right single quote,
+        // keep anything else as it is so other scripts still match exactly
+        size_t length = (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+        if (i + length > name.size()) {
+            break;
+        }
+        if (length == 2) {
+            unsigned codePoint = ((c & 0x1Fu) << 6) | ((unsigned char)name[i + 1] & 0x3Fu);
+            if (codePoint >= 0xC0 && codePoint < 0x180) {
+                char folded = LATIN_FOLD[codePoint - 0xC0];
+                if (folded == ' ') {
+                    finish();
+                } else {
+                    token += folded;
+                }
+                i += 1;
+                continue;
+            }
+        }
+        if (length == 3 && c == 0xE2 && (unsigned char)name[i + 1] == 0x80 && (unsigned char)name[i + 2] == 0x99) {
+            i += 2;
+            continue;
+        }
+        token.append(name, i, length);
+        i += length - 1;
+    }
+    finish();
+}
+
+/**
+ * A token prepared for bit-parallel edit distance (Myers): one bit per
+ * character, which is why fuzzy matching stops at 64-character tokens
+ */
+struct EditPattern {
+    uint64_t positions[256];  // Per byte value, the positions where the token has it
+    int length;
+
+    explicit EditPattern(const std::string& token) : length((int)token.size()) {
+        std::fill(positions, positions + 256, (uint64_t)0);
+        for (int i = 0; i < length && i < MAX_FUZZY_TOKEN; i++) {
+            positions[(unsigned char)token[i]] |= (uint64_t)1 << i;
+        }
+    }
+};
+
+/**
+ * Levenshtein distance from a prepared token of at most MAX_FUZZY_TOKEN
+ * characters; anything above limit is reported as limit + 1
+ */
+static int editDistance(const EditPattern& pattern, const std::string& text, int limit) {
+    int textLength = (int)text.size();
+    if (pattern.length - textLength > limit || textLength - pattern.length > limit) {
+        return limit + 1;
+    }
+    if (pattern.length == 0) {
+        return textLength;
+    }
+
+    // Vertical deltas of the DP column (+1 / -1 bits); the distance is
+    // tracked at the last pattern row
+    uint64_t plus = ~(uint64_t)0, minus = 0;
+    uint64_t last = (uint64_t)1 << (pattern.length - 1);
+    int distance = pattern.length;
+    for (int j = 0; j < textLength; j++) {
+        uint64_t equal = pattern.positions[(unsigned char)text[j]];
+        uint64_t vertical = equal | minus;
+        uint64_t horizontal = (((equal & plus) + plus) ^ plus) | equal;
+        uint64_t horizontalPlus = minus | ~(horizontal | plus);
+        uint64_t horizontalMinus = plus & horizontal;
+        if (horizontalPlus & last) {
+            distance++;
+        } else if (horizontalMinus & last) {
+            distance--;
+        }
+        horizontalPlus = (horizontalPlus << 1) | 1;
+        horizontalMinus <<= 1;
+        plus = horizontalMinus | ~(vertical | horizontalPlus);
+        minus = horizontalPlus & vertical;
+    }
+    return distance > limit ? limit + 1 : distance;
+}
+
+/**
+ * Edits a query token may be away from a name token
+ */
+static int allowedEdits(const std::string& token) {
+    if (token.size() >= 7) return 2;
+    if (token.size() >= 4) return 1;
+    return 0;
+}
+
+/**
+ * Constructor - empty, unbuilt index
+ */
+VolunteerSearchIndex::VolunteerSearchIndex() : built(false) {
+    tokenStart.push_back(0);
+}
+
+/**
+ * Id of a token, adding it to the vocabulary, the BK-tree and the unsorted
+ * batch when new
+ */
+int VolunteerSearchIndex::tokenIdFor(const std::string& token) {
+    const int* known = tokenIds.find(token);
+    if (known != nullptr) {
+        return *known;
+    }
+
+    int id = tokens.size();
+    tokens.push_back(token);
+    tokenIds.insert(token, id);
+    postings.push_back(CustomArray<int>());
+
+    BkNode node;
+    node.firstChild = node.nextSibling = -1;
+    node.distance = 0;
+    node.farthestChild = -1;
+    bkTree.push_back(node);
+    if (id > 0 && token.size() <= (size_t)MAX_FUZZY_TOKEN) {
+        // Walk down to the node with no child at this token's distance
+        EditPattern pattern(token);
+        int parent = 0;
+        while (true) {
+            int distance = editDistance(pattern, tokens[parent], MAX_FUZZY_TOKEN);
+            int child = bkTree[parent].firstChild;
+            while (child != -1 && bkTree[child].distance != distance) {
+                child = bkTree[child].nextSibling;
+            }
+            if (child == -1) {
+                bkTree[id].distance = distance;
+                bkTree[id].nextSibling = bkTree[parent].firstChild;
+                bkTree[parent].firstChild = id;
+                if (distance > bkTree[parent].farthestChild) {
+                    bkTree[parent].farthestChild = distance;
+                }
+                break;
+            }
+            parent = child;
+        }
+    }
+
+    unsortedTokens.push_back(id);
+    if (unsortedTokens.size() >= SORT_BATCH_TOKENS) {
+        mergeUnsortedTokens();
+    }
+    return id;
+}
+
+/**
+ * Sorts the batch of new tokens into sortedTokens
+ */
+void VolunteerSearchIndex::mergeUnsortedTokens() {
+    if (unsortedTokens.empty()) {
+        return;
+    }
+    const CustomArray<std::string>& words = tokens;
+    auto byText = [&words](int a, int b) {
+        return words[a] < words[b];
+    };
+    std::sort(unsortedTokens.begin(), unsortedTokens.end(), byText);
+
+    CustomArray<int> merged;
+    merged.reserve(sortedTokens.size() + unsortedTokens.size());
+    int i = 0, j = 0;
+    while (i < sortedTokens.size() || j < unsortedTokens.size()) {
+        if (j == unsortedTokens.size() || (i < sortedTokens.size() && byText(sortedTokens[i], unsortedTokens[j]))) {
+            merged.push_back(sortedTokens[i++]);
+        } else {
+            merged.push_back(unsortedTokens[j++]);
+        }
+    }
+    sortedTokens.swap(merged);
+    unsortedTokens.clear();
+}
+
+/**
+ * Record of a volunteer, indexing their name when first seen
+ */
+int VolunteerSearchIndex::recordFor(const Volunteer& volunteer) {
+    std::string key = volunteerKey(volunteer);
+    const int* known = recordByKey.find(key);
+    if (known != nullptr) {
+        return *known;
+    }
+
+    int id = records.size();
+    Record record;
+    record.name = volunteer.name;
+    record.contact = volunteer.contact;
+    record.skill = volunteer.skill;
+    record.status = REGISTERED;
+
+    CustomArray<std::string> nameTokens;
+    tokenizeName(volunteer.name, nameTokens);
+    for (int i = 0; i < nameTokens.size(); i++) {
+        int token = tokenIdFor(nameTokens[i]);
+        CustomArray<int>& list = postings[token];
+        if (!list.empty() && list[list.size() - 1] == id) {
+            continue;  // Same token twice in one name
+        }
+        list.push_back(id);
+        recordTokens.push_back(token);
+    }
+    tokenStart.push_back(recordTokens.size());
+
+    records.push_back(std::move(record));
+    recordByKey.insert(key, id);
+    return id;
+}
+
+void VolunteerSearchIndex::setStatus(const Volunteer& volunteer, Status status) {
+    if (built) {
+        records[recordFor(volunteer)].status = status;
+    }
+}
+
+void VolunteerSearchIndex::addRegistration(const Volunteer& volunteer) {
+    recordFor(volunteer);
+}
+
+/**
+ * Indexes the registration history and takes statuses from the queue and
+ * the active deployment counts
+ */
+void VolunteerSearchIndex::build(const std::string& registrationLog, const std::string& deployedLog,
+                                 const std::string& releasedLog, const VolunteerQueue& queue) {
+    Volunteer volunteer;
+    auto index = [&](const std::string& line) {
+        std::string record = trim(line);
+        if (!record.empty() && parseVolunteerRecord(record, volunteer)) {
+            addRegistration(volunteer);
+        }
+    };
+
+    HistoryArchive archive;
+    if (archive.open(archiveFileFor(registrationLog))) {
+        archive.forEachLine(index);
+    }
+    std::ifstream file(registrationLog);
+    std::string line;
+    while (file.is_open() && std::getline(file, line)) {
+        index(line);
+    }
+    mergeUnsortedTokens();
+
+    // Deployed as the startup loader sees it: deployments not released back to the queue
+    CustomHashMap<std::string, int> activeCounts;
+    loadActiveDeploymentCounts(activeCounts, deployedLog, releasedLog);
+    activeCounts.forEach([this](const std::string& key, const int& active) {
+        const int* id = recordByKey.find(key);
+        if (id != nullptr && active > 0) {
+            records[*id].status = DEPLOYED;
+        }
+    });
+    queue.forEach([this](const Volunteer& queued) {
+        records[recordFor(queued)].status = QUEUED;
+    });
+    built = true;
+}
+
+void VolunteerSearchIndex::noteQueued(const Volunteer& volunteer) {
+    setStatus(volunteer, QUEUED);
+}
+
+void VolunteerSearchIndex::noteDeployed(const Volunteer& volunteer) {
+    setStatus(volunteer, DEPLOYED);
+}
+
+void VolunteerSearchIndex::noteReleased(const Volunteer& volunteer, bool requeued) {
+    setStatus(volunteer, requeued ? QUEUED : REGISTERED);
+}
+
+/**
+ * Records a vocabulary token's cost for a query token, keeping the lowest
+ */
+static void offerToken(unsigned char* costs, CustomArray<int>& matched, int token, int cost) {
+    if (costs[token] == UNMATCHED_TOKEN) {
+        matched.push_back(token);
+    }
+    if (cost < costs[token]) {
+        costs[token] = (unsigned char)cost;
+    }
+}
+
+/**
+ * Offers every token within radius edits of a query token, at 1 + edits;
+ * children are only visited when their distance to their parent is within
+ * radius of the query's
+ */
+void VolunteerSearchIndex::searchBkTree(const std::string& queryToken, int radius, unsigned char* costs,
+                                        CustomArray<int>& matched) const {
+    EditPattern pattern(queryToken);
+    CustomArray<int> pending;
+    pending.push_back(0);
+    while (!pending.empty()) {
+        int node = pending[pending.size() - 1];
+        pending.pop_back();
+        // Beyond radius + farthestChild no child can be within reach either,
+        // so the distance need not be exact past that
+        int farthest = bkTree[node].farthestChild > 0 ? bkTree[node].farthestChild : 0;
+        int distance = editDistance(pattern, tokens[node], radius + farthest);
+        if (distance > 0 && distance <= radius) {
+            offerToken(costs, matched, node, 1 + distance);
+        }
+        for (int child = bkTree[node].firstChild; child != -1; child = bkTree[child].nextSibling) {
+            int gap = bkTree[child].distance - distance;
+            if (gap >= -radius && gap <= radius) {
+                pending.push_back(child);
+            }
+        }
+    }
+}
+
+/**
+ * Adds every vocabulary token a query token matches, with its cost
+ */
+void VolunteerSearchIndex::matchToken(const std::string& queryToken, unsigned char* costs,
+                                      CustomArray<int>& matched) const {
+    const int* exact = tokenIds.find(queryToken);
+    if (exact != nullptr) {
+        offerToken(costs, matched, *exact, 0);
+    }
+
+    // Prefix: a range of the sorted vocabulary, plus the unsorted batch
+    int low = 0, high = sortedTokens.size();
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (tokens[sortedTokens[middle]] < queryToken) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (int i = low; i < sortedTokens.size() && tokens[sortedTokens[i]].compare(0, queryToken.size(), queryToken) == 0; i++) {
+        offerToken(costs, matched, sortedTokens[i], 1);
+    }
+    for (int i = 0; i < unsortedTokens.size(); i++) {
+        if (tokens[unsortedTokens[i]].compare(0, queryToken.size(), queryToken) == 0) {
+            offerToken(costs, matched, unsortedTokens[i], 1);
+        }
+    }
+
+    int edits = allowedEdits(queryToken);
+    if (edits == 0 || bkTree.empty() || queryToken.size() > (size_t)MAX_FUZZY_TOKEN) {
+        return;
+    }
+    searchBkTree(queryToken, edits, costs, matched);
+
+    // Two adjacent letters swapped: one edit here, though two by edit
+    // distance, so each swapped spelling is looked up itself
+    std::string swapped = queryToken;
+    for (size_t i = 0; i + 1 < swapped.size(); i++) {
+        if (swapped[i] == swapped[i + 1]) {
+            continue;
+        }
+        std::swap(swapped[i], swapped[i + 1]);
+        const int* token = tokenIds.find(swapped);
+        if (token != nullptr) {
+            offerToken(costs, matched, *token, 2);
+        }
+        std::swap(swapped[i], swapped[i + 1]);
+    }
+}
+
+namespace {
+/**
+ * Position in one posting list of the driving query token, newest first
+ */
+struct PostingCursor {
+    const CustomArray<int>* list;
+    int position;
+
+    int record() const {
+        return (*list)[position];
+    }
+};
+
+bool olderCursor(const PostingCursor& a, const PostingCursor& b) {
+    return a.record() < b.record();
+}
+}
+
+/**
+ * Best matches for a name, prefix or misspelling
+ */
+void VolunteerSearchIndex::search(const std::string& query, int limit, CustomArray<Match>& matches,
+                                  bool& truncated) const {
+    matches.clear();
+    truncated = false;
+    CustomArray<std::string> queryTokens;
+    tokenizeName(query, queryTokens);
+    if (queryTokens.empty() || limit <= 0) {
+        return;
+    }
+    int terms = queryTokens.size() < MAX_QUERY_TOKENS ? queryTokens.size() : MAX_QUERY_TOKENS;
+
+    // Matching vocabulary per query token, as a flat table of costs
+    // (term * tokens + token) and a list of the tokens matched; the token
+    // with the fewest postings drives the walk
+    const int vocabulary = tokens.size();
+    CustomArray<unsigned char> tokenCosts;
+    tokenCosts.assign(terms * vocabulary, UNMATCHED_TOKEN);
+    CustomArray<CustomArray<int> > matched;
+    CustomArray<int> cheapest;
+    int driver = 0;
+    long long driverPostings = -1;
+    for (int t = 0; t < terms; t++) {
+        unsigned char* termCosts = tokenCosts.begin() + t * vocabulary;
+        matched.push_back(CustomArray<int>());
+        matchToken(queryTokens[t], termCosts, matched[t]);
+        if (matched[t].empty()) {
+            return;  // Every query token has to match
+        }
+        long long total = 0;
+        int lowest = NO_MATCH;
+        for (int i = 0; i < matched[t].size(); i++) {
+            int token = matched[t][i];
+            total += postings[token].size();
+            lowest = termCosts[token] < lowest ? termCosts[token] : lowest;
+        }
+        cheapest.push_back(lowest);
+        if (driverPostings < 0 || total < driverPostings) {
+            driver = t;
+            driverPostings = total;
+        }
+    }
+
+    int othersCheapest = 0;
+    for (int t = 0; t < terms; t++) {
+        othersCheapest += t == driver ? 0 : cheapest[t];
+    }
+
+    // Cost of a record's best match to each query token (NO_MATCH if one has none)
+    auto bestCost = [&](int id, int term) {
+        const unsigned char* termCosts = tokenCosts.begin() + term * vocabulary;
+        int best = UNMATCHED_TOKEN;
+        for (int i = tokenStart[id]; i < tokenStart[id + 1]; i++) {
+            int cost = termCosts[recordTokens[i]];
+            best = cost < best ? cost : best;
+        }
+        return best == UNMATCHED_TOKEN ? NO_MATCH : best;
+    };
+
+    CustomArray<int> bestRecords;  // Ordered by cost, then newest first
+    CustomArray<int> bestCosts;
+    int examined = 0;
+
+    // Walk the driver's matches tier by tier (exact, prefix, one edit, two),
+    // each tier's posting lists merged newest first. A record reached in
+    // tier c costs at least c + othersCheapest, so the walk ends once the
+    // list is full of matches no worse than that, or once that is more than
+    // COST_SLACK worse than the best match (typos are not worth listing
+    // under an exact hit).
+    for (int tier = 0; tier <= MAX_TOKEN_COST && !truncated; tier++) {
+        int tierCheapest = tier + othersCheapest;
+        if ((bestRecords.size() == limit && bestCosts[limit - 1] <= tierCheapest) ||
+            (!bestRecords.empty() && tierCheapest > bestCosts[0] + COST_SLACK)) {
+            break;
+        }
+        CustomArray<PostingCursor> heap;
+        const unsigned char* driverCosts = tokenCosts.begin() + driver * vocabulary;
+        for (int i = 0; i < matched[driver].size(); i++) {
+            int token = matched[driver][i];
+            if (driverCosts[token] == tier && !postings[token].empty()) {
+                PostingCursor cursor;
+                cursor.list = &postings[token];
+                cursor.position = postings[token].size() - 1;
+                heap.push_back(cursor);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), olderCursor);
+
+        int lastRecord = -1;
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), olderCursor);
+            PostingCursor& cursor = heap[heap.size() - 1];
+            int id = cursor.record();
+            if (--cursor.position < 0) {
+                heap.pop_back();
+            } else {
+                std::push_heap(heap.begin(), heap.end(), olderCursor);
+            }
+            if (id == lastRecord) {
+                continue;  // Several of the driver's tokens are in this name
+            }
+            lastRecord = id;
+
+            if (bestCost(id, driver) < tier) {
+                continue;  // Seen in an earlier tier
+            }
+            if (examined++ == SCAN_LIMIT) {
+                truncated = true;
+                break;
+            }
+
+            int total = tier;
+            for (int t = 0; t < terms && total < NO_MATCH; t++) {
+                total += t == driver ? 0 : bestCost(id, t);
+            }
+            if (total >= NO_MATCH || (bestRecords.size() == limit && total >= bestCosts[limit - 1]) ||
+                (!bestRecords.empty() && total > bestCosts[0] + COST_SLACK)) {
+                continue;
+            }
+
+            // Insert after every better match and every equal newer one
+            int position = bestRecords.size() < limit ? bestRecords.size() : limit - 1;
+            if (bestRecords.size() < limit) {
+                bestRecords.push_back(id);
+                bestCosts.push_back(total);
+            }
+            while (position > 0 && (bestCosts[position - 1] > total ||
+                                    (bestCosts[position - 1] == total && bestRecords[position - 1] < id))) {
+                bestRecords[position] = bestRecords[position - 1];
+                bestCosts[position] = bestCosts[position - 1];
+                position--;
+            }
+            bestRecords[position] = id;
+            bestCosts[position] = total;
+            while (bestCosts[bestRecords.size() - 1] > bestCosts[0] + COST_SLACK) {
+                bestRecords.pop_back();  // A better match than these turned up
+                bestCosts.pop_back();
+            }
+
+            // Nothing older in this tier can beat a full list at the tier's lowest cost
+            if (bestRecords.size() == limit && bestCosts[limit - 1] <= tierCheapest) {
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < bestRecords.size(); i++) {
+        const Record& record = records[bestRecords[i]];
+        Match match;
+        match.volunteer = Volunteer(record.name, record.contact, record.skill);
+        match.status = record.status;
+        match.cost = bestCosts[i];
+        matches.push_back(match);
+    }
+}
+
+const char* VolunteerSearchIndex::statusName(Status status) {
+    switch (status) {
+        case QUEUED: return "queued";
+        case DEPLOYED: return "deployed";
+        default: return "registered";
+    }
+}
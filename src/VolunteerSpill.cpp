@@ -0,0 +1,195 @@
+#include "../include/VolunteerSpill.hpp"
+#include "../include/QueueState.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <utility>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+/**
+ * Reads a whole segment file
+ */
+static bool readSegment(const std::string& filename, CustomArray<Volunteer>& out) {
+    out.clear();
+    std::ifstream in(filename, std::ios::binary);
+    uint32_t records = 0;
+    if (!in.read((char*)&records, sizeof(records))) {
+        return false;
+    }
+    out.reserve((int)records);
+    for (uint32_t i = 0; i < records; i++) {
+        Volunteer v;
+        if (!readVolunteerRecord(in, v)) {
+            return false;
+        }
+        out.push_back(v);
+    }
+    return true;
+}
+
+/**
+ * Constructor
+ */
+VolunteerSpill::VolunteerSpill(const std::string& directory, int recordsPerSegment)
+    : segmentRecords(recordsPerSegment > 0 ? recordsPerSegment : 1), headPos(0),
+      firstSegment(0), nextSegment(0), total(0), prefetcher(nullptr), prefetchOk(false), writeFailed(false) {
+    // Unique per process and per spill, so staging queues never share files
+    static std::atomic<int> instances(0);
+    long long pid = 0;
+#ifdef __unix__
+    pid = (long long)getpid();
+#endif
+    prefix = directory + "/queue-spill-" + std::to_string(pid) + "-" + std::to_string(instances++) + "-";
+}
+
+/**
+ * Destructor - waits for any prefetch and deletes the segment files
+ */
+VolunteerSpill::~VolunteerSpill() {
+    if (prefetcher != nullptr) {
+        prefetcher->join();
+        delete prefetcher;
+    }
+    for (long long segment = firstSegment; segment < nextSegment; segment++) {
+        std::remove(segmentFile(segment).c_str());
+    }
+}
+
+std::string VolunteerSpill::segmentFile(long long segment) const {
+    return prefix + std::to_string(segment) + ".seg";
+}
+
+/**
+ * Starts reading the oldest segment on disk in the background
+ */
+void VolunteerSpill::startPrefetch(const std::string& consumed) {
+    if (prefetcher != nullptr || firstSegment == nextSegment) {
+        if (!consumed.empty()) std::remove(consumed.c_str());
+        return;
+    }
+    std::string filename = segmentFile(firstSegment);
+    prefetcher = new std::thread([this, filename, consumed]() {
+        if (!consumed.empty()) std::remove(consumed.c_str());
+        prefetchOk = readSegment(filename, prefetched);
+    });
+}
+
+/**
+ * Replaces the consumed head with the next part of the FIFO
+ */
+void VolunteerSpill::refillHead() {
+    headPos = 0;
+    std::string consumed;
+
+    if (firstSegment < nextSegment) {
+        // Normally finished long ago; otherwise this is the only wait on the disk
+        startPrefetch();
+        prefetcher->join();
+        delete prefetcher;
+        prefetcher = nullptr;
+
+        std::string filename = segmentFile(firstSegment);
+        if (!prefetchOk) {
+            std::cout << "Error: Queue spill segment '" << filename << "' could not be read; "
+                      << "its volunteers are lost from the queue.\n";
+        }
+        // Counted volunteers that could not be read are dropped from the total
+        if (prefetched.size() < segmentRecords) {
+            total -= segmentRecords - prefetched.size();
+        }
+
+        // The consumed buffer goes to the prefetcher, which clears it off this thread
+        // and deletes the consumed file
+        headBuffer.swap(prefetched);
+        consumed = filename;
+        firstSegment++;
+    } else {
+        headBuffer.swap(tailBuffer);
+        tailBuffer.clear();
+    }
+
+    // Give the disk the whole head buffer's worth of time to fetch the next segment
+    startPrefetch(consumed);
+}
+
+/**
+ * Adds a volunteer at the back
+ */
+void VolunteerSpill::push(const Volunteer& v) {
+    tailBuffer.push_back(v);
+    total++;
+    if (tailBuffer.size() < segmentRecords || writeFailed) {
+        return;
+    }
+
+    // Tail is a full segment: write it out sequentially
+    std::string filename = segmentFile(nextSegment);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    uint32_t records = (uint32_t)tailBuffer.size();
+    out.write((const char*)&records, sizeof(records));
+    for (int i = 0; i < tailBuffer.size(); i++) {
+        writeVolunteerRecord(out, tailBuffer[i]);
+    }
+    out.close();
+    if (out.fail()) {
+        std::remove(filename.c_str());
+        writeFailed = true;
+        std::cout << "Warning: Could not write queue spill segment '" << filename
+                  << "'; keeping queued volunteers in memory.\n";
+        return;
+    }
+
+    tailBuffer.clear();
+    nextSegment++;
+    startPrefetch();
+}
+
+/**
+ * Removes the volunteer at the front
+ */
+bool VolunteerSpill::pop(Volunteer& v) {
+    if (headPos == headBuffer.size()) {
+        if (firstSegment == nextSegment && tailBuffer.empty()) {
+            return false;
+        }
+        refillHead();
+        if (headBuffer.empty()) {
+            return pop(v);  // Unreadable segment; move on to the next part
+        }
+    }
+    v = std::move(headBuffer[headPos++]);
+    total--;
+    return true;
+}
+
+/**
+ * Copies one part of the FIFO, front part first
+ */
+bool VolunteerSpill::readPart(int part, CustomArray<Volunteer>& out) const {
+    out.clear();
+    if (part == 0) {
+        for (int i = headPos; i < headBuffer.size(); i++) {
+            out.push_back(headBuffer[i]);
+        }
+        return true;
+    }
+
+    long long segment = firstSegment + part - 1;
+    if (segment < nextSegment) {
+        // The file stays on disk until the head has taken it over
+        if (!readSegment(segmentFile(segment), out)) {
+            std::cout << "Warning: Queue spill segment '" << segmentFile(segment) << "' could not be read.\n";
+        }
+        return true;
+    }
+    if (segment == nextSegment) {
+        out = tailBuffer;
+        return true;
+    }
+    return false;
+}
@@ -2,14 +2,32 @@
 #include "../include/CustomLists.hpp"
 #include "../include/Prototypes.hpp"
 #include "../include/SiteAlgorithm.hpp"
+#include "../include/QueueState.hpp"
+#include "../include/AsyncLogWriter.hpp"
+#include "../include/Simulator.hpp"
+#include "../include/Benchmarks.hpp"
+#include "../include/DeploymentIndex.hpp"
+#include "../include/RegionRegistry.hpp"
+#include "../include/ShiftScheduler.hpp"
+#include "../include/Snapshot.hpp"
+#include "../include/Daemon.hpp"
+#include "../include/SessionLog.hpp"
+#include "../include/HistoryArchive.hpp"
+#include "../include/StartupLoader.hpp"
+#include "../include/AllocationProfiler.hpp"
+#include "../include/BatchPlanner.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
 #include <algorithm>
+#include <cctype>
 #include <limits>
 #include <climits>
+#include <cstdio>
+#include <ctime>
+#include <thread>
 
 /**
  * Disaster Relief Logistics Management System
@@ -20,7 +38,55 @@
  */
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    AllocationProfiler::enableIfRequested();
+
+    // An archive run that stopped half way is completed before anything reads the logs
+    finishArchiveRun(ARCHIVE_JOURNAL_FILE);
+    
+    // Non-interactive modes
+    if (argc > 1 && std::string(argv[1]) == "--simulate") {
+        return runSimulationMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench-policies") {
+        return runPolicyBenchmarkMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench-queues") {
+        return runQueueBenchmarkMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench-search") {
+        return runSearchBenchmarkMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench-planner") {
+        return runPlannerBenchmarkMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--daemon") {
+        return runDaemonMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--replay-session") {
+        return runSessionReplayMode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--archive-history") {
+        return runArchiveMode(argc, argv);
+    }
+
+    bool follow = false;
+    std::string recordFile;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--follow") {
+            follow = true;
+        } else if (option == "--record" && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (option == "--profile-allocations") {
+            AllocationProfiler::enable();
+        } else {
+            std::cout << "Usage: volunteer_system [--follow] [--record FILE] [--profile-allocations] | --simulate ... | "
+                      << "--bench-policies ... | --bench-queues ... | --bench-search ... | --bench-planner ... | --daemon ... | --replay-session FILE ... | --archive-history ...\n";
+            return option == "--help" ? 0 : 1;
+        }
+    }
+    
     VolunteerQueue volunteerQueue;
     
     std::cout << "=================================================================\n";
@@ -28,52 +94,110 @@ int main() {
     std::cout << "    Role 2: Volunteer Operations Officer\n";
     std::cout << "=================================================================\n\n";
     
-    // Load existing volunteers from file at startup
+    // Restore the saved queue, or rebuild it from the registration history
     std::cout << "=== SYSTEM INITIALIZATION ===\n";
-    loadVolunteersFromFile(volunteerQueue, "../data/volunteers.txt");
+    loadDispatchSettings(volunteerQueue, "../data/dispatch.txt");
+    long long ingestedOffset = initializeQueue(volunteerQueue);
+    trackRegistrations(ingestedOffset);
+    if (follow) {
+        startFollowing(ingestedOffset);
+    }
     
-    int choice;
-    bool running = true;
+    SessionRecorder recorder;
+    if (!recordFile.empty()) {
+        if (recorder.start(recordFile)) {
+            std::cout << "Recording this session to '" << recordFile << "'.\n";
+        } else {
+            std::cout << "Warning: Could not open session log '" << recordFile << "'; not recording.\n";
+        }
+    }
     
+    bool running = true;
     while (running) {
-        displayMenu();
-        
-        std::cout << "Enter your choice (1-4): ";
-        std::cin >> choice;
-        
-        // Clear input buffer
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        
-        std::cout << "\n";
-        
-        switch (choice) {
-            case 1:
-                registerVolunteer(volunteerQueue);
-                break;
-            case 2:
-                deployVolunteer(volunteerQueue);
-                break;
-            case 3:
-                viewRegisteredVolunteers(volunteerQueue);
-                break;
-            case 4:
-                std::cout << "Thank you for using the Volunteer Operations System!\n";
-                std::cout << "Exiting program...\n";
-                running = false;
-                break;
-            default:
-                std::cout << "Invalid choice. Please enter a number between 1 and 4.\n";
-                break;
-        }
-        
-        if (running) {
-            pauseForUser();
-        }
+        running = runMenuIteration(volunteerQueue);
+        recorder.finishAction();
     }
     
     return 0;
 }
 
+/**
+ * Scope a menu action's allocations are charged to
+ */
+static AllocationProfiler::Scope menuAllocationScope(int choice) {
+    switch (choice) {
+        case 1: return AllocationProfiler::REGISTER;
+        case 2: return AllocationProfiler::DEPLOY;
+        case 3: case 5: case 6: return AllocationProfiler::REPORT;
+        case 4: return AllocationProfiler::RELEASE;
+        case 7: return AllocationProfiler::SAVE;
+        default: return AllocationProfiler::OTHER;
+    }
+}
+
+/**
+ * Shows the menu, reads one choice and carries out that action
+ * (including the pause after it)
+ * @return false once the operator chose Exit
+ */
+bool runMenuIteration(VolunteerQueue& volunteerQueue) {
+    int choice;
+    bool running = true;
+    
+    displayMenu();
+    
+    std::cout << "Enter your choice (1-7): ";
+    std::cin >> choice;
+    
+    // Clear input buffer
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    
+    std::cout << "\n";
+    
+    // Pick up registrations partner systems appended while waiting for input,
+    // and what other instances deployed and released meanwhile
+    registrationFollower().poll(volunteerQueue);
+    catchUpDeployments(volunteerQueue);
+    
+    AllocationScope scope(menuAllocationScope(choice));
+    switch (choice) {
+        case 1:
+            registerVolunteer(volunteerQueue);
+            break;
+        case 2:
+            deployVolunteer(volunteerQueue);
+            break;
+        case 3:
+            viewRegisteredVolunteers(volunteerQueue);
+            break;
+        case 4:
+            releaseVolunteer(volunteerQueue);
+            break;
+        case 5:
+            planShiftRoster(volunteerQueue);
+            break;
+        case 6:
+            locateDeployment(volunteerQueue);
+            break;
+        case 7:
+            // Registrations others appended are queued before the cursor moves past them
+            registrationFollower().ingest(volunteerQueue);
+            saveAllVolunteersToFile(volunteerQueue, "../data/queue_state.dat");
+            std::cout << "Thank you for using the Volunteer Operations System!\n";
+            std::cout << "Exiting program...\n";
+            running = false;
+            break;
+        default:
+            std::cout << "Invalid choice. Please enter a number between 1 and 7.\n";
+            break;
+    }
+    
+    if (running) {
+        pauseForUser();
+    }
+    return running;
+}
+
 /**
  * Display the main menu options
  */
@@ -82,7 +206,10 @@ void displayMenu() {
     std::cout << "1. Register Volunteer\n";
     std::cout << "2. Deploy Volunteer to Field\n";
     std::cout << "3. View Available Volunteers\n";
-    std::cout << "4. Exit\n";
+    std::cout << "4. Release Volunteer from Site\n";
+    std::cout << "5. Plan Weekly Shift Roster\n";
+    std::cout << "6. Locate Volunteer or Site Roster\n";
+    std::cout << "7. Exit\n";
     std::cout << "================================\n";
 }
 
@@ -149,20 +276,19 @@ void registerSingleVolunteer(VolunteerQueue& queue) {
         return;
     }
     
-    // Create and enqueue the volunteer
+    // Create the volunteer, with an optional location for nearest-site deployment
     Volunteer newVolunteer(name, contact, skill);
+    readOptionalLocation(newVolunteer);
     queue.enqueue(newVolunteer);
     
     // Save volunteer to file
     saveVolunteerToFile(newVolunteer, "../data/volunteers.txt");
+    readOptionalAvailability(newVolunteer);
     
     std::cout << "\nSuccessfully registered volunteer: " << "\n";
     std::cout << "Name: " << name << "\n";
     std::cout << "Contact: " << contact << "\n";
     std::cout << "Skill: " << skill << "\n";
-    
-    // Validate file format
-    validateVolunteerFile("../data/volunteers.txt");
 }
 
 /**
@@ -195,6 +321,10 @@ void registerMultipleVolunteers(VolunteerQueue& queue) {
     int successCount = 0;
     int failedCount = 0;
     
+    // The batch joins the queue in one splice once every entry is collected
+    VolunteerQueue batch;
+    batch.copyLaneRulesFrom(queue);
+    
     std::cout << "\nStarting registration process for " << numVolunteers << " volunteers...\n";
     std::cout << "Press Enter after each field. Type 'skip' to skip a volunteer.\n";
     std::cout << std::string(60, '=') << "\n";
@@ -255,12 +385,14 @@ void registerMultipleVolunteers(VolunteerQueue& queue) {
             continue;
         }
         
-        // Create and enqueue the volunteer
+        // Create the volunteer, with an optional location for nearest-site deployment
         Volunteer newVolunteer(name, contact, skill);
-        queue.enqueue(newVolunteer);
+        readOptionalLocation(newVolunteer);
+        batch.enqueue(newVolunteer);
         
         // Save volunteer to file (each on separate line)
         saveVolunteerToFile(newVolunteer, "../data/volunteers.txt");
+        readOptionalAvailability(newVolunteer);
         
         successCount++;
         std::cout << "[SUCCESS] Successfully registered: " << name << " (" << skill << ")\n";
@@ -273,6 +405,8 @@ void registerMultipleVolunteers(VolunteerQueue& queue) {
         }
     }
     
+    queue.enqueueBulk(batch);
+    
     std::cout << std::string(60, '=') << "\n";
     std::cout << "\nMultiple volunteer registration complete!\n";
     std::cout << "Successfully registered: " << successCount << " volunteers\n";
@@ -283,9 +417,6 @@ void registerMultipleVolunteers(VolunteerQueue& queue) {
     
     if (successCount > 0) {
         std::cout << "Total volunteers in queue: " << queue.size() << "\n";
-        
-        // Validate file format after multiple registrations
-        validateVolunteerFile("../data/volunteers.txt");
     }
 }
 
@@ -315,51 +446,109 @@ void deployVolunteer(VolunteerQueue& queue) {
     // Show current queue status before deployment
     std::cout << "Current volunteers in queue: " << queue.size() << "\n";
     
-    // Load relief sites using custom linked list
-    CustomLinkedList<ReliefSite> sites = loadReliefSites("../data/relief_sites.txt");
+    // Resident site registry (one shard per region, loaded on first use)
+    RegionRegistry& registry = siteRegistry();
     
-    if (sites.empty()) {
+    if (registry.empty()) {
         std::cout << "Error: Could not load relief sites data.\n";
         return;
     }
     
-    // Display current site capacities
-    std::cout << "\n=== CURRENT RELIEF SITE STATUS ===\n";
-    std::cout << std::left << std::setw(20) << "Site Name" 
-              << std::setw(15) << "Current/Max" 
-              << std::setw(15) << "Available" 
-              << std::setw(10) << "Status" << "\n";
-    std::cout << std::string(60, '-') << "\n";
+    // With several regions the operator may restrict the deployment to one
+    std::string regionFilter;
+    if (registry.shardCount() > 1) {
+        std::cout << "Enter region to deploy to (blank for any region): ";
+        std::getline(std::cin, regionFilter);
+        regionFilter = trim(regionFilter);
+        
+        if (!regionFilter.empty() && registry.shardIndex(regionFilter) == -1) {
+            std::cout << "Error: Unknown region '" << regionFilter << "'.\n";
+            return;
+        }
+    }
     
-    bool hasAvailableCapacity = false;
-    for (auto it = sites.begin(); it != sites.end(); ++it) {
-        int available = it->maxCapacity - it->currentCount;
-        std::string status = (available > 0) ? "AVAILABLE" : "FULL";
-        if (available > 0) hasAvailableCapacity = true;
+    // Sites are listed individually for a single region, otherwise summarized per region
+    int shownShard = !regionFilter.empty() ? registry.shardIndex(regionFilter)
+                                           : (registry.shardCount() == 1 ? 0 : -1);
+    SiteLocation best = registry.bestSite(regionFilter);
+    bool hasAvailableCapacity = best.valid();
+    
+    // Volunteers with a location go to the nearest open site within their travel radius
+    Volunteer next = queue.front();  // A copy: committing may drop it from the queue
+    bool nearestChosen = false;
+    double travelRadius = DEFAULT_TRAVEL_RADIUS_KM;
+    if (hasAvailableCapacity && regionFilter.empty() && next.hasLocation && registry.hasSpatialSites()) {
+        std::cout << "Maximum travel radius for " << next.name << " in km (press Enter for "
+                  << DEFAULT_TRAVEL_RADIUS_KM << "): ";
+        std::string radiusInput;
+        std::getline(std::cin, radiusInput);
+        radiusInput = trim(radiusInput);
+        if (!radiusInput.empty()) {
+            char* end = nullptr;
+            double parsed = std::strtod(radiusInput.c_str(), &end);
+            if (end != radiusInput.c_str() && parsed > 0) {
+                travelRadius = parsed;
+            } else {
+                std::cout << "Invalid radius; using " << DEFAULT_TRAVEL_RADIUS_KM << " km.\n";
+            }
+        }
+        
+        SiteLocation nearest = registry.nearestSite(next.latitude, next.longitude, travelRadius);
+        if (nearest.valid()) {
+            best = nearest;
+            nearestChosen = true;
+        } else {
+            std::cout << "No open site with coordinates within " << travelRadius
+                      << " km; using the most needed site instead.\n";
+        }
+    }
+    
+    if (shownShard >= 0) {
+        const CustomArray<ReliefSite>& sites = registry.shard(shownShard).sites.all();
         
-        std::cout << std::left << std::setw(20) << it->name
-                  << std::setw(15) << (std::to_string(it->currentCount) + "/" + std::to_string(it->maxCapacity))
-                  << std::setw(15) << available
-                  << std::setw(10) << status << "\n";
+        // Display current site capacities
+        std::cout << "\n=== CURRENT RELIEF SITE STATUS ===\n";
+        std::cout << std::left << std::setw(20) << "Site Name" 
+                  << std::setw(15) << "Current/Max" 
+                  << std::setw(15) << "Available" 
+                  << std::setw(10) << "Status" << "\n";
+        std::cout << std::string(60, '-') << "\n";
+        
+        for (auto it = sites.begin(); it != sites.end(); ++it) {
+            int available = it->maxCapacity - it->currentCount;
+            std::string status = (available > 0) ? "AVAILABLE" : "FULL";
+            
+            std::cout << std::left << std::setw(20) << it->name
+                      << std::setw(15) << (std::to_string(it->currentCount) + "/" + std::to_string(it->maxCapacity))
+                      << std::setw(15) << available
+                      << std::setw(10) << status << "\n";
+        }
+        std::cout << std::string(60, '-') << "\n";
+    } else {
+        printRegionSummary(registry);
     }
-    std::cout << std::string(60, '-') << "\n";
     
     // Check if any sites have capacity
     if (!hasAvailableCapacity) {
+        int siteTotal = shownShard >= 0 ? registry.shard(shownShard).sites.size() : registry.totalSites();
+        
         std::cout << "\n[ERROR] DEPLOYMENT CANNOT PROCEED [ERROR]\n";
         std::cout << std::string(50, '=') << "\n";
         std::cout << "REASON: All relief sites are at maximum capacity\n\n";
         
         std::cout << "CURRENT SITUATION:\n";
-        std::cout << "- Total relief sites: " << sites.size() << "\n";
-        std::cout << "- Sites at full capacity: " << sites.size() << " (100%)\n";
+        std::cout << "- Total relief sites: " << siteTotal << "\n";
+        std::cout << "- Sites at full capacity: " << siteTotal << " (100%)\n";
         std::cout << "- Available positions: 0\n";
         std::cout << "- Volunteers waiting in queue: " << queue.size() << "\n\n";
         
-        std::cout << "DETAILED SITE STATUS:\n";
-        for (auto it = sites.begin(); it != sites.end(); ++it) {
-            std::cout << "- " << it->name << ": " << it->currentCount 
-                      << "/" << it->maxCapacity << " (FULL)\n";
+        if (shownShard >= 0) {
+            const CustomArray<ReliefSite>& sites = registry.shard(shownShard).sites.all();
+            std::cout << "DETAILED SITE STATUS:\n";
+            for (auto it = sites.begin(); it != sites.end(); ++it) {
+                std::cout << "- " << it->name << ": " << it->currentCount 
+                          << "/" << it->maxCapacity << " (FULL)\n";
+            }
         }
         
         std::cout << "\nACTION REQUIRED:\n";
@@ -373,23 +562,12 @@ void deployVolunteer(VolunteerQueue& queue) {
         return;
     }
     
-    // Find site with lowest current count that isn't at capacity
-    // int bestSiteIndex = -1;
-    // int lowestCount = INT_MAX;
-    
-    // int index = 0;
-    // for (auto it = sites.begin(); it != sites.end(); ++it, ++index) {
-    //     if (it->currentCount < it->maxCapacity) {
-    //         if (it->currentCount < lowestCount) {
-    //             lowestCount = it->currentCount;
-    //             bestSiteIndex = index;
-    //         }
-    //     }
-    // }
-
-    int bestSiteIndex = findMostNeededSite(sites);
+    // Most needed site comes straight from the region priority indexes (same rule as findMostNeededSite)
+    if (shownShard >= 0 && !nearestChosen) {
+        printSitePriorityAnalysis(registry.shard(shownShard).sites.all(), best.index);
+    }
 
-    if (bestSiteIndex == -1) {
+    if (!best.valid()) {
         std::cout << "\n[ERROR] DEPLOYMENT CANNOT PROCEED [ERROR]\n";
         std::cout << "REASON: No sites available for deployment\n";
         return;
@@ -397,13 +575,15 @@ void deployVolunteer(VolunteerQueue& queue) {
     
     // Deploy the volunteer (FIFO - first registered is first deployed)
     try {
-        Volunteer volunteer = queue.dequeue();  // This gets the FIRST volunteer in queue
-        
-        // Update the site capacity using array-like access
-        sites[bestSiteIndex].currentCount++;
-        
-        // Save the deployed volunteer to deployed file
-        saveDeployedVolunteer(volunteer, "../data/deployed_volunteers.txt");
+        Volunteer volunteer;
+        if (!commitDeployment(queue, best, volunteer)) {
+            std::cout << "\n[ERROR] DEPLOYMENT CONFLICT [ERROR]\n";
+            std::cout << "REASON: Another operator filled " << registry.site(best).name
+                      << " or deployed " << next.name << " first\n";
+            std::cout << "NOTE: No volunteer was deployed. Site counts have been refreshed; please deploy again.\n";
+            return;
+        }
+        const ReliefSite& site = registry.site(best);
         
         std::cout << "\n*** DEPLOYMENT SUCCESSFUL ***\n";
         std::cout << std::string(50, '=') << "\n";
@@ -411,25 +591,38 @@ void deployVolunteer(VolunteerQueue& queue) {
         std::cout << "VOLUNTEER DEPLOYED:\n";
         std::cout << "- Name: " << volunteer.name << "\n";
         std::cout << "- Contact: " << volunteer.contact << "\n";
-        std::cout << "- Skill: " << volunteer.skill << "\n\n";
+        std::cout << "- Skill: " << volunteer.skill << "\n";
+        if (queue.dispatchMode() == VolunteerQueue::PRIORITY_DISPATCH) {
+            std::cout << "- Priority Lane: " << queue.priorityOf(volunteer) << "\n";
+        }
+        std::cout << "\n";
         
         std::cout << "DEPLOYMENT LOCATION:\n";
-        std::cout << "- Site: " << sites[bestSiteIndex].name << "\n";
-        std::cout << "- Previous Capacity: " << (sites[bestSiteIndex].currentCount - 1) 
-                  << "/" << sites[bestSiteIndex].maxCapacity << "\n";
-        std::cout << "- New Capacity: " << sites[bestSiteIndex].currentCount 
-                  << "/" << sites[bestSiteIndex].maxCapacity << "\n";
+        std::cout << "- Site: " << site.name << "\n";
+        if (registry.shardCount() > 1) {
+            std::cout << "- Region: " << registry.shard(best.shard).region << "\n";
+        }
+        if (nearestChosen) {
+            std::cout << "- Distance: " << std::fixed << std::setprecision(1)
+                      << registry.distanceKm(volunteer.latitude, volunteer.longitude, best) << " km (nearest open site)\n";
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        }
+        std::cout << "- Previous Capacity: " << (site.currentCount - 1) 
+                  << "/" << site.maxCapacity << "\n";
+        std::cout << "- New Capacity: " << site.currentCount 
+                  << "/" << site.maxCapacity << "\n";
         
-        int availableAfter = sites[bestSiteIndex].maxCapacity - sites[bestSiteIndex].currentCount;
+        int availableAfter = site.maxCapacity - site.currentCount;
         std::cout << "- Remaining slots at this site: " << availableAfter << "\n\n";
         
         std::cout << "DEPLOYMENT SUMMARY:\n";
-        std::cout << "Successfully deployed " << volunteer.name << " to " << sites[bestSiteIndex].name 
-                  << " (" << sites[bestSiteIndex].currentCount << "/" 
-                  << sites[bestSiteIndex].maxCapacity << ")\n\n";
+        std::cout << "Successfully deployed " << volunteer.name << " to " << site.name 
+                  << " (" << site.currentCount << "/" 
+                  << site.maxCapacity << ")\n\n";
         
-        // Save updated site data
-        saveReliefSites(sites, "../data/relief_sites.txt");
+        // Save updated site data (only the affected region's file is rewritten)
+        registry.saveDirty();
         
         std::cout << "QUEUE STATUS:\n";
         std::cout << "- Remaining volunteers in queue: " << queue.size() << "\n";
@@ -448,6 +641,552 @@ void deployVolunteer(VolunteerQueue& queue) {
     }
 }
 
+/**
+ * Release a deployed volunteer from their site, freeing the slot and
+ * optionally returning the volunteer to the back of the deployment queue
+ */
+void releaseVolunteer(VolunteerQueue& queue) {
+    std::cout << "=== VOLUNTEER RELEASE ===\n";
+    
+    RegionRegistry& registry = siteRegistry();
+    if (registry.empty()) {
+        std::cout << "Error: Could not load relief sites data.\n";
+        return;
+    }
+    
+    std::string contact;
+    std::cout << "Enter contact information of the volunteer to release: ";
+    std::getline(std::cin, contact);
+    contact = trim(contact);
+    
+    DeploymentIndex& deployments = deploymentIndex();
+    const DeploymentNode* current = deployments.find(contact);
+    if (current == nullptr) {
+        std::cout << "\n[ERROR] RELEASE CANNOT PROCEED [ERROR]\n";
+        std::cout << "REASON: No active deployment found for contact '" << contact << "'\n";
+        std::cout << "NOTE: Deployments recorded before site tracking was added cannot be released.\n";
+        return;
+    }
+    
+    SiteLocation location = registry.find(current->site);
+    if (!location.valid()) {
+        std::cout << "\n[ERROR] RELEASE CANNOT PROCEED [ERROR]\n";
+        std::cout << "REASON: Site '" << current->site << "' is not in any region's relief sites file\n";
+        return;
+    }
+    
+    std::cout << "Volunteer: " << current->volunteer.name << " (" << current->volunteer.skill << ")\n";
+    std::cout << "Current site: " << current->site << "\n";
+    std::cout << "Return volunteer to the deployment queue? (y/n): ";
+    std::string answer;
+    std::getline(std::cin, answer);
+    bool requeue = (answer == "y" || answer == "Y" || answer == "yes" || answer == "Yes");
+    
+    DeploymentNode released(Volunteer(), "");
+    std::string error;
+    if (!commitRelease(queue, contact, requeue, released, location, error)) {
+        std::cout << "\n[ERROR] RELEASE CANNOT PROCEED [ERROR]\n";
+        std::cout << "REASON: " << error << "\n";
+        return;
+    }
+    registry.saveDirty();
+    
+    const ReliefSite& site = registry.site(location);
+    std::cout << "\n*** RELEASE SUCCESSFUL ***\n";
+    std::cout << std::string(50, '=') << "\n";
+    std::cout << "- Released " << released.volunteer.name << " from " << site.name << "\n";
+    std::cout << "- New Capacity: " << site.currentCount << "/" << site.maxCapacity << "\n";
+    if (requeue) {
+        std::cout << "- Volunteer returned to queue (position " << queue.size() << ")\n";
+    } else {
+        std::cout << "- Volunteer checked out (not returned to queue)\n";
+    }
+    std::cout << std::string(50, '=') << "\n";
+}
+
+/**
+ * Answer "where is volunteer X" (by contact) or "who is at site Y" (by site
+ * name) from the resident deployment index, without reading the logs
+ */
+void locateDeployment(const VolunteerQueue& queue) {
+    std::cout << "=== LOCATE VOLUNTEER OR SITE ===\n";
+    std::cout << "Enter a volunteer's name or contact, or a site name: ";
+    std::string query;
+    std::getline(std::cin, query);
+    query = trim(query);
+    if (query.empty()) {
+        std::cout << "Error: Nothing to look up.\n";
+        return;
+    }
+    
+    DeploymentIndex& deployments = deploymentIndex();
+    const DeploymentNode* deployment = deployments.find(query);
+    if (deployment != nullptr) {
+        std::cout << "\n" << deployment->volunteer.name << " (" << deployment->volunteer.skill << ") is deployed at "
+                  << deployment->site;
+        if (!deployment->deployedAt.empty()) {
+            std::cout << " since " << deployment->deployedAt;
+        }
+        std::cout << "\n";
+        int total = deployments.countForContact(query);
+        if (total > 1) {
+            std::cout << "Note: " << total - 1 << " earlier deployment(s) under this contact are also still active.\n";
+        }
+        return;
+    }
+    
+    if (!siteRegistry().find(query).valid() && deployments.countAtSite(query) == 0) {
+        // Anything with letters and no '@' may be (part of) a name
+        bool nameLike = query.find('@') == std::string::npos &&
+                        std::find_if(query.begin(), query.end(), [](char c) {
+                            return std::isalpha((unsigned char)c) || (unsigned char)c >= 0x80;
+                        }) != query.end();
+        if (nameLike && printNameMatches(queue, query)) {
+            return;
+        }
+        
+        // Past deployments: only archive blocks whose contact filter matches are decompressed
+        int pastCount = 0;
+        Volunteer volunteer;
+        std::string site, extra, lastName, lastSite, lastAt;
+        auto match = [&](const std::string& record) {
+            if (parseDeploymentRecord(record, volunteer, site, extra) && volunteer.contact == query) {
+                pastCount++;
+                lastName = volunteer.name;
+                lastSite = site;
+                lastAt = extra;
+            }
+        };
+        HistoryArchive archive;
+        if (archive.open(archiveFileFor("../data/deployed_volunteers.txt"))) {
+            archive.forEachLineWithContact(query, match);
+        }
+        logWriter().flush();
+        std::ifstream recent("../data/deployed_volunteers.txt");
+        std::string line;
+        while (recent.is_open() && std::getline(recent, line)) {
+            match(trim(line));
+        }
+        
+        if (pastCount == 0) {
+            std::cout << "\nNo active deployment for contact '" << query << "' and no site with that name.\n";
+        } else {
+            std::cout << "\n" << lastName << " is not deployed at the moment. Past deployments: " << pastCount
+                      << " (last at " << (lastSite.empty() ? "an unrecorded site" : lastSite);
+            if (!lastAt.empty()) {
+                std::cout << " on " << lastAt;
+            }
+            std::cout << ").\n";
+        }
+        return;
+    }
+    
+    std::cout << "\n=== VOLUNTEERS AT " << query << " (" << deployments.countAtSite(query) << ") ===\n";
+    if (deployments.countAtSite(query) == 0) {
+        std::cout << "No volunteers are currently recorded at this site.\n";
+        return;
+    }
+    std::cout << std::left << std::setw(20) << "Name"
+              << std::setw(25) << "Contact"
+              << std::setw(20) << "Skill"
+              << "Deployed At\n";
+    std::cout << std::string(85, '-') << "\n";
+    deployments.forEachAtSite(query, [](const DeploymentNode& node) {
+        std::cout << std::left << std::setw(20) << node.volunteer.name
+                  << std::setw(25) << node.volunteer.contact
+                  << std::setw(20) << node.volunteer.skill
+                  << (node.deployedAt.empty() ? "-" : node.deployedAt) << "\n";
+    });
+    std::cout << std::string(85, '-') << "\n";
+}
+
+/**
+ * Applies deployments and releases other running instances logged since
+ * this instance last looked: volunteers they deployed leave this queue, and
+ * the ones they returned to the queue join this one at the rear, as in theirs
+ * @return Number of log records applied
+ */
+int catchUpDeployments(VolunteerQueue& queue) {
+    // Without the shared table there is no lock to coordinate the logs with
+    if (!siteRegistry().isShared()) {
+        return 0;
+    }
+    CustomLinkedList<DeploymentNode> deployed, requeued, checkedOut;
+    int applied = deploymentIndex().catchUp(deployed, requeued, checkedOut);
+    if (applied == 0) {
+        return 0;
+    }
+    
+    CustomHashMap<std::string, int> leaving;
+    for (CustomLinkedList<DeploymentNode>::Iterator it = deployed.begin(); it != deployed.end(); ++it) {
+        leaving[volunteerKey((*it).volunteer)]++;
+        volunteerSearch().noteDeployed((*it).volunteer);
+    }
+    if (!leaving.empty()) {
+        queue.removeIf([&leaving](const Volunteer& volunteer) {
+            int* count = leaving.find(volunteerKey(volunteer));
+            if (count == nullptr || *count == 0) {
+                return false;
+            }
+            (*count)--;
+            return true;
+        });
+    }
+    for (CustomLinkedList<DeploymentNode>::Iterator it = requeued.begin(); it != requeued.end(); ++it) {
+        queue.enqueue((*it).volunteer);
+        volunteerSearch().noteReleased((*it).volunteer, true);
+    }
+    for (CustomLinkedList<DeploymentNode>::Iterator it = checkedOut.begin(); it != checkedOut.end(); ++it) {
+        volunteerSearch().noteReleased((*it).volunteer, false);
+    }
+    return applied;
+}
+
+/**
+ * DeploymentLogSection - keeps other instances off the deployment and
+ * release logs while this one deploys or releases
+ *
+ * On entry the shared table's lock is taken and the other instances' records
+ * are applied (catchUpDeployments), so nobody is deployed twice; on exit this
+ * instance's records are flushed and skipped by later catch-ups. Sections
+ * nest: only the outermost one locks.
+ */
+class DeploymentLogSection {
+private:
+    static int depth;
+    bool locked;
+    
+    // Disable copying
+    DeploymentLogSection(const DeploymentLogSection&);
+    DeploymentLogSection& operator=(const DeploymentLogSection&);
+    
+public:
+    explicit DeploymentLogSection(VolunteerQueue& queue) : locked(depth++ == 0 && siteRegistry().isShared()) {
+        if (locked) {
+            siteRegistry().lockShared();
+            catchUpDeployments(queue);
+        }
+    }
+    
+    ~DeploymentLogSection() {
+        depth--;
+        if (locked) {
+            logWriter().flush();
+            deploymentIndex().markCaughtUp();
+            siteRegistry().unlockShared();
+        }
+    }
+};
+
+int DeploymentLogSection::depth = 0;
+
+/**
+ * Deploy the next volunteer to a site: update the site's count and indexes
+ * and log the deployment. The caller saves the site files (saveDirty).
+ * @return false if another instance filled the site or deployed the next
+ *         volunteer first (nothing deployed; choose the site again)
+ * @throws std::runtime_error if the queue is empty
+ */
+bool commitDeployment(VolunteerQueue& queue, const SiteLocation& location, Volunteer& deployed) {
+    if (queue.isEmpty()) {
+        throw std::runtime_error("Cannot deploy from an empty queue");
+    }
+    
+    // The site was chosen for the volunteer at the front; if another instance
+    // deployed them in the meantime they are gone from the queue now
+    std::string expected = volunteerKey(queue.front());
+    DeploymentLogSection section(queue);
+    if (queue.isEmpty() || volunteerKey(queue.front()) != expected) {
+        return false;
+    }
+    
+    // Claim the place first so a lost race leaves the volunteer queued
+    RegionRegistry& registry = siteRegistry();
+    if (!registry.adjustCount(location, 1)) {
+        return false;
+    }
+    deployed = queue.dequeue();
+    registry.noteDeployedTo(location);
+    const ReliefSite& site = registry.site(location);
+    std::string deployedAt = currentTimestamp();
+    deploymentIndex().recordDeployment(deployed, site.name, deployedAt);
+    volunteerSearch().noteDeployed(deployed);
+    
+    // Save the deployed volunteer to deployed file
+    saveDeployedVolunteer(deployed, site.name, deployedAt, "../data/deployed_volunteers.txt");
+    return true;
+}
+
+/**
+ * Site a single deployment of next would use: the nearest open site within
+ * radiusKm for a located volunteer (when no region is requested), otherwise
+ * the most needed site
+ * @return Invalid location if every matching site is full
+ */
+SiteLocation chooseDeploymentSite(const Volunteer& next, const std::string& regionFilter, double radiusKm) {
+    RegionRegistry& registry = siteRegistry();
+    SiteLocation best = registry.bestSite(regionFilter);
+    if (best.valid() && regionFilter.empty() && next.hasLocation && registry.hasSpatialSites()) {
+        SiteLocation nearest = registry.nearestSite(next.latitude, next.longitude, radiusKm);
+        if (nearest.valid()) {
+            best = nearest;
+        }
+    }
+    return best;
+}
+
+/**
+ * Deploy up to count volunteers from the front of the queue. Under the
+ * default lowest-ratio site policy a BatchPlanner reserves their places in
+ * parallel; the plan is committed front to back, so the queue and the
+ * deployment log change as count single deployments would.
+ * A volunteer whose planned place is gone (taken by another instance, or the
+ * queue order changed) gets a site chosen like a single deployment.
+ * The caller saves the site files (saveDirty).
+ * @param deployed Deployments are appended here in order
+ * @return Number deployed; fewer than count once every site is full
+ */
+int commitBatchDeployment(VolunteerQueue& queue, int count, const std::string& regionFilter, double radiusKm,
+                          CustomLinkedList<DeploymentNode>& deployed) {
+    RegionRegistry& registry = siteRegistry();
+    DeploymentLogSection section(queue);
+
+    // The planner works on one flat table: every site, or the region's sites
+    CustomArray<ReliefSite> sites;
+    CustomArray<SiteLocation> locations;
+    int onlyShard = regionFilter.empty() ? -1 : registry.shardIndex(regionFilter);
+    for (int s = 0; s < registry.shardCount(); s++) {
+        if (onlyShard != -1 && s != onlyShard) continue;
+        const CustomArray<ReliefSite>& shardSites = registry.shard(s).sites.all();
+        for (int i = 0; i < shardSites.size(); i++) {
+            sites.push_back(shardSites[i]);
+            locations.push_back(SiteLocation(s, i));
+        }
+    }
+
+    CustomArray<Volunteer> batch;
+    queue.forEachInDispatchOrder([&batch, count](const Volunteer& volunteer, int) {
+        if (batch.size() < count) {
+            batch.push_back(volunteer);
+        }
+    });
+
+    // The planner ranks by fill ratio; under another site policy every
+    // volunteer's site is chosen one by one instead
+    CustomArray<int> plan;
+    int planned = batch.size();
+    if (registry.sitePolicy() == POLICY_LOWEST_RATIO) {
+        BatchPlanner planner(sites);
+        planned = planner.plan(batch, regionFilter.empty(), radiusKm, 0, plan);
+    } else {
+        plan.assign(planned, -1);
+    }
+
+    const int MAX_ATTEMPTS = 8;
+    int committedCount = 0;
+    for (int i = 0; i < planned && !queue.isEmpty(); i++) {
+        const Volunteer& next = queue.front();
+        SiteLocation target;
+        if (plan[i] != -1 && next.name == batch[i].name && next.contact == batch[i].contact) {
+            target = locations[plan[i]];
+            const ReliefSite& site = registry.site(target);
+            if (site.currentCount >= site.maxCapacity) {
+                target = SiteLocation();
+            }
+        }
+
+        Volunteer volunteer;
+        bool committed = false;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS && !committed; attempt++) {
+            if (!target.valid()) {
+                target = chooseDeploymentSite(queue.front(), regionFilter, radiusKm);
+                if (!target.valid()) break;
+            }
+            committed = commitDeployment(queue, target, volunteer);
+            if (!committed) {
+                target = SiteLocation();
+            }
+        }
+        if (!committed) break;
+
+        const DeploymentNode* node = deploymentIndex().find(volunteer.contact);
+        deployed.push_back(DeploymentNode(volunteer, registry.site(target).name, node ? node->deployedAt : ""));
+        committedCount++;
+    }
+    return committedCount;
+}
+
+/**
+ * Release the volunteer deployed under a contact: free their slot, log the
+ * release and optionally requeue them. The caller saves the site files.
+ * @return false (with the reason in error) if there is nothing to release
+ */
+bool commitRelease(VolunteerQueue& queue, const std::string& contact, bool requeue,
+                   DeploymentNode& released, SiteLocation& location, std::string& error) {
+    RegionRegistry& registry = siteRegistry();
+    DeploymentIndex& deployments = deploymentIndex();
+    DeploymentLogSection section(queue);
+    const DeploymentNode* current = deployments.find(contact);
+    if (current == nullptr) {
+        error = "No active deployment found for contact '" + contact + "'";
+        return false;
+    }
+    
+    location = registry.find(current->site);
+    if (!location.valid()) {
+        error = "Site '" + current->site + "' is not in any region's relief sites file";
+        return false;
+    }
+    
+    deployments.release(contact, released);
+    
+    // Never let a hand-edited count go negative
+    if (registry.site(location).currentCount > 0) {
+        registry.adjustCount(location, -1);
+    }
+    
+    std::string record = volunteerKey(released.volunteer) + "," + released.site + "," +
+                         (requeue ? "requeue" : "checkout");
+    liveStats().noteAppended(LiveStats::RELEASE_LOG, record);
+    logWriter().append("../data/released_volunteers.txt", record);
+    volunteerSearch().noteReleased(released.volunteer, requeue);
+    
+    if (requeue) {
+        queue.enqueue(released.volunteer);
+    }
+    return true;
+}
+
+/**
+ * Resident relief site registry shared by deployment and release
+ * Regions listed in data/regions.txt each get their own shard and file;
+ * without that manifest all sites form one region from relief_sites.txt.
+ */
+RegionRegistry& siteRegistry() {
+    static RegionRegistry registry;
+    if (registry.empty()) {
+        registry.load("../data/regions.txt", "../data", "../data/relief_sites.txt");
+        if (!registry.empty() && !registry.shareCounts("../data/relief_sites.shm")) {
+            std::cout << "Warning: Shared site table unavailable; deployments by other running instances will not be seen.\n";
+        }
+    }
+    registry.syncShared();
+    return registry;
+}
+
+/**
+ * Resident read views of the queue and site table; reports print from these
+ * so they never walk structures that deployments are changing
+ */
+SnapshotStore& snapshotStore() {
+    static SnapshotStore store;
+    return store;
+}
+
+/**
+ * Print one summary line per region (used when sites span several regions)
+ */
+void printRegionSummary(const RegionRegistry& registry) {
+    std::cout << "\n=== CURRENT REGION STATUS ===\n";
+    std::cout << std::left << std::setw(20) << "Region" 
+              << std::setw(10) << "Sites" 
+              << std::setw(15) << "Current/Max" 
+              << std::setw(15) << "Open Sites" << "\n";
+    std::cout << std::string(60, '-') << "\n";
+    
+    for (int s = 0; s < registry.shardCount(); s++) {
+        const RegionShard& shard = registry.shard(s);
+        int current = 0, max = 0, open = 0;
+        for (const ReliefSite* it = shard.sites.all().begin(); it != shard.sites.all().end(); ++it) {
+            current += it->currentCount;
+            max += it->maxCapacity;
+            if (it->currentCount < it->maxCapacity) open++;
+        }
+        
+        std::cout << std::left << std::setw(20) << shard.region
+                  << std::setw(10) << shard.sites.size()
+                  << std::setw(15) << (std::to_string(current) + "/" + std::to_string(max))
+                  << std::setw(15) << open << "\n";
+    }
+    std::cout << std::string(60, '-') << "\n";
+}
+
+/**
+ * Resident index of active deployments, rebuilt from the logs on first use
+ */
+DeploymentIndex& deploymentIndex() {
+    static DeploymentIndex index;
+    static bool built = false;
+    if (!built) {
+        logWriter().flush();
+        index.rebuildFromLogs("../data/deployed_volunteers.txt", "../data/released_volunteers.txt");
+        built = true;
+    }
+    return index;
+}
+
+/**
+ * Name search index; volunteerSearch() is the one the registration,
+ * deployment and release hooks update (they do nothing until it is built)
+ */
+VolunteerSearchIndex& volunteerSearch() {
+    static VolunteerSearchIndex index;
+    return index;
+}
+
+/**
+ * Name search index, built from the registration history on first use
+ */
+VolunteerSearchIndex& builtVolunteerSearch(const VolunteerQueue& queue) {
+    VolunteerSearchIndex& index = volunteerSearch();
+    if (!index.isBuilt()) {
+        logWriter().flush();
+        index.build("../data/volunteers.txt", "../data/deployed_volunteers.txt",
+                    "../data/released_volunteers.txt", queue);
+    }
+    return index;
+}
+
+/**
+ * Prints the volunteers whose name best matches a query (prefixes and
+ * misspellings included)
+ * @return false if nobody matched
+ */
+bool printNameMatches(const VolunteerQueue& queue, const std::string& query) {
+    const int shown = 10;
+    CustomArray<VolunteerSearchIndex::Match> matches;
+    bool truncated = false;
+    builtVolunteerSearch(queue).search(query, shown, matches, truncated);
+    if (matches.empty()) {
+        return false;
+    }
+    
+    std::cout << "\n=== VOLUNTEERS MATCHING '" << query << "' ===\n";
+    std::cout << std::left << std::setw(20) << "Name"
+              << std::setw(25) << "Contact"
+              << std::setw(20) << "Skill"
+              << "Status\n";
+    std::cout << std::string(85, '-') << "\n";
+    for (int i = 0; i < matches.size(); i++) {
+        const Volunteer& volunteer = matches[i].volunteer;
+        std::string status = VolunteerSearchIndex::statusName(matches[i].status);
+        const DeploymentNode* deployment = deploymentIndex().find(volunteer.contact);
+        if (matches[i].status == VolunteerSearchIndex::DEPLOYED && deployment != nullptr) {
+            status += " at " + deployment->site;
+        }
+        std::cout << std::left << std::setw(20) << volunteer.name
+                  << std::setw(25) << volunteer.contact
+                  << std::setw(20) << volunteer.skill
+                  << status << "\n";
+    }
+    std::cout << std::string(85, '-') << "\n";
+    if (truncated) {
+        std::cout << "Note: Best matches among the " << VolunteerSearchIndex::SCAN_LIMIT
+                  << " most recent candidates; type more of the name to narrow the search.\n";
+    }
+    return true;
+}
+
 /**
  * Load relief sites from file using custom linked list
  */
@@ -468,12 +1207,18 @@ CustomLinkedList<ReliefSite> loadReliefSites(const std::string& filename) {
         std::stringstream ss(line);
         std::string name, currentStr, maxStr;
         
-        // Parse: sitename currentcount maxcapacity (space-separated)
+        // Parse: sitename currentcount maxcapacity [latitude longitude] (space-separated)
         if (ss >> name >> currentStr >> maxStr) {
             try {
                 int current = std::stoi(currentStr);
                 int max = std::stoi(maxStr);
-                sites.push_back(ReliefSite(name, current, max));
+                ReliefSite site(name, current, max);
+                
+                std::string latStr, lonStr;
+                if (ss >> latStr >> lonStr) {
+                    site.setLocation(std::stod(latStr), std::stod(lonStr));
+                }
+                sites.push_back(site);
             } catch (const std::exception&) {
                 std::cout << "Warning: Invalid line in relief sites file: " << line << "\n";
             }
@@ -485,10 +1230,12 @@ CustomLinkedList<ReliefSite> loadReliefSites(const std::string& filename) {
 }
 
 /**
- * Save relief sites to file using custom linked list
+ * Save relief sites to file from the resident site table
  */
-void saveReliefSites(const CustomLinkedList<ReliefSite>& sites, const std::string& filename) {
-    std::ofstream file(filename);
+void saveReliefSites(const CustomArray<ReliefSite>& sites, const std::string& filename) {
+    // Write a temporary file and rename it, so a concurrent reader never sees half a file
+    std::string tempFile = filename + ".tmp";
+    std::ofstream file(tempFile);
     
     if (!file.is_open()) {
         std::cout << "Warning: Could not save relief sites to '" << filename << "'\n";
@@ -496,17 +1243,28 @@ void saveReliefSites(const CustomLinkedList<ReliefSite>& sites, const std::strin
     }
     
     for (auto it = sites.begin(); it != sites.end(); ++it) {
-        file << it->name << " " << it->currentCount << " " << it->maxCapacity << "\n";
+        file << it->name << " " << it->currentCount << " " << it->maxCapacity;
+        if (it->hasLocation) {
+            file << " " << std::setprecision(10) << it->latitude << " " << it->longitude;
+        }
+        file << "\n";
     }
     
     file.close();
+    if (file.fail() || std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+        std::cout << "Warning: Could not save relief sites to '" << filename << "'\n";
+    }
 }
 
 /**
  * View all registered volunteers
  */
 void viewRegisteredVolunteers(const VolunteerQueue& queue) {
-    if (queue.isEmpty()) {
+    // Print from a point-in-time view rather than the live queue
+    snapshotStore().publishQueue(queue);
+    std::shared_ptr<const QueueView> view = snapshotStore().queueView();
+    
+    if (view->volunteers.empty()) {
         std::cout << "No volunteers currently available for deployment.\n";
         std::cout << "All volunteers from file have been deployed or no volunteers registered.\n\n";
         
@@ -514,8 +1272,11 @@ void viewRegisteredVolunteers(const VolunteerQueue& queue) {
         std::cout << "- Use Menu Option 1 to register new volunteers\n";
         std::cout << "- Registered volunteers will be automatically available for deployment\n";
     } else {
-        queue.displayAll();
+        view->display();
     }
+    
+    std::cout << "\n";
+    displayLiveStatistics(queue);
 }
 
 /**
@@ -523,44 +1284,24 @@ void viewRegisteredVolunteers(const VolunteerQueue& queue) {
  */
 void displayVolunteersFromFile(const std::string& filename) {
     std::cout << "=== ALL REGISTERED VOLUNTEERS (From File) ===\n";
-    
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "No registered volunteers file found or unable to open '" << filename << "'\n";
-        std::cout << "This could mean no volunteers have been registered yet.\n";
-        return;
-    }
+    logWriter().flush();
     
     CustomLinkedList<Volunteer> volunteers;
-    std::string line;
-    int lineNumber = 0;
     int validCount = 0;
     
-    // Read all volunteers from file into custom linked list
-    while (std::getline(file, line)) {
-        lineNumber++;
-        line = trim(line);
-        
-        if (line.empty()) continue;
-        
-        std::stringstream ss(line);
-        std::string name, contact, skill;
-        
-        if (std::getline(ss, name, ',') && 
-            std::getline(ss, contact, ',') && 
-            std::getline(ss, skill)) {
-            
-            name = trim(name);
-            contact = trim(contact);
-            skill = trim(skill);
-            
-            if (!name.empty() && !contact.empty() && !skill.empty()) {
-                volunteers.push_back(Volunteer(name, contact, skill));
-                validCount++;
-            }
+    // Read all volunteers (archived history first) into custom linked list
+    bool found = forEachHistoryLine(filename, [&](const std::string& line) {
+        Volunteer volunteer;
+        if (parseVolunteerRecord(line, volunteer)) {
+            volunteers.push_back(volunteer);
+            validCount++;
         }
+    });
+    if (!found) {
+        std::cout << "No registered volunteers file found or unable to open '" << filename << "'\n";
+        std::cout << "This could mean no volunteers have been registered yet.\n";
+        return;
     }
-    file.close();
     
     if (volunteers.empty()) {
         std::cout << "No valid volunteer records found in the file.\n";
@@ -587,22 +1328,14 @@ void displayVolunteersFromFile(const std::string& filename) {
     std::cout << std::string(80, '=') << "\n";
     std::cout << "Total registered volunteers: " << validCount << "\n";
     
-    // Show skill statistics using custom skill counter
+    // Skill totals are kept up to date as records are written
     std::cout << "\n=== SKILL DISTRIBUTION ===\n";
-    SkillCounter skillCounts;
-    for (auto it = volunteers.begin(); it != volunteers.end(); ++it) {
-        skillCounts.increment(it->skill);
-    }
-    
     std::cout << std::left << std::setw(25) << "Skill" << std::setw(10) << "Count" << "\n";
     std::cout << std::string(35, '-') << "\n";
-    
-    if (!skillCounts.empty()) {
-        for (auto it = skillCounts.begin(); it != skillCounts.end(); ++it) {
-            std::cout << std::left << std::setw(25) << it->skill 
-                      << std::setw(10) << it->count << "\n";
-        }
-    }
+    liveStats().reconcile();
+    liveStats().totals().registeredBySkill.forEach([](const std::string& skill, long long count) {
+        std::cout << std::left << std::setw(25) << skill << std::setw(10) << count << "\n";
+    });
     std::cout << std::string(35, '-') << "\n\n";
 }
 
@@ -612,72 +1345,55 @@ void displayVolunteersFromFile(const std::string& filename) {
 void displayCombinedVolunteerReport(const VolunteerQueue& queue) {
     std::cout << "=== COMPREHENSIVE VOLUNTEER REPORT ===\n\n";
     
+    // The whole report reads one consistent view of the queue and sites
+    SnapshotStore& store = snapshotStore();
+    store.publishQueue(queue);
+    store.publishSites(siteRegistry());
+    std::shared_ptr<const QueueView> queueView = store.queueView();
+    std::shared_ptr<const SiteView> siteView = store.siteView();
+    
     // Show current queue status
     std::cout << "1. CURRENT VOLUNTEER QUEUE (Active - Awaiting Deployment)\n";
     std::cout << std::string(60, '-') << "\n";
-    if (queue.isEmpty()) {
+    if (queueView->volunteers.empty()) {
         std::cout << "No volunteers currently in deployment queue.\n";
     } else {
-        queue.displayAll();
+        queueView->display();
     }
     
     std::cout << "\n";
     
-    // Show deployed volunteers using custom list
+    // Active deployments come from the deployment index (as WHERE and AT do),
+    // so released volunteers are not listed; sites in site-table order
     std::cout << "2. DEPLOYED VOLUNTEERS (Currently in Field)\n";
     std::cout << std::string(60, '-') << "\n";
-    
-    std::ifstream deployedFile("../data/deployed_volunteers.txt");
-    CustomLinkedList<Volunteer> deployedVolunteers;
-    int deployedCount = 0;
-    
-    if (deployedFile.is_open()) {
-        std::string line;
+    const DeploymentIndex& deployments = deploymentIndex();
+    
+    if (deployments.size() > 0) {
+        std::cout << std::left << std::setw(5) << "ID" 
+                  << std::setw(25) << "Name" 
+                  << std::setw(30) << "Contact" 
+                  << std::setw(22) << "Skill/Specialization"
+                  << "Site\n";
+        std::cout << std::string(100, '=') << "\n";
         
-        // Load deployed volunteers into custom list
-        while (std::getline(deployedFile, line)) {
-            line = trim(line);
-            if (line.empty()) continue;
-            
-            std::stringstream ss(line);
-            std::string name, contact, skill;
-            
-            if (std::getline(ss, name, ',') && 
-                std::getline(ss, contact, ',') && 
-                std::getline(ss, skill)) {
-                
-                name = trim(name);
-                contact = trim(contact);
-                skill = trim(skill);
-                
-                if (!name.empty() && !contact.empty() && !skill.empty()) {
-                    deployedVolunteers.push_back(Volunteer(name, contact, skill));
-                    deployedCount++;
-                }
-            }
+        int id = 1;
+        for (int i = 0; i < siteView->sites.size(); i++) {
+            deployments.forEachAtSite(siteView->sites[i].name, [&id](const DeploymentNode& node) {
+                std::cout << std::left << std::setw(5) << id++
+                          << std::setw(25) << node.volunteer.name.substr(0, 24)
+                          << std::setw(30) << node.volunteer.contact.substr(0, 29)
+                          << std::setw(22) << node.volunteer.skill.substr(0, 21)
+                          << node.site << "\n";
+            });
         }
-        deployedFile.close();
-        
-        if (deployedCount > 0) {
-            std::cout << std::left << std::setw(5) << "ID" 
-                      << std::setw(25) << "Name" 
-                      << std::setw(30) << "Contact" 
-                      << std::setw(20) << "Skill/Specialization" << "\n";
-            std::cout << std::string(80, '=') << "\n";
-            
-            int id = 1;
-            for (auto it = deployedVolunteers.begin(); it != deployedVolunteers.end(); ++it, ++id) {
-                std::cout << std::left << std::setw(5) << id
-                          << std::setw(25) << it->name.substr(0, 24)
-                          << std::setw(30) << it->contact.substr(0, 29)
-                          << std::setw(20) << it->skill.substr(0, 19) << "\n";
-            }
-            std::cout << std::string(80, '=') << "\n";
-        } else {
-            std::cout << "No volunteers currently deployed.\n";
+        std::cout << std::string(100, '=') << "\n";
+        if (id - 1 < deployments.size()) {
+            std::cout << "Note: " << deployments.size() - (id - 1)
+                      << " more at sites no longer in the relief site files.\n";
         }
     } else {
-        std::cout << "No deployed volunteers file found.\n";
+        std::cout << "No volunteers currently deployed.\n";
     }
     
     std::cout << "\n";
@@ -691,42 +1407,26 @@ void displayCombinedVolunteerReport(const VolunteerQueue& queue) {
     std::cout << "\n4. SYSTEM SUMMARY\n";
     std::cout << std::string(60, '-') << "\n";
     
-    // Count total from file using custom list
-    std::ifstream file("../data/volunteers.txt");
-    CustomLinkedList<Volunteer> allRegistered;
-    int totalRegistered = 0;
+    // Totals are maintained as records are written; nothing is re-read here
+    LiveStats& stats = liveStats();
+    stats.reconcile();
+    long long totalRegistered = stats.totals().registered;
     
-    if (file.is_open()) {
-        std::string line;
-        while (std::getline(file, line)) {
-            line = trim(line);
-            if (!line.empty()) {
-                std::stringstream ss(line);
-                std::string name, contact, skill;
-                if (std::getline(ss, name, ',') && 
-                    std::getline(ss, contact, ',') && 
-                    std::getline(ss, skill)) {
-                    name = trim(name);
-                    contact = trim(contact);
-                    skill = trim(skill);
-                    if (!name.empty() && !contact.empty() && !skill.empty()) {
-                        allRegistered.push_back(Volunteer(name, contact, skill));
-                        totalRegistered++;
-                    }
-                }
-            }
-        }
-        file.close();
+    int currentInQueue = queueView->volunteers.size();
+    int siteCurrent = 0, siteMax = 0;
+    for (int i = 0; i < siteView->sites.size(); i++) {
+        siteCurrent += siteView->sites[i].currentCount;
+        siteMax += siteView->sites[i].maxCapacity;
     }
     
-    int currentInQueue = queue.size();
-    
     std::cout << "Total Volunteers Registered: " << totalRegistered << "\n";
     std::cout << "Currently in Queue: " << currentInQueue << "\n";
-    std::cout << "Successfully Deployed: " << deployedCount << "\n";
+    std::cout << "Successfully Deployed: " << stats.totals().deployed << "\n";
+    std::cout << "Site Occupancy: " << siteCurrent << "/" << siteMax
+              << " across " << siteView->sites.size() << " sites\n";
     
     if (totalRegistered > 0) {
-        double deploymentRate = (double)deployedCount / totalRegistered * 100;
+        double deploymentRate = (double)stats.totals().deployed / totalRegistered * 100;
         std::cout << "Deployment Rate: " << std::fixed << std::setprecision(1) 
                   << deploymentRate << "%\n";
     }
@@ -734,56 +1434,90 @@ void displayCombinedVolunteerReport(const VolunteerQueue& queue) {
     std::cout << std::string(60, '-') << "\n\n";
 }
 
+/**
+ * Dashboard of the running totals; costs the same however long the history is
+ */
+void displayLiveStatistics(const VolunteerQueue& queue) {
+    logWriter().flush();
+    LiveStats& stats = liveStats();
+    stats.reconcile();
+    const LiveStats::Totals& totals = stats.totals();
+    
+    std::cout << "=== LIVE STATISTICS ===\n";
+    std::cout << "Total Volunteers Registered: " << totals.registered << "\n";
+    std::cout << "Currently in Queue: " << queue.size() << "\n";
+    std::cout << "Deployments: " << totals.deployed << " (active: " << deploymentIndex().size() << ")\n";
+    std::cout << "Releases: " << totals.released << " (requeued: " << totals.requeued << ")\n";
+    if (totals.registered > 0) {
+        std::cout << "Deployment Rate: " << std::fixed << std::setprecision(1)
+                  << (double)totals.deployed / totals.registered * 100 << "%\n";
+    }
+    
+    std::cout << "\n" << std::left << std::setw(25) << "Skill" << std::setw(12) << "Registered"
+              << std::setw(12) << "Deployed" << std::setw(10) << "Queued" << "\n";
+    std::cout << std::string(59, '-') << "\n";
+    totals.registeredBySkill.forEach([&](const std::string& skill, long long registered) {
+        const long long* deployed = totals.deployedBySkill.find(skill);
+        std::cout << std::left << std::setw(25) << skill.substr(0, 24) << std::setw(12) << registered
+                  << std::setw(12) << (deployed != nullptr ? *deployed : 0)
+                  << std::setw(10) << queue.countWithSkill(skill) << "\n";
+    });
+    
+    if (!totals.deployedBySite.empty()) {
+        std::cout << "\n" << std::left << std::setw(25) << "Site" << std::setw(12) << "Deployments"
+                  << std::setw(10) << "Releases" << "\n";
+        std::cout << std::string(47, '-') << "\n";
+        totals.deployedBySite.forEach([&](const std::string& site, long long deployed) {
+            const long long* released = totals.releasedBySite.find(site);
+            std::cout << std::left << std::setw(25) << site.substr(0, 24) << std::setw(12) << deployed
+                      << std::setw(10) << (released != nullptr ? *released : 0) << "\n";
+        });
+    }
+    std::cout << "\n";
+}
+
 /**
  * Save a single volunteer to file (append mode)
+ * The record is handed to the background log writer, which takes care of
+ * line separation and syncing it to disk.
  */
 void saveVolunteerToFile(const Volunteer& volunteer, const std::string& filename) {
-    // First, check if the file exists and doesn't end with a newline
-    std::ifstream checkFile(filename);
-    bool needsNewline = false;
+    std::string record = volunteerKey(volunteer);
     
-    if (checkFile.is_open()) {
-        checkFile.seekg(-1, std::ios::end);
-        char lastChar;
-        if (checkFile.get(lastChar) && lastChar != '\n') {
-            needsNewline = true;
-        }
-        checkFile.close();
+    // Already queued here; the follower must not queue it again when it reads it back
+    if (filename == registrationFollower().getFilename()) {
+        registrationFollower().expectOwnRecord(volunteer);
     }
     
-    // Open file for appending
-    std::ofstream file(filename, std::ios::app);
-    
-    if (!file.is_open()) {
-        std::cout << "Warning: Could not save volunteer to file '" << filename << "'\n";
-        return;
+    // Check the record itself instead of re-reading the whole file after each write
+    int commaCount = 0;
+    for (char c : record) {
+        if (c == ',') commaCount++;
     }
-    
-    // Add newline if needed to ensure we start on a new line
-    if (needsNewline) {
-        file << "\n";
+    if (commaCount != 2) {
+        std::cout << "Warning: Volunteer record has invalid format (found " << commaCount
+                  << " commas, expected 2)\n";
+        std::cout << "Expected format: Name,Contact,Skill (fields must not contain commas)\n";
     }
     
-    // Ensure proper CSV format with newline
-    file << volunteer.name << "," << volunteer.contact << "," << volunteer.skill << std::endl;
-    
-    // Verify the write operation
-    if (file.fail()) {
-        std::cout << "Warning: Failed to write volunteer data to file '" << filename << "'\n";
+    if (volunteer.hasLocation) {
+        record += "," + formatCoordinates(volunteer.latitude, volunteer.longitude);
     }
     
-    file.close();
-    
-    // Additional verification - check if file was written correctly
-    if (!file.good() && !file.eof()) {
-        std::cout << "Warning: File write operation may have failed for '" << filename << "'\n";
+    if (filename == "../data/volunteers.txt") {
+        liveStats().noteAppended(LiveStats::REGISTRATION_LOG, record);
+        volunteerSearch().noteQueued(volunteer);
     }
+    logWriter().append(filename, record);
 }
 
 /**
  * Validate volunteer file format and fix any issues
  */
 void validateVolunteerFile(const std::string& filename) {
+    // Make sure records still queued in the log writer are included
+    logWriter().flush();
+    
     std::ifstream file(filename);
     if (!file.is_open()) {
         return; // File doesn't exist yet, which is fine
@@ -800,15 +1534,15 @@ void validateVolunteerFile(const std::string& filename) {
         
         if (line.empty()) continue;
         
-        // Check if line has proper CSV format (exactly 2 commas)
+        // Check if line has proper CSV format (2 commas, or 4 with a location)
         int commaCount = 0;
         for (char c : line) {
             if (c == ',') commaCount++;
         }
         
-        if (commaCount != 2) {
+        if (commaCount != 2 && commaCount != 4) {
             std::cout << "Warning: Line " << lineNum << " in " << filename 
-                      << " has invalid format (found " << commaCount << " commas, expected 2)\n";
+                      << " has invalid format (found " << commaCount << " commas, expected 2 or 4)\n";
             std::cout << "Line content: " << line << "\n";
             hasIssues = true;
         } else {
@@ -819,173 +1553,566 @@ void validateVolunteerFile(const std::string& filename) {
     
     if (hasIssues) {
         std::cout << "File validation found issues. Please check the volunteer file format.\n";
-        std::cout << "Expected format: Name,Contact,Skill (each volunteer on separate line)\n";
+        std::cout << "Expected format: Name,Contact,Skill[,Latitude,Longitude] (each volunteer on separate line)\n";
     }
 }
 
 /**
- * Load volunteers from file into the queue using custom list for intermediate storage
+ * Read dispatch settings: "mode fifo|priority", "aging N", "memory MB",
+ * "skill LEVEL Skill Name" and "contact LEVEL contact" lines
  */
-void loadVolunteersFromFile(VolunteerQueue& queue, const std::string& filename) {
+void loadDispatchSettings(VolunteerQueue& queue, const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cout << "Note: No existing volunteer file found. Starting with empty queue.\n";
-        return;
+        return; // Plain FIFO dispatch
     }
     
-    CustomLinkedList<Volunteer> loadedVolunteers;
     std::string line;
-    int loadedCount = 0;
-    int skippedCount = 0;
-    int lineNumber = 0;
-        
+    int lineNum = 0;
+    int rules = 0;
     while (std::getline(file, line)) {
-        lineNumber++;
+        lineNum++;
         line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
         
-        // Skip empty lines
-        if (line.empty()) {
-            continue;
-        }
-        
-        // Parse the line (format: name,contact,skill)
         std::stringstream ss(line);
-        std::string name, contact, skill;
+        std::string keyword, value;
+        ss >> keyword >> value;
         
-        if (std::getline(ss, name, ',') && 
-            std::getline(ss, contact, ',') && 
-            std::getline(ss, skill)) {
-            
-            name = trim(name);
-            contact = trim(contact);
-            skill = trim(skill);
-            
-            if (!name.empty() && !contact.empty() && !skill.empty()) {
-                Volunteer volunteer(name, contact, skill);
-                
-                // Check if volunteer is already deployed
-                if (!isVolunteerDeployed(volunteer, "../data/deployed_volunteers.txt")) {
-                    queue.enqueue(volunteer);
-                    loadedCount++;
+        bool valid = !value.empty();
+        try {
+            if (keyword == "mode" && value == "fifo") {
+                queue.setDispatchMode(VolunteerQueue::FIFO_DISPATCH);
+            } else if (keyword == "mode" && value == "priority") {
+                queue.setDispatchMode(VolunteerQueue::PRIORITY_DISPATCH);
+            } else if (keyword == "aging" && valid) {
+                queue.setAgingThreshold(std::stoi(value));
+            } else if (keyword == "memory" && valid) {
+                long long megabytes = std::stoll(value);
+                valid = megabytes > 0;
+                if (valid) {
+                    queue.setMemoryBudget(megabytes * 1024 * 1024, "../data");
+                }
+            } else if (keyword == "site-policy" && valid) {
+                SitePolicyKind kind;
+                valid = parseSitePolicy(value, kind);
+                if (valid) {
+                    siteRegistry().setSitePolicy(kind);
+                    std::cout << "Site policy: " << sitePolicyName(kind) << ".\n";
+                }
+            } else if ((keyword == "skill" || keyword == "contact") && valid) {
+                std::string target;
+                std::getline(ss, target);
+                target = trim(target);
+                if (target.empty()) {
+                    valid = false;
+                } else if (keyword == "skill") {
+                    queue.setSkillPriority(target, std::stoi(value));
+                    rules++;
                 } else {
-                    skippedCount++;
-                    std::cout << "Skipping already deployed volunteer: " << name << "\n";
+                    queue.setContactPriority(target, std::stoi(value));
+                    rules++;
                 }
+            } else {
+                valid = false;
             }
+        } catch (const std::exception&) {
+            valid = false;
+        }
+        
+        if (!valid) {
+            std::cout << "Warning: Line " << lineNum << " in " << filename << " is not a valid dispatch setting\n";
+        }
+    }
+    
+    if (queue.getMemoryBudget() > 0) {
+        std::cout << "Queue memory budget: " << queue.getMemoryBudget() / (1024 * 1024)
+                  << " MB (volunteers beyond it are spilled to ../data).\n";
+    }
+    if (queue.dispatchMode() == VolunteerQueue::PRIORITY_DISPATCH) {
+        std::cout << "Priority dispatch enabled (" << rules << " lane rules";
+        if (queue.getAgingThreshold() > 0) {
+            std::cout << ", aging after " << queue.getAgingThreshold() << " bypasses";
         }
+        std::cout << ").\n";
+    }
+}
+
+/**
+ * Restore the pending queue from the saved queue state when it is still consistent
+ * with the logs, otherwise rebuild it from the full registration history
+ * @return Byte offset of the registration log the queue now reflects
+ */
+long long initializeQueue(VolunteerQueue& queue) {
+    const std::string stateFile = "../data/queue_state.dat";
+    const std::string volunteersFile = "../data/volunteers.txt";
+    const std::string deployedFile = "../data/deployed_volunteers.txt";
+    const std::string releasedFile = "../data/released_volunteers.txt";
+    AllocationScope scope(AllocationProfiler::LOAD);
+    
+    // Sites, the deployment index and the live statistics load alongside the
+    // queue instead of on first use; nothing below touches them until joined
+    logWriter().flush();
+    std::thread sitesLoader([]() {
+        AllocationScope loaderScope(AllocationProfiler::LOAD);
+        siteRegistry();
+    });
+    std::thread indexLoader([]() {
+        AllocationScope loaderScope(AllocationProfiler::LOAD);
+        deploymentIndex();
+    });
+    std::thread statsLoader([]() {
+        AllocationScope loaderScope(AllocationProfiler::LOAD);
+        liveStats();
+    });
+    
+    QueueCursor cursor;
+    long long deployedSize = logFileSize(deployedFile);
+    long long releasedSize = logFileSize(releasedFile);
+    long long registeredSize = logFileSize(volunteersFile);
+    
+    // A deployment or release recorded after the save, or a rewritten
+    // registration log, means the saved queue can no longer be trusted
+    bool stateUsable = readQueueCursor(stateFile, cursor) &&
+                       cursor.deployedOffset == (deployedSize < 0 ? 0 : deployedSize) &&
+                       cursor.releasedOffset == (releasedSize < 0 ? 0 : releasedSize) &&
+                       cursor.registrationOffset <= registeredSize;
+    
+    long long offset;
+    if (stateUsable && loadQueueState(queue, cursor, stateFile)) {
+        std::cout << "Restored " << queue.size() << " pending volunteers from saved queue state.\n";
+        offset = cursor.registrationOffset;
+        if (cursor.registrationOffset < registeredSize) {
+            // Only registrations appended since the save need to be read
+            offset = loadVolunteersFromFile(queue, volunteersFile, cursor.registrationOffset, false);
+        }
+    } else {
+        offset = loadVolunteersFromFile(queue, volunteersFile);
+    }
+    
+    sitesLoader.join();
+    indexLoader.join();
+    statsLoader.join();
+    return offset;
+}
+
+/**
+ * Running totals over the logs, loaded (or rebuilt) on first use
+ * Records the log writer still holds are flushed first, so every record is
+ * counted either by the load or by a later noteAppended, never both.
+ */
+LiveStats& liveStats() {
+    static LiveStats stats("../data/volunteers.txt", "../data/deployed_volunteers.txt",
+                           "../data/released_volunteers.txt");
+    if (!stats.isLoaded()) {
+        logWriter().flush();
+        stats.load("../data/live_stats.dat");
+    }
+    return stats;
+}
+
+/**
+ * Resident follower of the registration log (idle unless follow mode is on)
+ */
+RegistrationFollower& registrationFollower() {
+    static RegistrationFollower follower;
+    return follower;
+}
+
+/**
+ * Track volunteers.txt from the byte offset the queue reflects, so records
+ * appended by others can be ingested before the queue state is saved
+ */
+void trackRegistrations(long long offset) {
+    registrationFollower().track("../data/volunteers.txt", offset,
+                                 "../data/deployed_volunteers.txt", "../data/released_volunteers.txt");
+}
+
+/**
+ * Start ingesting registrations appended to volunteers.txt from a byte offset
+ */
+bool startFollowing(long long offset) {
+    if (!registrationFollower().start("../data/volunteers.txt", offset,
+                                      "../data/deployed_volunteers.txt", "../data/released_volunteers.txt")) {
+        std::cout << "Warning: Could not watch ../data/volunteers.txt; follow mode is off.\n";
+        return false;
     }
+    std::cout << "Following ../data/volunteers.txt for new registrations.\n";
+    return true;
+}
+
+/**
+ * Load volunteers from file into the queue through the startup pipeline
+ * (see StartupLoader.hpp); the queue receives them in file order
+ * @param startOffset Byte offset to start reading from (0 reads the whole file)
+ * @param includeArchive Also queue the registrations moved to the history archive (read first)
+ * @return Byte offset just past the last line read
+ */
+long long loadVolunteersFromFile(VolunteerQueue& queue, const std::string& filename, long long startOffset,
+                                 bool includeArchive) {
+    HistoryArchive archive;
+    bool archived = includeArchive && archive.open(archiveFileFor(filename));
     
+    std::ifstream file(filename);
+    if (!file.is_open() && !archived) {
+        std::cout << "Note: No existing volunteer file found. Starting with empty queue.\n";
+        return 0;
+    }
     file.close();
     
-    if (loadedCount > 0) {
-        std::cout << "Successfully loaded " << loadedCount << " volunteers from file.\n";
+    // The deployed filter reads the logs, so records still queued in the log writer go first
+    logWriter().flush();
+    
+    // Loaded volunteers are staged and handed to the queue in one splice
+    VolunteerQueue loadedVolunteers;
+    loadedVolunteers.copyLaneRulesFrom(queue);
+    RegistrationLoadResult result = loadRegistrationsPipelined(loadedVolunteers, archived ? &archive : nullptr,
+                                                               filename, startOffset,
+                                                               "../data/deployed_volunteers.txt",
+                                                               "../data/released_volunteers.txt");
+    if (result.archiveCorrupt) {
+        std::cout << "Warning: " << archiveFileFor(filename) << " has a corrupt block; "
+                  << "later archived registrations were skipped.\n";
+    }
+    queue.enqueueBulk(loadedVolunteers);
+    
+    if (result.loaded > 0) {
+        std::cout << "Successfully loaded " << result.loaded << " volunteers from file.\n";
     }
-    if (skippedCount > 0) {
-        std::cout << "Skipped " << skippedCount << " already deployed volunteers.\n";
+    if (result.skipped > 0) {
+        std::cout << "Skipped " << result.skipped << " already deployed volunteers.\n";
     }
-    if (loadedCount == 0 && skippedCount == 0) {
+    if (result.loaded == 0 && result.skipped == 0) {
         std::cout << "No valid volunteers found in file.\n";
     }
+    
+    return result.offset;
 }
 
 /**
- * Save all volunteers in queue to file (overwrite mode)
- * Note: This is challenging with queue structure, so we maintain append approach
+ * Save all volunteers in queue to the queue state file (overwrite mode)
+ * The cursor records the registration offset the queue reflects and the
+ * current size of the other logs, so the next startup can load this state
+ * directly and read only registrations the queue has not seen.
  */
 void saveAllVolunteersToFile(const VolunteerQueue& queue, const std::string& filename) {
-    std::ofstream file(filename);
+    AllocationScope scope(AllocationProfiler::SAVE);
     
-    if (!file.is_open()) {
+    // The cursor must cover every record the log writer still holds
+    if (!logWriter().flush()) {
+        std::cout << "Warning: Some log records could not be written to disk.\n";
+    }
+    
+    // Not the log's size: records others appended since the last ingestion are not queued
+    long long registeredSize = registrationFollower().isTracking() ? registrationFollower().getOffset()
+                                                                   : logFileSize("../data/volunteers.txt");
+    long long deployedSize = logFileSize("../data/deployed_volunteers.txt");
+    long long releasedSize = logFileSize("../data/released_volunteers.txt");
+    QueueCursor cursor(registeredSize < 0 ? 0 : registeredSize, deployedSize < 0 ? 0 : deployedSize,
+                       releasedSize < 0 ? 0 : releasedSize);
+    
+    if (!saveQueueState(queue, cursor, filename)) {
         std::cout << "Warning: Could not save volunteers to file '" << filename << "'\n";
         return;
     }
     
-    // Note: This requires iterating through the queue without dequeuing
-    // Since we can't modify the queue, we'll need to use a different approach
-    // For now, we'll append new volunteers to maintain the existing file
-    std::cout << "Note: Queue-to-file save completed.\n";
-    file.close();
+    std::cout << "Note: Queue-to-file save completed (" << queue.size() << " pending volunteers).\n";
+    
+    if (!liveStats().save("../data/live_stats.dat")) {
+        std::cout << "Warning: Could not save live statistics to '../data/live_stats.dat'\n";
+    }
 }
 
 /**
  * Save a deployed volunteer to the deployed volunteers file
  */
-void saveDeployedVolunteer(const Volunteer& volunteer, const std::string& filename) {
-    // First, check if the file exists and doesn't end with a newline
-    std::ifstream checkFile(filename);
-    bool needsNewline = false;
-    
-    if (checkFile.is_open()) {
-        checkFile.seekg(-1, std::ios::end);
-        char lastChar;
-        if (checkFile.get(lastChar) && lastChar != '\n') {
-            needsNewline = true;
-        }
-        checkFile.close();
+void saveDeployedVolunteer(const Volunteer& volunteer, const std::string& site, const std::string& deployedAt,
+                           const std::string& filename) {
+    // Volunteer fields as in the volunteers file, then the site and time (written by the background log writer)
+    std::string record = volunteerKey(volunteer) + "," + site + "," + deployedAt;
+    if (filename == "../data/deployed_volunteers.txt") {
+        liveStats().noteAppended(LiveStats::DEPLOYMENT_LOG, record);
     }
+    logWriter().append(filename, record);
+}
+
+/**
+ * Current local time as "YYYY-MM-DD HH:MM:SS"
+ */
+std::string currentTimestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char buffer[20];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    return buffer;
+}
+
+/**
+ * Check if a volunteer is already deployed (and not since returned to the queue)
+ */
+bool isVolunteerDeployed(const Volunteer& volunteer, const std::string& filename) {
+    logWriter().flush();
     
-    // Open file for appending
-    std::ofstream file(filename, std::ios::app);
+    CustomHashMap<std::string, int> activeCounts;
+    loadActiveDeploymentCounts(activeCounts, filename, "../data/released_volunteers.txt");
     
-    if (!file.is_open()) {
-        std::cout << "Warning: Could not save deployed volunteer to file '" << filename << "'\n";
+    const int* count = activeCounts.find(volunteerKey(volunteer));
+    return count != nullptr && *count > 0;
+}
+
+/**
+ * Prompt for optional weekly availability during registration
+ */
+void readOptionalAvailability(const Volunteer& volunteer) {
+    std::cout << "Enter weekly availability, e.g. Mon 08:00-16:00, Sat 09:00-13:00 (optional, press Enter to skip): ";
+    std::string input;
+    std::getline(std::cin, input);
+    input = trim(input);
+    
+    if (input.empty()) return;
+    
+    CustomArray<TimeWindow> windows;
+    if (!parseTimeWindowList(input, windows) || windows.empty()) {
+        std::cout << "Warning: Could not read availability '" << input << "'; registering without it.\n";
         return;
     }
     
-    // Add newline if needed to ensure we start on a new line
-    if (needsNewline) {
-        file << "\n";
+    std::string record = volunteer.contact;
+    for (int i = 0; i < windows.size(); i++) {
+        record += "," + formatTimeWindow(windows[i]);
     }
-    
-    // Save in same format as regular volunteers file
-    file << volunteer.name << "," << volunteer.contact << "," << volunteer.skill << std::endl;
-    file.close();
+    logWriter().append("../data/availability.txt", record);
 }
 
 /**
- * Check if a volunteer is already deployed using custom list for searching
+ * Weekly shift planning: batch roster and availability lookups
  */
-bool isVolunteerDeployed(const Volunteer& volunteer, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        return false; // File doesn't exist, so volunteer is not deployed
+void planShiftRoster(const VolunteerQueue& queue) {
+    std::cout << "=== WEEKLY SHIFT PLANNING ===\n";
+    
+    // Availability may still be queued in the log writer
+    logWriter().flush();
+    
+    CustomHashMap<std::string, CustomArray<TimeWindow> > availability;
+    loadAvailability(availability, "../data/availability.txt");
+    
+    CustomArray<ShiftSlot> shifts;
+    loadShifts(shifts, "../data/shifts.txt");
+    if (shifts.empty()) {
+        std::cout << "No shifts defined. Add lines like 'RiversideCamp Mon 08:00-16:00 3' to data/shifts.txt.\n";
+        return;
     }
     
-    CustomLinkedList<Volunteer> deployedList;
-    std::string line;
+    // Only volunteers waiting in the queue are rostered
+    ShiftScheduler scheduler;
+    int withoutAvailability = 0;
+    queue.forEach([&](const Volunteer& v) {
+        const CustomArray<TimeWindow>* windows = availability.find(v.contact);
+        if (windows != nullptr) {
+            scheduler.addVolunteer(v, *windows);
+        } else {
+            withoutAvailability++;
+        }
+    });
+    for (int s = 0; s < shifts.size(); s++) {
+        scheduler.addShift(shifts[s]);
+    }
+    scheduler.build();
     
-    // Load all deployed volunteers into custom list
-    while (std::getline(file, line)) {
-        line = trim(line);
-        if (line.empty()) continue;
+    std::cout << scheduler.shiftCount() << " shifts (" << scheduler.totalSlots() << " slots), "
+              << scheduler.volunteerCount() << " queued volunteers with availability";
+    if (withoutAvailability > 0) {
+        std::cout << ", " << withoutAvailability << " without";
+    }
+    std::cout << "\n\n";
+    
+    std::cout << "1. Build Weekly Roster\n";
+    std::cout << "2. Who Is Available for a Time Window\n";
+    std::cout << "3. Which Shifts Can a Volunteer Fill\n";
+    std::cout << "Enter your choice (1-3): ";
+    
+    int choice;
+    std::cin >> choice;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::cout << "\n";
+    
+    if (choice == 1) {
+        std::cout << "Maximum hours per volunteer this week (press Enter for " << DEFAULT_MAX_WEEKLY_HOURS << "): ";
+        std::string hoursInput;
+        std::getline(std::cin, hoursInput);
+        hoursInput = trim(hoursInput);
+        int maxHours = DEFAULT_MAX_WEEKLY_HOURS;
+        if (!hoursInput.empty()) {
+            try {
+                maxHours = std::stoi(hoursInput);
+            } catch (const std::exception&) {
+                maxHours = 0;
+            }
+            if (maxHours <= 0) {
+                std::cout << "Invalid hours; using " << DEFAULT_MAX_WEEKLY_HOURS << ".\n";
+                maxHours = DEFAULT_MAX_WEEKLY_HOURS;
+            }
+        }
         
-        // Parse the line (format: name,contact,skill)
-        std::stringstream ss(line);
-        std::string name, contact, skill;
+        CustomArray<RosterAssignment> roster;
+        int filled = scheduler.buildRoster(roster, maxHours * 60);
         
-        if (std::getline(ss, name, ',') && 
-            std::getline(ss, contact, ',') && 
-            std::getline(ss, skill)) {
-            
-            name = trim(name);
-            contact = trim(contact);
-            skill = trim(skill);
-            
-            deployedList.push_back(Volunteer(name, contact, skill));
+        std::ofstream out("../data/roster.txt", std::ios::trunc);
+        if (!out.is_open()) {
+            std::cout << "Error: Could not write roster file ../data/roster.txt\n";
+            return;
+        }
+        CustomArray<int> filledPerShift;
+        for (int s = 0; s < scheduler.shiftCount(); s++) {
+            filledPerShift.push_back(0);
+        }
+        for (int i = 0; i < roster.size(); i++) {
+            const ShiftSlot& shift = scheduler.shift(roster[i].shift);
+            const Volunteer& v = scheduler.volunteer(roster[i].volunteer);
+            out << formatTimeWindow(shift.window) << "," << shift.site << "," << v.name << "," << v.contact << "\n";
+            filledPerShift[roster[i].shift]++;
+        }
+        out.close();
+        
+        std::cout << "Filled " << filled << " of " << scheduler.totalSlots() << " slots; roster written to data/roster.txt\n";
+        
+        int shortShifts = 0;
+        for (int s = 0; s < scheduler.shiftCount(); s++) {
+            const ShiftSlot& shift = scheduler.shift(s);
+            if (filledPerShift[s] < shift.slots) {
+                if (shortShifts == 0) {
+                    std::cout << "\nUnderstaffed shifts:\n";
+                }
+                shortShifts++;
+                std::cout << "- " << std::left << std::setw(20) << shift.site << formatTimeWindow(shift.window)
+                          << "  " << filledPerShift[s] << "/" << shift.slots << "\n";
+            }
         }
+        if (shortShifts == 0) {
+            std::cout << "Every shift is fully staffed.\n";
+        }
+    } else if (choice == 2) {
+        std::cout << "Enter time window (e.g. Mon 08:00-16:00): ";
+        std::string input;
+        std::getline(std::cin, input);
+        
+        TimeWindow window;
+        if (!parseTimeWindow(input, window)) {
+            std::cout << "Error: Could not read time window '" << trim(input) << "'.\n";
+            return;
+        }
+        
+        CustomArray<int> available;
+        scheduler.availableFor(window, available);
+        std::cout << "\n" << available.size() << " volunteer(s) available for " << formatTimeWindow(window) << ":\n";
+        for (int i = 0; i < available.size(); i++) {
+            const Volunteer& v = scheduler.volunteer(available[i]);
+            std::cout << "- " << std::left << std::setw(20) << v.name << std::setw(25) << v.contact << v.skill << "\n";
+        }
+    } else if (choice == 3) {
+        std::cout << "Enter volunteer contact: ";
+        std::string contact;
+        std::getline(std::cin, contact);
+        contact = trim(contact);
+        
+        int index = scheduler.indexOf(contact);
+        if (index == -1) {
+            std::cout << "Error: No queued volunteer with contact '" << contact << "' has availability on file.\n";
+            return;
+        }
+        
+        CustomArray<int> fitting;
+        scheduler.shiftsFor(index, fitting);
+        std::cout << "\n" << scheduler.volunteer(index).name << " can fill " << fitting.size() << " shift(s):\n";
+        for (int i = 0; i < fitting.size(); i++) {
+            const ShiftSlot& shift = scheduler.shift(fitting[i]);
+            std::cout << "- " << std::left << std::setw(20) << shift.site << formatTimeWindow(shift.window)
+                      << "  (" << shift.slots << " slots)\n";
+        }
+    } else {
+        std::cout << "Invalid choice. Returning to main menu.\n";
     }
-    file.close();
-    
-    // Search through deployed list using iterator
-    for (auto it = deployedList.begin(); it != deployedList.end(); ++it) {
-        if (it->name == volunteer.name && 
-            it->contact == volunteer.contact && 
-            it->skill == volunteer.skill) {
-            return true; // Volunteer is already deployed
+}
+
+/**
+ * Parse a volunteers file line: name,contact,skill[,latitude,longitude]
+ * Lines without a valid trailing coordinate pair keep everything after the
+ * second comma as the skill, as before.
+ */
+bool parseVolunteerRecord(const std::string& line, Volunteer& volunteer) {
+    size_t first = line.find(',');
+    if (first == std::string::npos) return false;
+    size_t second = line.find(',', first + 1);
+    if (second == std::string::npos) return false;
+    
+    volunteer = Volunteer(trim(line.substr(0, first)),
+                          trim(line.substr(first + 1, second - first - 1)),
+                          trim(line.substr(second + 1)));
+    
+    // Optional location as the last two fields
+    size_t third = line.find(',', second + 1);
+    if (third != std::string::npos) {
+        double latitude, longitude;
+        if (parseCoordinates(line.substr(third + 1), latitude, longitude)) {
+            volunteer.skill = trim(line.substr(second + 1, third - second - 1));
+            volunteer.setLocation(latitude, longitude);
         }
     }
     
-    return false; // Volunteer not found in deployed list
+    return !volunteer.name.empty() && !volunteer.contact.empty() && !volunteer.skill.empty();
+}
+
+/**
+ * Parse "latitude,longitude" in decimal degrees
+ */
+bool parseCoordinates(const std::string& text, double& latitude, double& longitude) {
+    size_t comma = text.find(',');
+    if (comma == std::string::npos) return false;
+    
+    std::string latText = trim(text.substr(0, comma));
+    std::string lonText = trim(text.substr(comma + 1));
+    if (latText.empty() || lonText.empty()) return false;
+    
+    char* latEnd = nullptr;
+    char* lonEnd = nullptr;
+    latitude = std::strtod(latText.c_str(), &latEnd);
+    longitude = std::strtod(lonText.c_str(), &lonEnd);
+    
+    return *latEnd == '\0' && *lonEnd == '\0' &&
+           latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180;
+}
+
+/**
+ * Format coordinates as "latitude,longitude"
+ */
+std::string formatCoordinates(double latitude, double longitude) {
+    std::ostringstream out;
+    out << std::setprecision(10) << latitude << "," << longitude;
+    return out.str();
+}
+
+/**
+ * Prompt for an optional volunteer location during registration
+ */
+void readOptionalLocation(Volunteer& volunteer) {
+    std::cout << "Enter location as latitude,longitude (optional, press Enter to skip): ";
+    std::string location;
+    std::getline(std::cin, location);
+    location = trim(location);
+    
+    if (location.empty()) return;
+    
+    double latitude, longitude;
+    if (parseCoordinates(location, latitude, longitude)) {
+        volunteer.setLocation(latitude, longitude);
+    } else {
+        std::cout << "Warning: Could not read location '" << location << "'; registering without one.\n";
+    }
 }
 
 /**